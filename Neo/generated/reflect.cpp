@@ -1,736 +1,753 @@
 #include "Neo.h"
+#include "Serializer.h"
 #include "reflect.h"
 
-#include "FileExcludes.h"
-ReflectEnumInfo enumReflect_FSExcludeType;
-bool FSExcludeType_StringToEnum(string name, FSExcludeType &value)
-{
-  auto it = enumReflect_FSExcludeType.map_stringToInt.find(name);
-  if (it != enumReflect_FSExcludeType.map_stringToInt.end())
-  {
-    value = (FSExcludeType)it->second;    return true;
-  }
-  return false;
-}
-string FSExcludeType_EnumToString(FSExcludeType value)
-{
-  auto it = enumReflect_FSExcludeType.map_intToString.find((int)value);
-  if (it != enumReflect_FSExcludeType.map_intToString.end())
-    return it->second;
-  return "";
+#include "Texture.h"
+static constexpr array<ReflectEnumValue, 6> reflectEnumByName_TextureLayout =
+{{
+  { "ColorAttachment", (int)TextureLayout_ColorAttachment },
+  { "DepthAttachment", (int)TextureLayout_DepthAttachment },
+  { "Present", (int)TextureLayout_Present },
+  { "ShaderRead", (int)TextureLayout_ShaderRead },
+  { "TransferDest", (int)TextureLayout_TransferDest },
+  { "Undefined", (int)TextureLayout_Undefined }
+}};
+static constexpr array<ReflectEnumValue, 6> reflectEnumByValue_TextureLayout = ReflectSortByValue(reflectEnumByName_TextureLayout);
+constinit const ReflectEnumInfo reflectEnumInfo_TextureLayout = { "TextureLayout", reflectEnumByName_TextureLayout, reflectEnumByValue_TextureLayout };
+bool TextureLayout_StringToEnum(string_view name, TextureLayout &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_TextureLayout.StringToInt(name, intValue))
+    return false;
+  value = (TextureLayout)intValue;
+  return true;
+}
+string_view TextureLayout_EnumToString(TextureLayout value)
+{
+  return reflectEnumInfo_TextureLayout.IntToString((int)value);
 }
 
-#include "Memory.h"
-ReflectEnumInfo enumReflect_MemoryGroup;
-bool MemoryGroup_StringToEnum(string name, MemoryGroup &value)
-{
-  auto it = enumReflect_MemoryGroup.map_stringToInt.find(name);
-  if (it != enumReflect_MemoryGroup.map_stringToInt.end())
-  {
-    value = (MemoryGroup)it->second;    return true;
-  }
-  return false;
+static constexpr array<ReflectEnumValue, 4> reflectEnumByName_TextureType =
+{{
+  { "ColorBuffer", (int)TextureType_ColorBuffer },
+  { "DepthBuffer", (int)TextureType_DepthBuffer },
+  { "Image", (int)TextureType_Image },
+  { "None", (int)TextureType_None }
+}};
+static constexpr array<ReflectEnumValue, 4> reflectEnumByValue_TextureType = ReflectSortByValue(reflectEnumByName_TextureType);
+constinit const ReflectEnumInfo reflectEnumInfo_TextureType = { "TextureType", reflectEnumByName_TextureType, reflectEnumByValue_TextureType };
+bool TextureType_StringToEnum(string_view name, TextureType &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_TextureType.StringToInt(name, intValue))
+    return false;
+  value = (TextureType)intValue;
+  return true;
+}
+string_view TextureType_EnumToString(TextureType value)
+{
+  return reflectEnumInfo_TextureType.IntToString((int)value);
 }
-string MemoryGroup_EnumToString(MemoryGroup value)
-{
-  auto it = enumReflect_MemoryGroup.map_intToString.find((int)value);
-  if (it != enumReflect_MemoryGroup.map_intToString.end())
-    return it->second;
-  return "";
+
+static constexpr array<ReflectEnumValue, 36> reflectEnumByName_TexturePixelFormat =
+{{
+  { "B10G11R11_UFLOAT", (int)PixFmt_B10G11R11_UFLOAT },
+  { "B8G8R8A8_SINT", (int)PixFmt_B8G8R8A8_SINT },
+  { "B8G8R8A8_SNORM", (int)PixFmt_B8G8R8A8_SNORM },
+  { "B8G8R8A8_SRGB", (int)PixFmt_B8G8R8A8_SRGB },
+  { "B8G8R8A8_UINT", (int)PixFmt_B8G8R8A8_UINT },
+  { "B8G8R8A8_UNORM", (int)PixFmt_B8G8R8A8_UNORM },
+  { "BC1_RGB_SRGB", (int)PixFmt_BC1_RGB_SRGB },
+  { "BC1_RGB_UNORM", (int)PixFmt_BC1_RGB_UNORM },
+  { "BC3_RGBA_SRGB", (int)PixFmt_BC3_RGBA_SRGB },
+  { "BC3_RGBA_UNORM", (int)PixFmt_BC3_RGBA_UNORM },
+  { "D24_UNORM_S8_UINT", (int)PixFmt_D24_UNORM_S8_UINT },
+  { "D32_SFLOAT", (int)PixFmt_D32_SFLOAT },
+  { "R16_SFLOAT", (int)PixFmt_R16_SFLOAT },
+  { "R16_SINT", (int)PixFmt_R16_SINT },
+  { "R16_SNORM", (int)PixFmt_R16_SNORM },
+  { "R16_UINT", (int)PixFmt_R16_UINT },
+  { "R16_UNORM", (int)PixFmt_R16_UNORM },
+  { "R4G4B4A4_UNORM", (int)PixFmt_R4G4B4A4_UNORM },
+  { "R4G4_UNORM", (int)PixFmt_R4G4_UNORM },
+  { "R5G6B5A1_UNORM", (int)PixFmt_R5G6B5A1_UNORM },
+  { "R5G6B5_UNORM", (int)PixFmt_R5G6B5_UNORM },
+  { "R8G8B8A8_SINT", (int)PixFmt_R8G8B8A8_SINT },
+  { "R8G8B8A8_SNORM", (int)PixFmt_R8G8B8A8_SNORM },
+  { "R8G8B8A8_SRGB", (int)PixFmt_R8G8B8A8_SRGB },
+  { "R8G8B8A8_UINT", (int)PixFmt_R8G8B8A8_UINT },
+  { "R8G8B8A8_UNORM", (int)PixFmt_R8G8B8A8_UNORM },
+  { "R8G8_SINT", (int)PixFmt_R8G8_SINT },
+  { "R8G8_SNORM", (int)PixFmt_R8G8_SNORM },
+  { "R8G8_UINT", (int)PixFmt_R8G8_UINT },
+  { "R8G8_UNORM", (int)PixFmt_R8G8_UNORM },
+  { "R8_SINT", (int)PixFmt_R8_SINT },
+  { "R8_SNORM", (int)PixFmt_R8_SNORM },
+  { "R8_SRGB", (int)PixFmt_R8_SRGB },
+  { "R8_UINT", (int)PixFmt_R8_UINT },
+  { "R8_UNORM", (int)PixFmt_R8_UNORM },
+  { "Undefined", (int)PixFmt_Undefined }
+}};
+static constexpr array<ReflectEnumValue, 36> reflectEnumByValue_TexturePixelFormat = ReflectSortByValue(reflectEnumByName_TexturePixelFormat);
+constinit const ReflectEnumInfo reflectEnumInfo_TexturePixelFormat = { "TexturePixelFormat", reflectEnumByName_TexturePixelFormat, reflectEnumByValue_TexturePixelFormat };
+bool TexturePixelFormat_StringToEnum(string_view name, TexturePixelFormat &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_TexturePixelFormat.StringToInt(name, intValue))
+    return false;
+  value = (TexturePixelFormat)intValue;
+  return true;
+}
+string_view TexturePixelFormat_EnumToString(TexturePixelFormat value)
+{
+  return reflectEnumInfo_TexturePixelFormat.IntToString((int)value);
 }
 
-#include "Serializer.h"
-ReflectEnumInfo enumReflect_SerializerError;
-bool SerializerError_StringToEnum(string name, SerializerError &value)
-{
-  auto it = enumReflect_SerializerError.map_stringToInt.find(name);
-  if (it != enumReflect_SerializerError.map_stringToInt.end())
+static constexpr array<ReflectStructMemberInfo, 3> reflectStructMembers_TestStruct =
+{{
+  { "pos", VarType_vec3, sizeof(TestStruct::pos), offsetof(TestStruct, pos) },
+  { "time", VarType_f32, sizeof(TestStruct::time), offsetof(TestStruct, time) },
+  { "OnButtonPress", VarType_func, 0, 0, [](void* obj) { ((TestStruct*)obj)->OnButtonPress(); } }
+}};
+constinit const ReflectStructInfo reflectStructInfo_TestStruct = { "TestStruct", sizeof(TestStruct), reflectStructMembers_TestStruct };
+template <SerializerEndian Endian> void TestStruct_Write(BinaryWriter<Endian>& stream, const TestStruct& value)
+{
+  static_assert(BinaryWriter<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  stream.WriteU64(TestStruct_SchemaHash);
+  if constexpr (offsetof(TestStruct, time) == offsetof(TestStruct, pos) + sizeof(TestStruct::pos))
+    stream.WriteMemory(&value.pos, offsetof(TestStruct, time) + sizeof(TestStruct::time) - offsetof(TestStruct, pos));
+  else
   {
-    value = (SerializerError)it->second;    return true;
+    stream.WriteMemory(&value.pos, sizeof(TestStruct::pos));
+    stream.WriteMemory(&value.time, sizeof(TestStruct::time));
   }
-  return false;
 }
-string SerializerError_EnumToString(SerializerError value)
+template <SerializerEndian Endian> bool TestStruct_Read(BinaryReader<Endian>& stream, TestStruct& value)
 {
-  auto it = enumReflect_SerializerError.map_intToString.find((int)value);
-  if (it != enumReflect_SerializerError.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-#include "Module.h"
-ReflectEnumInfo enumReflect_NeoModuleInitPri;
-bool NeoModuleInitPri_StringToEnum(string name, NeoModuleInitPri &value)
-{
-  auto it = enumReflect_NeoModuleInitPri.map_stringToInt.find(name);
-  if (it != enumReflect_NeoModuleInitPri.map_stringToInt.end())
+  static_assert(BinaryReader<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  if (stream.ReadU64() != TestStruct_SchemaHash)
+    return false;
+  if constexpr (offsetof(TestStruct, time) == offsetof(TestStruct, pos) + sizeof(TestStruct::pos))
+    stream.ReadMemory(&value.pos, offsetof(TestStruct, time) + sizeof(TestStruct::time) - offsetof(TestStruct, pos));
+  else
   {
-    value = (NeoModuleInitPri)it->second;    return true;
+    stream.ReadMemory(&value.pos, sizeof(TestStruct::pos));
+    stream.ReadMemory(&value.time, sizeof(TestStruct::time));
   }
-  return false;
+  return stream.IsGood();
 }
-string NeoModuleInitPri_EnumToString(NeoModuleInitPri value)
-{
-  auto it = enumReflect_NeoModuleInitPri.map_intToString.find((int)value);
-  if (it != enumReflect_NeoModuleInitPri.map_intToString.end())
-    return it->second;
-  return "";
+template void TestStruct_Write(BinaryWriter<SerializerEndian::Little>& stream, const TestStruct& value);
+template bool TestStruct_Read(BinaryReader<SerializerEndian::Little>& stream, TestStruct& value);
+#include "Shader.h"
+static constexpr array<ReflectEnumValue, 3> reflectEnumByName_SROType =
+{{
+  { "Sampler", (int)SROType_Sampler },
+  { "UBO", (int)SROType_UBO },
+  { "Unknown", (int)SROType_Unknown }
+}};
+static constexpr array<ReflectEnumValue, 3> reflectEnumByValue_SROType = ReflectSortByValue(reflectEnumByName_SROType);
+constinit const ReflectEnumInfo reflectEnumInfo_SROType = { "SROType", reflectEnumByName_SROType, reflectEnumByValue_SROType };
+bool SROType_StringToEnum(string_view name, SROType &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_SROType.StringToInt(name, intValue))
+    return false;
+  value = (SROType)intValue;
+  return true;
+}
+string_view SROType_EnumToString(SROType value)
+{
+  return reflectEnumInfo_SROType.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_NeoModulePri;
-bool NeoModulePri_StringToEnum(string name, NeoModulePri &value)
-{
-  auto it = enumReflect_NeoModulePri.map_stringToInt.find(name);
-  if (it != enumReflect_NeoModulePri.map_stringToInt.end())
-  {
-    value = (NeoModulePri)it->second;    return true;
-  }
-  return false;
-}
-string NeoModulePri_EnumToString(NeoModulePri value)
-{
-  auto it = enumReflect_NeoModulePri.map_intToString.find((int)value);
-  if (it != enumReflect_NeoModulePri.map_intToString.end())
-    return it->second;
-  return "";
+static constexpr array<ReflectEnumValue, 3> reflectEnumByName_SROStage =
+{{
+  { "Fragment", (int)SROStage_Fragment },
+  { "Geometry", (int)SROStage_Geometry },
+  { "Vertex", (int)SROStage_Vertex }
+}};
+static constexpr array<ReflectEnumValue, 3> reflectEnumByValue_SROStage = ReflectSortByValue(reflectEnumByName_SROStage);
+constinit const ReflectEnumInfo reflectEnumInfo_SROStage = { "SROStage", reflectEnumByName_SROStage, reflectEnumByValue_SROStage };
+bool SROStage_StringToEnum(string_view name, SROStage &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_SROStage.StringToInt(name, intValue))
+    return false;
+  value = (SROStage)intValue;
+  return true;
+}
+string_view SROStage_EnumToString(SROStage value)
+{
+  return reflectEnumInfo_SROStage.IntToString((int)value);
 }
 
-#include "Shader.h"
-ReflectEnumInfo enumReflect_SROType;
-bool SROType_StringToEnum(string name, SROType &value)
-{
-  auto it = enumReflect_SROType.map_stringToInt.find(name);
-  if (it != enumReflect_SROType.map_stringToInt.end())
-  {
-    value = (SROType)it->second;    return true;
-  }
-  return false;
+#include "Module.h"
+static constexpr array<ReflectEnumValue, 21> reflectEnumByName_NeoModuleInitPri =
+{{
+  { "Application", (int)NeoModuleInitPri_Application },
+  { "AssetManager", (int)NeoModuleInitPri_AssetManager },
+  { "BitmapFontFactory", (int)NeoModuleInitPri_BitmapFontFactory },
+  { "DefDynamicRenderer", (int)NeoModuleInitPri_DefDynamicRenderer },
+  { "FileManager", (int)NeoModuleInitPri_FileManager },
+  { "GIL", (int)NeoModuleInitPri_GIL },
+  { "ImmDynamicRenderer", (int)NeoModuleInitPri_ImmDynamicRenderer },
+  { "MaterialFactory", (int)NeoModuleInitPri_MaterialFactory },
+  { "PIL", (int)NeoModuleInitPri_PIL },
+  { "Profiler", (int)NeoModuleInitPri_Profiler },
+  { "Reflect", (int)NeoModuleInitPri_Reflect },
+  { "RenderPassFactory", (int)NeoModuleInitPri_RenderPassFactory },
+  { "RenderSceneFactory", (int)NeoModuleInitPri_RenderSceneFactory },
+  { "RenderThread", (int)NeoModuleInitPri_RenderThread },
+  { "ResourceLoadedManager", (int)NeoModuleInitPri_ResourceLoadedManager },
+  { "ShaderFactory", (int)NeoModuleInitPri_ShaderFactory },
+  { "ShaderManager", (int)NeoModuleInitPri_ShaderManager },
+  { "StaticMeshFactory", (int)NeoModuleInitPri_StaticMeshFactory },
+  { "TextureFactory", (int)NeoModuleInitPri_TextureFactory },
+  { "TimeManager", (int)NeoModuleInitPri_TimeManager },
+  { "View", (int)NeoModuleInitPri_View }
+}};
+static constexpr array<ReflectEnumValue, 21> reflectEnumByValue_NeoModuleInitPri = ReflectSortByValue(reflectEnumByName_NeoModuleInitPri);
+constinit const ReflectEnumInfo reflectEnumInfo_NeoModuleInitPri = { "NeoModuleInitPri", reflectEnumByName_NeoModuleInitPri, reflectEnumByValue_NeoModuleInitPri };
+bool NeoModuleInitPri_StringToEnum(string_view name, NeoModuleInitPri &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_NeoModuleInitPri.StringToInt(name, intValue))
+    return false;
+  value = (NeoModuleInitPri)intValue;
+  return true;
+}
+string_view NeoModuleInitPri_EnumToString(NeoModuleInitPri value)
+{
+  return reflectEnumInfo_NeoModuleInitPri.IntToString((int)value);
 }
-string SROType_EnumToString(SROType value)
-{
-  auto it = enumReflect_SROType.map_intToString.find((int)value);
-  if (it != enumReflect_SROType.map_intToString.end())
-    return it->second;
-  return "";
+
+static constexpr array<ReflectEnumValue, 6> reflectEnumByName_NeoModulePri =
+{{
+  { "Early", (int)NeoModulePri_Early },
+  { "First", (int)NeoModulePri_First },
+  { "Last", (int)NeoModulePri_Last },
+  { "Late", (int)NeoModulePri_Late },
+  { "Mid", (int)NeoModulePri_Mid },
+  { "None", (int)NeoModulePri_None }
+}};
+static constexpr array<ReflectEnumValue, 6> reflectEnumByValue_NeoModulePri = ReflectSortByValue(reflectEnumByName_NeoModulePri);
+constinit const ReflectEnumInfo reflectEnumInfo_NeoModulePri = { "NeoModulePri", reflectEnumByName_NeoModulePri, reflectEnumByValue_NeoModulePri };
+bool NeoModulePri_StringToEnum(string_view name, NeoModulePri &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_NeoModulePri.StringToInt(name, intValue))
+    return false;
+  value = (NeoModulePri)intValue;
+  return true;
+}
+string_view NeoModulePri_EnumToString(NeoModulePri value)
+{
+  return reflectEnumInfo_NeoModulePri.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_SROStage;
-bool SROStage_StringToEnum(string name, SROStage &value)
-{
-  auto it = enumReflect_SROStage.map_stringToInt.find(name);
-  if (it != enumReflect_SROStage.map_stringToInt.end())
-  {
-    value = (SROStage)it->second;    return true;
-  }
-  return false;
+#include "Serializer.h"
+static constexpr array<ReflectEnumValue, 6> reflectEnumByName_SerializerError =
+{{
+  { "BadData", (int)SerializerError_BadData },
+  { "BadVersion", (int)SerializerError_BadVersion },
+  { "BufferEmpty", (int)SerializerError_BufferEmpty },
+  { "FileNotFound", (int)SerializerError_FileNotFound },
+  { "OK", (int)SerializerError_OK },
+  { "TruncatedBlock", (int)SerializerError_TruncatedBlock }
+}};
+static constexpr array<ReflectEnumValue, 6> reflectEnumByValue_SerializerError = ReflectSortByValue(reflectEnumByName_SerializerError);
+constinit const ReflectEnumInfo reflectEnumInfo_SerializerError = { "SerializerError", reflectEnumByName_SerializerError, reflectEnumByValue_SerializerError };
+bool SerializerError_StringToEnum(string_view name, SerializerError &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_SerializerError.StringToInt(name, intValue))
+    return false;
+  value = (SerializerError)intValue;
+  return true;
+}
+string_view SerializerError_EnumToString(SerializerError value)
+{
+  return reflectEnumInfo_SerializerError.IntToString((int)value);
 }
-string SROStage_EnumToString(SROStage value)
-{
-  auto it = enumReflect_SROStage.map_intToString.find((int)value);
-  if (it != enumReflect_SROStage.map_intToString.end())
-    return it->second;
-  return "";
+
+#include "Material.h"
+static constexpr array<ReflectEnumValue, 5> reflectEnumByName_MaterialBlendMode =
+{{
+  { "Additive", (int)MaterialBlendMode_Additive },
+  { "Alpha", (int)MaterialBlendMode_Alpha },
+  { "Blend", (int)MaterialBlendMode_Blend },
+  { "Opaque", (int)MaterialBlendMode_Opaque },
+  { "Subtractive", (int)MaterialBlendMode_Subtractive }
+}};
+static constexpr array<ReflectEnumValue, 5> reflectEnumByValue_MaterialBlendMode = ReflectSortByValue(reflectEnumByName_MaterialBlendMode);
+constinit const ReflectEnumInfo reflectEnumInfo_MaterialBlendMode = { "MaterialBlendMode", reflectEnumByName_MaterialBlendMode, reflectEnumByValue_MaterialBlendMode };
+bool MaterialBlendMode_StringToEnum(string_view name, MaterialBlendMode &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_MaterialBlendMode.StringToInt(name, intValue))
+    return false;
+  value = (MaterialBlendMode)intValue;
+  return true;
+}
+string_view MaterialBlendMode_EnumToString(MaterialBlendMode value)
+{
+  return reflectEnumInfo_MaterialBlendMode.IntToString((int)value);
 }
 
-#include "Texture.h"
-ReflectEnumInfo enumReflect_TextureLayout;
-bool TextureLayout_StringToEnum(string name, TextureLayout &value)
-{
-  auto it = enumReflect_TextureLayout.map_stringToInt.find(name);
-  if (it != enumReflect_TextureLayout.map_stringToInt.end())
-  {
-    value = (TextureLayout)it->second;    return true;
-  }
-  return false;
+static constexpr array<ReflectEnumValue, 3> reflectEnumByName_MaterialCullMode =
+{{
+  { "Back", (int)MaterialCullMode_Back },
+  { "Front", (int)MaterialCullMode_Front },
+  { "None", (int)MaterialCullMode_None }
+}};
+static constexpr array<ReflectEnumValue, 3> reflectEnumByValue_MaterialCullMode = ReflectSortByValue(reflectEnumByName_MaterialCullMode);
+constinit const ReflectEnumInfo reflectEnumInfo_MaterialCullMode = { "MaterialCullMode", reflectEnumByName_MaterialCullMode, reflectEnumByValue_MaterialCullMode };
+bool MaterialCullMode_StringToEnum(string_view name, MaterialCullMode &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_MaterialCullMode.StringToInt(name, intValue))
+    return false;
+  value = (MaterialCullMode)intValue;
+  return true;
+}
+string_view MaterialCullMode_EnumToString(MaterialCullMode value)
+{
+  return reflectEnumInfo_MaterialCullMode.IntToString((int)value);
 }
-string TextureLayout_EnumToString(TextureLayout value)
-{
-  auto it = enumReflect_TextureLayout.map_intToString.find((int)value);
-  if (it != enumReflect_TextureLayout.map_intToString.end())
-    return it->second;
-  return "";
+
+static constexpr array<ReflectEnumValue, 6> reflectEnumByName_SamplerFilter =
+{{
+  { "Linear", (int)SamplerFilter_Linear },
+  { "LinearMipLinear", (int)SamplerFilter_LinearMipLinear },
+  { "LinearMipNearest", (int)SamplerFilter_LinearMipNearest },
+  { "Nearest", (int)SamplerFilter_Nearest },
+  { "NearestMipLinear", (int)SamplerFilter_NearestMipLinear },
+  { "NearestMipNearest", (int)SamplerFilter_NearestMipNearest }
+}};
+static constexpr array<ReflectEnumValue, 6> reflectEnumByValue_SamplerFilter = ReflectSortByValue(reflectEnumByName_SamplerFilter);
+constinit const ReflectEnumInfo reflectEnumInfo_SamplerFilter = { "SamplerFilter", reflectEnumByName_SamplerFilter, reflectEnumByValue_SamplerFilter };
+bool SamplerFilter_StringToEnum(string_view name, SamplerFilter &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_SamplerFilter.StringToInt(name, intValue))
+    return false;
+  value = (SamplerFilter)intValue;
+  return true;
+}
+string_view SamplerFilter_EnumToString(SamplerFilter value)
+{
+  return reflectEnumInfo_SamplerFilter.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_TextureType;
-bool TextureType_StringToEnum(string name, TextureType &value)
+static constexpr array<ReflectEnumValue, 2> reflectEnumByName_SamplerWrap =
+{{
+  { "Clamp", (int)SamplerWrap_Clamp },
+  { "Repeat", (int)SamplerWrap_Repeat }
+}};
+static constexpr array<ReflectEnumValue, 2> reflectEnumByValue_SamplerWrap = ReflectSortByValue(reflectEnumByName_SamplerWrap);
+constinit const ReflectEnumInfo reflectEnumInfo_SamplerWrap = { "SamplerWrap", reflectEnumByName_SamplerWrap, reflectEnumByValue_SamplerWrap };
+bool SamplerWrap_StringToEnum(string_view name, SamplerWrap &value)
 {
-  auto it = enumReflect_TextureType.map_stringToInt.find(name);
-  if (it != enumReflect_TextureType.map_stringToInt.end())
-  {
-    value = (TextureType)it->second;    return true;
-  }
-  return false;
+  int intValue;
+  if (!reflectEnumInfo_SamplerWrap.StringToInt(name, intValue))
+    return false;
+  value = (SamplerWrap)intValue;
+  return true;
 }
-string TextureType_EnumToString(TextureType value)
+string_view SamplerWrap_EnumToString(SamplerWrap value)
 {
-  auto it = enumReflect_TextureType.map_intToString.find((int)value);
-  if (it != enumReflect_TextureType.map_intToString.end())
-    return it->second;
-  return "";
+  return reflectEnumInfo_SamplerWrap.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_TexturePixelFormat;
-bool TexturePixelFormat_StringToEnum(string name, TexturePixelFormat &value)
-{
-  auto it = enumReflect_TexturePixelFormat.map_stringToInt.find(name);
-  if (it != enumReflect_TexturePixelFormat.map_stringToInt.end())
-  {
-    value = (TexturePixelFormat)it->second;    return true;
-  }
-  return false;
-}
-string TexturePixelFormat_EnumToString(TexturePixelFormat value)
-{
-  auto it = enumReflect_TexturePixelFormat.map_intToString.find((int)value);
-  if (it != enumReflect_TexturePixelFormat.map_intToString.end())
-    return it->second;
-  return "";
+static constexpr array<ReflectEnumValue, 3> reflectEnumByName_SamplerCompare =
+{{
+  { "GEqual", (int)SamplerCompare_GEqual },
+  { "LEqual", (int)SamplerCompare_LEqual },
+  { "None", (int)SamplerCompare_None }
+}};
+static constexpr array<ReflectEnumValue, 3> reflectEnumByValue_SamplerCompare = ReflectSortByValue(reflectEnumByName_SamplerCompare);
+constinit const ReflectEnumInfo reflectEnumInfo_SamplerCompare = { "SamplerCompare", reflectEnumByName_SamplerCompare, reflectEnumByValue_SamplerCompare };
+bool SamplerCompare_StringToEnum(string_view name, SamplerCompare &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_SamplerCompare.StringToInt(name, intValue))
+    return false;
+  value = (SamplerCompare)intValue;
+  return true;
+}
+string_view SamplerCompare_EnumToString(SamplerCompare value)
+{
+  return reflectEnumInfo_SamplerCompare.IntToString((int)value);
 }
 
-ReflectStructInfo reflectStructInfo_TestStruct
-{
-  "TestStruct", sizeof(TestStruct),
-  {
-    { "pos", VarType_vec3, sizeof(vec3), offsetof(TestStruct, pos) },
-    { "time", VarType_f32, sizeof(f32), offsetof(TestStruct, time) },
-    { "OnButtonPress", VarType_func, 0, 0, [](void* obj) { ((TestStruct*)obj)->OnButtonPress(); } }
-  }
-};
-#include "Thread.h"
-ReflectEnumInfo enumReflect_ThreadGUID;
-bool ThreadGUID_StringToEnum(string name, ThreadGUID &value)
-{
-  auto it = enumReflect_ThreadGUID.map_stringToInt.find(name);
-  if (it != enumReflect_ThreadGUID.map_stringToInt.end())
-  {
-    value = (ThreadGUID)it->second;    return true;
-  }
-  return false;
+#include "FileExcludes.h"
+static constexpr array<ReflectEnumValue, 4> reflectEnumByName_FSExcludeType =
+{{
+  { "Dir", (int)FSExcludeType_Dir },
+  { "Ext", (int)FSExcludeType_Ext },
+  { "File", (int)FSExcludeType_File },
+  { "MAX", (int)FSExcludeType_MAX }
+}};
+static constexpr array<ReflectEnumValue, 4> reflectEnumByValue_FSExcludeType = ReflectSortByValue(reflectEnumByName_FSExcludeType);
+constinit const ReflectEnumInfo reflectEnumInfo_FSExcludeType = { "FSExcludeType", reflectEnumByName_FSExcludeType, reflectEnumByValue_FSExcludeType };
+bool FSExcludeType_StringToEnum(string_view name, FSExcludeType &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_FSExcludeType.StringToInt(name, intValue))
+    return false;
+  value = (FSExcludeType)intValue;
+  return true;
+}
+string_view FSExcludeType_EnumToString(FSExcludeType value)
+{
+  return reflectEnumInfo_FSExcludeType.IntToString((int)value);
 }
-string ThreadGUID_EnumToString(ThreadGUID value)
-{
-  auto it = enumReflect_ThreadGUID.map_intToString.find((int)value);
-  if (it != enumReflect_ThreadGUID.map_intToString.end())
-    return it->second;
-  return "";
+
+#include "BitmapFont.h"
+static constexpr array<ReflectEnumValue, 9> reflectEnumByName_Alignment =
+{{
+  { "BottomCenter", (int)Alignment_BottomCenter },
+  { "BottomLeft", (int)Alignment_BottomLeft },
+  { "BottomRight", (int)Alignment_BottomRight },
+  { "Center", (int)Alignment_Center },
+  { "CenterLeft", (int)Alignment_CenterLeft },
+  { "CenterRight", (int)Alignment_CenterRight },
+  { "TopCenter", (int)Alignment_TopCenter },
+  { "TopLeft", (int)Alignment_TopLeft },
+  { "TopRight", (int)Alignment_TopRight }
+}};
+static constexpr array<ReflectEnumValue, 9> reflectEnumByValue_Alignment = ReflectSortByValue(reflectEnumByName_Alignment);
+constinit const ReflectEnumInfo reflectEnumInfo_Alignment = { "Alignment", reflectEnumByName_Alignment, reflectEnumByValue_Alignment };
+bool Alignment_StringToEnum(string_view name, Alignment &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_Alignment.StringToInt(name, intValue))
+    return false;
+  value = (Alignment)intValue;
+  return true;
+}
+string_view Alignment_EnumToString(Alignment value)
+{
+  return reflectEnumInfo_Alignment.IntToString((int)value);
 }
 
-#include "ShaderManager.h"
-ReflectEnumInfo enumReflect_VertexFormat;
-bool VertexFormat_StringToEnum(string name, VertexFormat &value)
-{
-  auto it = enumReflect_VertexFormat.map_stringToInt.find(name);
-  if (it != enumReflect_VertexFormat.map_stringToInt.end())
+static constexpr array<ReflectStructMemberInfo, 12> reflectStructMembers_BitmapFontInfo =
+{{
+  { "size", VarType_i32, sizeof(BitmapFontInfo::size), offsetof(BitmapFontInfo, size) },
+  { "stretchH", VarType_i32, sizeof(BitmapFontInfo::stretchH), offsetof(BitmapFontInfo, stretchH) },
+  { "padding", VarType_ivec4, sizeof(BitmapFontInfo::padding), offsetof(BitmapFontInfo, padding) },
+  { "spacing", VarType_ivec2, sizeof(BitmapFontInfo::spacing), offsetof(BitmapFontInfo, spacing) },
+  { "lineHeight", VarType_i32, sizeof(BitmapFontInfo::lineHeight), offsetof(BitmapFontInfo, lineHeight) },
+  { "base", VarType_i32, sizeof(BitmapFontInfo::base), offsetof(BitmapFontInfo, base) },
+  { "scaleW", VarType_i32, sizeof(BitmapFontInfo::scaleW), offsetof(BitmapFontInfo, scaleW) },
+  { "scaleH", VarType_i32, sizeof(BitmapFontInfo::scaleH), offsetof(BitmapFontInfo, scaleH) },
+  { "pages", VarType_i32, sizeof(BitmapFontInfo::pages), offsetof(BitmapFontInfo, pages) },
+  { "redChnl", VarType_i32, sizeof(BitmapFontInfo::redChnl), offsetof(BitmapFontInfo, redChnl) },
+  { "greenChnl", VarType_i32, sizeof(BitmapFontInfo::greenChnl), offsetof(BitmapFontInfo, greenChnl) },
+  { "blueChnl", VarType_i32, sizeof(BitmapFontInfo::blueChnl), offsetof(BitmapFontInfo, blueChnl) }
+}};
+constinit const ReflectStructInfo reflectStructInfo_BitmapFontInfo = { "BitmapFontInfo", sizeof(BitmapFontInfo), reflectStructMembers_BitmapFontInfo };
+template <SerializerEndian Endian> void BitmapFontInfo_Write(BinaryWriter<Endian>& stream, const BitmapFontInfo& value)
+{
+  static_assert(BinaryWriter<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  stream.WriteU64(BitmapFontInfo_SchemaHash);
+  stream.WriteString(value.face);
+  stream.WriteString(value.charset);
+  if constexpr (offsetof(BitmapFontInfo, stretchH) == offsetof(BitmapFontInfo, size) + sizeof(BitmapFontInfo::size))
+    stream.WriteMemory(&value.size, offsetof(BitmapFontInfo, stretchH) + sizeof(BitmapFontInfo::stretchH) - offsetof(BitmapFontInfo, size));
+  else
   {
-    value = (VertexFormat)it->second;    return true;
+    stream.WriteMemory(&value.size, sizeof(BitmapFontInfo::size));
+    stream.WriteMemory(&value.stretchH, sizeof(BitmapFontInfo::stretchH));
   }
-  return false;
-}
-string VertexFormat_EnumToString(VertexFormat value)
-{
-  auto it = enumReflect_VertexFormat.map_intToString.find((int)value);
-  if (it != enumReflect_VertexFormat.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-ReflectEnumInfo enumReflect_VertAttribType;
-bool VertAttribType_StringToEnum(string name, VertAttribType &value)
-{
-  auto it = enumReflect_VertAttribType.map_stringToInt.find(name);
-  if (it != enumReflect_VertAttribType.map_stringToInt.end())
+  stream.WriteBool(value.bold);
+  stream.WriteBool(value.italic);
+  stream.WriteBool(value.unicode);
+  stream.WriteBool(value.smooth);
+  stream.WriteBool(value.aa);
+  stream.WriteBool(value.outline);
+  stream.WriteBool(value.packed);
+  stream.WriteBool(value.alphaChnl);
+  if constexpr (offsetof(BitmapFontInfo, spacing) == offsetof(BitmapFontInfo, padding) + sizeof(BitmapFontInfo::padding) && offsetof(BitmapFontInfo, lineHeight) == offsetof(BitmapFontInfo, spacing) + sizeof(BitmapFontInfo::spacing) && offsetof(BitmapFontInfo, base) == offsetof(BitmapFontInfo, lineHeight) + sizeof(BitmapFontInfo::lineHeight) && offsetof(BitmapFontInfo, scaleW) == offsetof(BitmapFontInfo, base) + sizeof(BitmapFontInfo::base) && offsetof(BitmapFontInfo, scaleH) == offsetof(BitmapFontInfo, scaleW) + sizeof(BitmapFontInfo::scaleW) && offsetof(BitmapFontInfo, pages) == offsetof(BitmapFontInfo, scaleH) + sizeof(BitmapFontInfo::scaleH) && offsetof(BitmapFontInfo, redChnl) == offsetof(BitmapFontInfo, pages) + sizeof(BitmapFontInfo::pages) && offsetof(BitmapFontInfo, greenChnl) == offsetof(BitmapFontInfo, redChnl) + sizeof(BitmapFontInfo::redChnl) && offsetof(BitmapFontInfo, blueChnl) == offsetof(BitmapFontInfo, greenChnl) + sizeof(BitmapFontInfo::greenChnl))
+    stream.WriteMemory(&value.padding, offsetof(BitmapFontInfo, blueChnl) + sizeof(BitmapFontInfo::blueChnl) - offsetof(BitmapFontInfo, padding));
+  else
   {
-    value = (VertAttribType)it->second;    return true;
+    stream.WriteMemory(&value.padding, sizeof(BitmapFontInfo::padding));
+    stream.WriteMemory(&value.spacing, sizeof(BitmapFontInfo::spacing));
+    stream.WriteMemory(&value.lineHeight, sizeof(BitmapFontInfo::lineHeight));
+    stream.WriteMemory(&value.base, sizeof(BitmapFontInfo::base));
+    stream.WriteMemory(&value.scaleW, sizeof(BitmapFontInfo::scaleW));
+    stream.WriteMemory(&value.scaleH, sizeof(BitmapFontInfo::scaleH));
+    stream.WriteMemory(&value.pages, sizeof(BitmapFontInfo::pages));
+    stream.WriteMemory(&value.redChnl, sizeof(BitmapFontInfo::redChnl));
+    stream.WriteMemory(&value.greenChnl, sizeof(BitmapFontInfo::greenChnl));
+    stream.WriteMemory(&value.blueChnl, sizeof(BitmapFontInfo::blueChnl));
   }
-  return false;
 }
-string VertAttribType_EnumToString(VertAttribType value)
-{
-  auto it = enumReflect_VertAttribType.map_intToString.find((int)value);
-  if (it != enumReflect_VertAttribType.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-#include "BitmapFont.h"
-ReflectEnumInfo enumReflect_Alignment;
-bool Alignment_StringToEnum(string name, Alignment &value)
+template <SerializerEndian Endian> bool BitmapFontInfo_Read(BinaryReader<Endian>& stream, BitmapFontInfo& value)
 {
-  auto it = enumReflect_Alignment.map_stringToInt.find(name);
-  if (it != enumReflect_Alignment.map_stringToInt.end())
+  static_assert(BinaryReader<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  if (stream.ReadU64() != BitmapFontInfo_SchemaHash)
+    return false;
+  value.face = stream.ReadString();
+  value.charset = stream.ReadString();
+  if constexpr (offsetof(BitmapFontInfo, stretchH) == offsetof(BitmapFontInfo, size) + sizeof(BitmapFontInfo::size))
+    stream.ReadMemory(&value.size, offsetof(BitmapFontInfo, stretchH) + sizeof(BitmapFontInfo::stretchH) - offsetof(BitmapFontInfo, size));
+  else
   {
-    value = (Alignment)it->second;    return true;
+    stream.ReadMemory(&value.size, sizeof(BitmapFontInfo::size));
+    stream.ReadMemory(&value.stretchH, sizeof(BitmapFontInfo::stretchH));
   }
-  return false;
-}
-string Alignment_EnumToString(Alignment value)
-{
-  auto it = enumReflect_Alignment.map_intToString.find((int)value);
-  if (it != enumReflect_Alignment.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-#include "Material.h"
-ReflectEnumInfo enumReflect_MaterialBlendMode;
-bool MaterialBlendMode_StringToEnum(string name, MaterialBlendMode &value)
-{
-  auto it = enumReflect_MaterialBlendMode.map_stringToInt.find(name);
-  if (it != enumReflect_MaterialBlendMode.map_stringToInt.end())
+  value.bold = stream.ReadBool();
+  value.italic = stream.ReadBool();
+  value.unicode = stream.ReadBool();
+  value.smooth = stream.ReadBool();
+  value.aa = stream.ReadBool();
+  value.outline = stream.ReadBool();
+  value.packed = stream.ReadBool();
+  value.alphaChnl = stream.ReadBool();
+  if constexpr (offsetof(BitmapFontInfo, spacing) == offsetof(BitmapFontInfo, padding) + sizeof(BitmapFontInfo::padding) && offsetof(BitmapFontInfo, lineHeight) == offsetof(BitmapFontInfo, spacing) + sizeof(BitmapFontInfo::spacing) && offsetof(BitmapFontInfo, base) == offsetof(BitmapFontInfo, lineHeight) + sizeof(BitmapFontInfo::lineHeight) && offsetof(BitmapFontInfo, scaleW) == offsetof(BitmapFontInfo, base) + sizeof(BitmapFontInfo::base) && offsetof(BitmapFontInfo, scaleH) == offsetof(BitmapFontInfo, scaleW) + sizeof(BitmapFontInfo::scaleW) && offsetof(BitmapFontInfo, pages) == offsetof(BitmapFontInfo, scaleH) + sizeof(BitmapFontInfo::scaleH) && offsetof(BitmapFontInfo, redChnl) == offsetof(BitmapFontInfo, pages) + sizeof(BitmapFontInfo::pages) && offsetof(BitmapFontInfo, greenChnl) == offsetof(BitmapFontInfo, redChnl) + sizeof(BitmapFontInfo::redChnl) && offsetof(BitmapFontInfo, blueChnl) == offsetof(BitmapFontInfo, greenChnl) + sizeof(BitmapFontInfo::greenChnl))
+    stream.ReadMemory(&value.padding, offsetof(BitmapFontInfo, blueChnl) + sizeof(BitmapFontInfo::blueChnl) - offsetof(BitmapFontInfo, padding));
+  else
   {
-    value = (MaterialBlendMode)it->second;    return true;
+    stream.ReadMemory(&value.padding, sizeof(BitmapFontInfo::padding));
+    stream.ReadMemory(&value.spacing, sizeof(BitmapFontInfo::spacing));
+    stream.ReadMemory(&value.lineHeight, sizeof(BitmapFontInfo::lineHeight));
+    stream.ReadMemory(&value.base, sizeof(BitmapFontInfo::base));
+    stream.ReadMemory(&value.scaleW, sizeof(BitmapFontInfo::scaleW));
+    stream.ReadMemory(&value.scaleH, sizeof(BitmapFontInfo::scaleH));
+    stream.ReadMemory(&value.pages, sizeof(BitmapFontInfo::pages));
+    stream.ReadMemory(&value.redChnl, sizeof(BitmapFontInfo::redChnl));
+    stream.ReadMemory(&value.greenChnl, sizeof(BitmapFontInfo::greenChnl));
+    stream.ReadMemory(&value.blueChnl, sizeof(BitmapFontInfo::blueChnl));
   }
-  return false;
-}
-string MaterialBlendMode_EnumToString(MaterialBlendMode value)
-{
-  auto it = enumReflect_MaterialBlendMode.map_intToString.find((int)value);
-  if (it != enumReflect_MaterialBlendMode.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-ReflectEnumInfo enumReflect_MaterialCullMode;
-bool MaterialCullMode_StringToEnum(string name, MaterialCullMode &value)
-{
-  auto it = enumReflect_MaterialCullMode.map_stringToInt.find(name);
-  if (it != enumReflect_MaterialCullMode.map_stringToInt.end())
+  return stream.IsGood();
+}
+template void BitmapFontInfo_Write(BinaryWriter<SerializerEndian::Little>& stream, const BitmapFontInfo& value);
+template bool BitmapFontInfo_Read(BinaryReader<SerializerEndian::Little>& stream, BitmapFontInfo& value);
+static constexpr array<ReflectStructMemberInfo, 7> reflectStructMembers_BitmapFontChar =
+{{
+  { "id", VarType_i32, sizeof(BitmapFontChar::id), offsetof(BitmapFontChar, id) },
+  { "pos", VarType_ivec2, sizeof(BitmapFontChar::pos), offsetof(BitmapFontChar, pos) },
+  { "size", VarType_ivec2, sizeof(BitmapFontChar::size), offsetof(BitmapFontChar, size) },
+  { "offset", VarType_ivec2, sizeof(BitmapFontChar::offset), offsetof(BitmapFontChar, offset) },
+  { "xadvance", VarType_i32, sizeof(BitmapFontChar::xadvance), offsetof(BitmapFontChar, xadvance) },
+  { "page", VarType_i32, sizeof(BitmapFontChar::page), offsetof(BitmapFontChar, page) },
+  { "channel", VarType_i32, sizeof(BitmapFontChar::channel), offsetof(BitmapFontChar, channel) }
+}};
+constinit const ReflectStructInfo reflectStructInfo_BitmapFontChar = { "BitmapFontChar", sizeof(BitmapFontChar), reflectStructMembers_BitmapFontChar };
+template <SerializerEndian Endian> void BitmapFontChar_Write(BinaryWriter<Endian>& stream, const BitmapFontChar& value)
+{
+  static_assert(BinaryWriter<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  stream.WriteU64(BitmapFontChar_SchemaHash);
+  if constexpr (offsetof(BitmapFontChar, pos) == offsetof(BitmapFontChar, id) + sizeof(BitmapFontChar::id) && offsetof(BitmapFontChar, size) == offsetof(BitmapFontChar, pos) + sizeof(BitmapFontChar::pos) && offsetof(BitmapFontChar, offset) == offsetof(BitmapFontChar, size) + sizeof(BitmapFontChar::size) && offsetof(BitmapFontChar, xadvance) == offsetof(BitmapFontChar, offset) + sizeof(BitmapFontChar::offset) && offsetof(BitmapFontChar, page) == offsetof(BitmapFontChar, xadvance) + sizeof(BitmapFontChar::xadvance) && offsetof(BitmapFontChar, channel) == offsetof(BitmapFontChar, page) + sizeof(BitmapFontChar::page))
+    stream.WriteMemory(&value.id, offsetof(BitmapFontChar, channel) + sizeof(BitmapFontChar::channel) - offsetof(BitmapFontChar, id));
+  else
   {
-    value = (MaterialCullMode)it->second;    return true;
+    stream.WriteMemory(&value.id, sizeof(BitmapFontChar::id));
+    stream.WriteMemory(&value.pos, sizeof(BitmapFontChar::pos));
+    stream.WriteMemory(&value.size, sizeof(BitmapFontChar::size));
+    stream.WriteMemory(&value.offset, sizeof(BitmapFontChar::offset));
+    stream.WriteMemory(&value.xadvance, sizeof(BitmapFontChar::xadvance));
+    stream.WriteMemory(&value.page, sizeof(BitmapFontChar::page));
+    stream.WriteMemory(&value.channel, sizeof(BitmapFontChar::channel));
   }
-  return false;
 }
-string MaterialCullMode_EnumToString(MaterialCullMode value)
-{
-  auto it = enumReflect_MaterialCullMode.map_intToString.find((int)value);
-  if (it != enumReflect_MaterialCullMode.map_intToString.end())
-    return it->second;
-  return "";
-}
-
-ReflectEnumInfo enumReflect_SamplerFilter;
-bool SamplerFilter_StringToEnum(string name, SamplerFilter &value)
+template <SerializerEndian Endian> bool BitmapFontChar_Read(BinaryReader<Endian>& stream, BitmapFontChar& value)
 {
-  auto it = enumReflect_SamplerFilter.map_stringToInt.find(name);
-  if (it != enumReflect_SamplerFilter.map_stringToInt.end())
+  static_assert(BinaryReader<Endian>::NativeOrder, "generated serializers copy members as they are in memory");
+  if (stream.ReadU64() != BitmapFontChar_SchemaHash)
+    return false;
+  if constexpr (offsetof(BitmapFontChar, pos) == offsetof(BitmapFontChar, id) + sizeof(BitmapFontChar::id) && offsetof(BitmapFontChar, size) == offsetof(BitmapFontChar, pos) + sizeof(BitmapFontChar::pos) && offsetof(BitmapFontChar, offset) == offsetof(BitmapFontChar, size) + sizeof(BitmapFontChar::size) && offsetof(BitmapFontChar, xadvance) == offsetof(BitmapFontChar, offset) + sizeof(BitmapFontChar::offset) && offsetof(BitmapFontChar, page) == offsetof(BitmapFontChar, xadvance) + sizeof(BitmapFontChar::xadvance) && offsetof(BitmapFontChar, channel) == offsetof(BitmapFontChar, page) + sizeof(BitmapFontChar::page))
+    stream.ReadMemory(&value.id, offsetof(BitmapFontChar, channel) + sizeof(BitmapFontChar::channel) - offsetof(BitmapFontChar, id));
+  else
   {
-    value = (SamplerFilter)it->second;    return true;
+    stream.ReadMemory(&value.id, sizeof(BitmapFontChar::id));
+    stream.ReadMemory(&value.pos, sizeof(BitmapFontChar::pos));
+    stream.ReadMemory(&value.size, sizeof(BitmapFontChar::size));
+    stream.ReadMemory(&value.offset, sizeof(BitmapFontChar::offset));
+    stream.ReadMemory(&value.xadvance, sizeof(BitmapFontChar::xadvance));
+    stream.ReadMemory(&value.page, sizeof(BitmapFontChar::page));
+    stream.ReadMemory(&value.channel, sizeof(BitmapFontChar::channel));
   }
-  return false;
+  return stream.IsGood();
 }
-string SamplerFilter_EnumToString(SamplerFilter value)
-{
-  auto it = enumReflect_SamplerFilter.map_intToString.find((int)value);
-  if (it != enumReflect_SamplerFilter.map_intToString.end())
-    return it->second;
-  return "";
+template void BitmapFontChar_Write(BinaryWriter<SerializerEndian::Little>& stream, const BitmapFontChar& value);
+template bool BitmapFontChar_Read(BinaryReader<SerializerEndian::Little>& stream, BitmapFontChar& value);
+#include "ShaderManager.h"
+static constexpr array<ReflectEnumValue, 3> reflectEnumByName_VertexFormat =
+{{
+  { "R32G32B32_SFLOAT", (int)Fmt_R32G32B32_SFLOAT },
+  { "R32G32_SFLOAT", (int)Fmt_R32G32_SFLOAT },
+  { "R8G8B8A8_UNORM", (int)Fmt_R8G8B8A8_UNORM }
+}};
+static constexpr array<ReflectEnumValue, 3> reflectEnumByValue_VertexFormat = ReflectSortByValue(reflectEnumByName_VertexFormat);
+constinit const ReflectEnumInfo reflectEnumInfo_VertexFormat = { "VertexFormat", reflectEnumByName_VertexFormat, reflectEnumByValue_VertexFormat };
+bool VertexFormat_StringToEnum(string_view name, VertexFormat &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_VertexFormat.StringToInt(name, intValue))
+    return false;
+  value = (VertexFormat)intValue;
+  return true;
+}
+string_view VertexFormat_EnumToString(VertexFormat value)
+{
+  return reflectEnumInfo_VertexFormat.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_SamplerWrap;
-bool SamplerWrap_StringToEnum(string name, SamplerWrap &value)
-{
-  auto it = enumReflect_SamplerWrap.map_stringToInt.find(name);
-  if (it != enumReflect_SamplerWrap.map_stringToInt.end())
-  {
-    value = (SamplerWrap)it->second;    return true;
-  }
-  return false;
-}
-string SamplerWrap_EnumToString(SamplerWrap value)
-{
-  auto it = enumReflect_SamplerWrap.map_intToString.find((int)value);
-  if (it != enumReflect_SamplerWrap.map_intToString.end())
-    return it->second;
-  return "";
+static constexpr array<ReflectEnumValue, 8> reflectEnumByName_VertAttribType =
+{{
+  { "f32", (int)VertAttribType_f32 },
+  { "i32", (int)VertAttribType_i32 },
+  { "ivec2", (int)VertAttribType_ivec2 },
+  { "ivec3", (int)VertAttribType_ivec3 },
+  { "ivec4", (int)VertAttribType_ivec4 },
+  { "vec2", (int)VertAttribType_vec2 },
+  { "vec3", (int)VertAttribType_vec3 },
+  { "vec4", (int)VertAttribType_vec4 }
+}};
+static constexpr array<ReflectEnumValue, 8> reflectEnumByValue_VertAttribType = ReflectSortByValue(reflectEnumByName_VertAttribType);
+constinit const ReflectEnumInfo reflectEnumInfo_VertAttribType = { "VertAttribType", reflectEnumByName_VertAttribType, reflectEnumByValue_VertAttribType };
+bool VertAttribType_StringToEnum(string_view name, VertAttribType &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_VertAttribType.StringToInt(name, intValue))
+    return false;
+  value = (VertAttribType)intValue;
+  return true;
+}
+string_view VertAttribType_EnumToString(VertAttribType value)
+{
+  return reflectEnumInfo_VertAttribType.IntToString((int)value);
 }
 
-ReflectEnumInfo enumReflect_SamplerCompare;
-bool SamplerCompare_StringToEnum(string name, SamplerCompare &value)
-{
-  auto it = enumReflect_SamplerCompare.map_stringToInt.find(name);
-  if (it != enumReflect_SamplerCompare.map_stringToInt.end())
-  {
-    value = (SamplerCompare)it->second;    return true;
-  }
-  return false;
+#include "Memory.h"
+static constexpr array<ReflectEnumValue, 12> reflectEnumByName_MemoryGroup =
+{{
+  { "AI", (int)MemoryGroup_AI },
+  { "Animation", (int)MemoryGroup_Animation },
+  { "General", (int)MemoryGroup_General },
+  { "MAX", (int)MemoryGroup_MAX },
+  { "Models", (int)MemoryGroup_Models },
+  { "Props", (int)MemoryGroup_Props },
+  { "System", (int)MemoryGroup_System },
+  { "Texture", (int)MemoryGroup_Texture },
+  { "User1", (int)MemoryGroup_User1 },
+  { "User2", (int)MemoryGroup_User2 },
+  { "User3", (int)MemoryGroup_User3 },
+  { "User4", (int)MemoryGroup_User4 }
+}};
+static constexpr array<ReflectEnumValue, 12> reflectEnumByValue_MemoryGroup = ReflectSortByValue(reflectEnumByName_MemoryGroup);
+constinit const ReflectEnumInfo reflectEnumInfo_MemoryGroup = { "MemoryGroup", reflectEnumByName_MemoryGroup, reflectEnumByValue_MemoryGroup };
+bool MemoryGroup_StringToEnum(string_view name, MemoryGroup &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_MemoryGroup.StringToInt(name, intValue))
+    return false;
+  value = (MemoryGroup)intValue;
+  return true;
+}
+string_view MemoryGroup_EnumToString(MemoryGroup value)
+{
+  return reflectEnumInfo_MemoryGroup.IntToString((int)value);
 }
-string SamplerCompare_EnumToString(SamplerCompare value)
-{
-  auto it = enumReflect_SamplerCompare.map_intToString.find((int)value);
-  if (it != enumReflect_SamplerCompare.map_intToString.end())
-    return it->second;
-  return "";
+
+#include "Thread.h"
+static constexpr array<ReflectEnumValue, 10> reflectEnumByName_ThreadGUID =
+{{
+  { "ArchiveBuilder", (int)ThreadGUID_ArchiveBuilder },
+  { "AssetDecode", (int)ThreadGUID_AssetDecode },
+  { "AssetManager", (int)ThreadGUID_AssetManager },
+  { "AssetWriter", (int)ThreadGUID_AssetWriter },
+  { "FileScan", (int)ThreadGUID_FileScan },
+  { "GILTasks", (int)ThreadGUID_GILTasks },
+  { "MAX", (int)ThreadGUID_MAX },
+  { "Main", (int)ThreadGUID_Main },
+  { "Render", (int)ThreadGUID_Render },
+  { "StreamCompress", (int)ThreadGUID_StreamCompress }
+}};
+static constexpr array<ReflectEnumValue, 10> reflectEnumByValue_ThreadGUID = ReflectSortByValue(reflectEnumByName_ThreadGUID);
+constinit const ReflectEnumInfo reflectEnumInfo_ThreadGUID = { "ThreadGUID", reflectEnumByName_ThreadGUID, reflectEnumByValue_ThreadGUID };
+bool ThreadGUID_StringToEnum(string_view name, ThreadGUID &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_ThreadGUID.StringToInt(name, intValue))
+    return false;
+  value = (ThreadGUID)intValue;
+  return true;
+}
+string_view ThreadGUID_EnumToString(ThreadGUID value)
+{
+  return reflectEnumInfo_ThreadGUID.IntToString((int)value);
 }
 
 #include "Reflection.h"
-ReflectEnumInfo enumReflect_VarType;
-bool VarType_StringToEnum(string name, VarType &value)
-{
-  auto it = enumReflect_VarType.map_stringToInt.find(name);
-  if (it != enumReflect_VarType.map_stringToInt.end())
-  {
-    value = (VarType)it->second;    return true;
-  }
-  return false;
-}
-string VarType_EnumToString(VarType value)
-{
-  auto it = enumReflect_VarType.map_intToString.find((int)value);
-  if (it != enumReflect_VarType.map_intToString.end())
-    return it->second;
-  return "";
+static constexpr array<ReflectEnumValue, 20> reflectEnumByName_VarType =
+{{
+  { "enum", (int)VarType_enum },
+  { "f32", (int)VarType_f32 },
+  { "f64", (int)VarType_f64 },
+  { "func", (int)VarType_func },
+  { "i16", (int)VarType_i16 },
+  { "i32", (int)VarType_i32 },
+  { "i64", (int)VarType_i64 },
+  { "i8", (int)VarType_i8 },
+  { "ivec2", (int)VarType_ivec2 },
+  { "ivec3", (int)VarType_ivec3 },
+  { "ivec4", (int)VarType_ivec4 },
+  { "mat4x4", (int)VarType_mat4x4 },
+  { "struct", (int)VarType_struct },
+  { "u16", (int)VarType_u16 },
+  { "u32", (int)VarType_u32 },
+  { "u64", (int)VarType_u64 },
+  { "u8", (int)VarType_u8 },
+  { "vec2", (int)VarType_vec2 },
+  { "vec3", (int)VarType_vec3 },
+  { "vec4", (int)VarType_vec4 }
+}};
+static constexpr array<ReflectEnumValue, 20> reflectEnumByValue_VarType = ReflectSortByValue(reflectEnumByName_VarType);
+constinit const ReflectEnumInfo reflectEnumInfo_VarType = { "VarType", reflectEnumByName_VarType, reflectEnumByValue_VarType };
+bool VarType_StringToEnum(string_view name, VarType &value)
+{
+  int intValue;
+  if (!reflectEnumInfo_VarType.StringToInt(name, intValue))
+    return false;
+  value = (VarType)intValue;
+  return true;
+}
+string_view VarType_EnumToString(VarType value)
+{
+  return reflectEnumInfo_VarType.IntToString((int)value);
 }
 
-void NeoInitReflection()
-{
-  enumReflect_FSExcludeType.name="FSExcludeType";
-  enumReflect_FSExcludeType.map_intToString.insert({ 0,"Dir" });
-  enumReflect_FSExcludeType.map_stringToInt.insert({ "Dir",0 });
-  enumReflect_FSExcludeType.map_intToString.insert({ 1,"File" });
-  enumReflect_FSExcludeType.map_stringToInt.insert({ "File",1 });
-  enumReflect_FSExcludeType.map_intToString.insert({ 2,"Ext" });
-  enumReflect_FSExcludeType.map_stringToInt.insert({ "Ext",2 });
-  enumReflect_FSExcludeType.map_intToString.insert({ 3,"MAX" });
-  enumReflect_FSExcludeType.map_stringToInt.insert({ "MAX",3 });
-  enumReflect_MemoryGroup.name="MemoryGroup";
-  enumReflect_MemoryGroup.map_intToString.insert({ 0,"General" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "General",0 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 1,"System" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "System",1 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 2,"Texture" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "Texture",2 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 3,"Models" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "Models",3 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 4,"Animation" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "Animation",4 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 5,"Props" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "Props",5 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 6,"AI" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "AI",6 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 7,"User1" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "User1",7 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 8,"User2" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "User2",8 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 9,"User3" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "User3",9 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 10,"User4" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "User4",10 });
-  enumReflect_MemoryGroup.map_intToString.insert({ 11,"MAX" });
-  enumReflect_MemoryGroup.map_stringToInt.insert({ "MAX",11 });
-  enumReflect_SerializerError.name="SerializerError";
-  enumReflect_SerializerError.map_intToString.insert({ 0,"OK" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "OK",0 });
-  enumReflect_SerializerError.map_intToString.insert({ 1,"FileNotFound" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "FileNotFound",1 });
-  enumReflect_SerializerError.map_intToString.insert({ 2,"BadVersion" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "BadVersion",2 });
-  enumReflect_SerializerError.map_intToString.insert({ 3,"BufferEmpty" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "BufferEmpty",3 });
-  enumReflect_SerializerError.map_intToString.insert({ 4,"TruncatedBlock" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "TruncatedBlock",4 });
-  enumReflect_SerializerError.map_intToString.insert({ 5,"BadData" });
-  enumReflect_SerializerError.map_stringToInt.insert({ "BadData",5 });
-  enumReflect_NeoModuleInitPri.name="NeoModuleInitPri";
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 0,"Reflect" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "Reflect",0 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 1,"GIL" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "GIL",1 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 2,"PIL" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "PIL",2 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 3,"FileManager" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "FileManager",3 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 4,"AssetManager" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "AssetManager",4 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 5,"TimeManager" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "TimeManager",5 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 6,"ResourceLoadedManager" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "ResourceLoadedManager",6 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 7,"TextureFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "TextureFactory",7 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 8,"ShaderFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "ShaderFactory",8 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 9,"MaterialFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "MaterialFactory",9 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 10,"StaticMeshFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "StaticMeshFactory",10 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 11,"BitmapFontFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "BitmapFontFactory",11 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 12,"RenderPassFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "RenderPassFactory",12 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 13,"RenderSceneFactory" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "RenderSceneFactory",13 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 14,"RenderThread" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "RenderThread",14 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 15,"ShaderManager" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "ShaderManager",15 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 16,"DefDynamicRenderer" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "DefDynamicRenderer",16 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 17,"ImmDynamicRenderer" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "ImmDynamicRenderer",17 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 18,"Profiler" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "Profiler",18 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 19,"View" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "View",19 });
-  enumReflect_NeoModuleInitPri.map_intToString.insert({ 1000 + 0,"Application" });
-  enumReflect_NeoModuleInitPri.map_stringToInt.insert({ "Application",1000 + 0 });
-  enumReflect_NeoModulePri.name="NeoModulePri";
-  enumReflect_NeoModulePri.map_intToString.insert({ 0,"None" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "None",0 });
-  enumReflect_NeoModulePri.map_intToString.insert({ 100 + 0,"First" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "First",100 + 0 });
-  enumReflect_NeoModulePri.map_intToString.insert({ 200 + 0,"Early" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "Early",200 + 0 });
-  enumReflect_NeoModulePri.map_intToString.insert({ 300 + 0,"Mid" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "Mid",300 + 0 });
-  enumReflect_NeoModulePri.map_intToString.insert({ 400 + 0,"Late" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "Late",400 + 0 });
-  enumReflect_NeoModulePri.map_intToString.insert({ 500 + 0,"Last" });
-  enumReflect_NeoModulePri.map_stringToInt.insert({ "Last",500 + 0 });
-  enumReflect_SROType.name="SROType";
-  enumReflect_SROType.map_intToString.insert({ 0,"Unknown=-1" });
-  enumReflect_SROType.map_stringToInt.insert({ "Unknown=-1",0 });
-  enumReflect_SROType.map_intToString.insert({ 1,"UBO" });
-  enumReflect_SROType.map_stringToInt.insert({ "UBO",1 });
-  enumReflect_SROType.map_intToString.insert({ 2,"Sampler" });
-  enumReflect_SROType.map_stringToInt.insert({ "Sampler",2 });
-  enumReflect_SROStage.name="SROStage";
-  enumReflect_SROStage.map_intToString.insert({ 1 + 0,"Geometry" });
-  enumReflect_SROStage.map_stringToInt.insert({ "Geometry",1 + 0 });
-  enumReflect_SROStage.map_intToString.insert({ 2 + 0,"Vertex" });
-  enumReflect_SROStage.map_stringToInt.insert({ "Vertex",2 + 0 });
-  enumReflect_SROStage.map_intToString.insert({ 4 + 0,"Fragment" });
-  enumReflect_SROStage.map_stringToInt.insert({ "Fragment",4 + 0 });
-  enumReflect_TextureLayout.name="TextureLayout";
-  enumReflect_TextureLayout.map_intToString.insert({ 0,"Undefined" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "Undefined",0 });
-  enumReflect_TextureLayout.map_intToString.insert({ 1,"TransferDest" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "TransferDest",1 });
-  enumReflect_TextureLayout.map_intToString.insert({ 2,"ColorAttachment" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "ColorAttachment",2 });
-  enumReflect_TextureLayout.map_intToString.insert({ 3,"DepthAttachment" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "DepthAttachment",3 });
-  enumReflect_TextureLayout.map_intToString.insert({ 4,"ShaderRead" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "ShaderRead",4 });
-  enumReflect_TextureLayout.map_intToString.insert({ 5,"Present" });
-  enumReflect_TextureLayout.map_stringToInt.insert({ "Present",5 });
-  enumReflect_TextureType.name="TextureType";
-  enumReflect_TextureType.map_intToString.insert({ 0,"None" });
-  enumReflect_TextureType.map_stringToInt.insert({ "None",0 });
-  enumReflect_TextureType.map_intToString.insert({ 1,"Image" });
-  enumReflect_TextureType.map_stringToInt.insert({ "Image",1 });
-  enumReflect_TextureType.map_intToString.insert({ 2,"ColorBuffer" });
-  enumReflect_TextureType.map_stringToInt.insert({ "ColorBuffer",2 });
-  enumReflect_TextureType.map_intToString.insert({ 3,"DepthBuffer" });
-  enumReflect_TextureType.map_stringToInt.insert({ "DepthBuffer",3 });
-  enumReflect_TexturePixelFormat.name="TexturePixelFormat";
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 0,"Undefined" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "Undefined",0 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 1,"R4G4_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R4G4_UNORM",1 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 2,"R4G4B4A4_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R4G4B4A4_UNORM",2 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 3,"R5G6B5_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R5G6B5_UNORM",3 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 4,"R5G6B5A1_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R5G6B5A1_UNORM",4 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 5,"R8_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8_UNORM",5 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 6,"R8_SNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8_SNORM",6 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 7,"R8_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8_UINT",7 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 8,"R8_SINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8_SINT",8 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 9,"R8_SRGB" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8_SRGB",9 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 10,"R8G8_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8_UNORM",10 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 11,"R8G8_SNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8_SNORM",11 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 12,"R8G8_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8_UINT",12 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 13,"R8G8_SINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8_SINT",13 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 14,"R8G8B8A8_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8B8A8_UNORM",14 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 15,"R8G8B8A8_SNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8B8A8_SNORM",15 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 16,"R8G8B8A8_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8B8A8_UINT",16 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 17,"R8G8B8A8_SINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8B8A8_SINT",17 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 18,"R8G8B8A8_SRGB" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R8G8B8A8_SRGB",18 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 19,"B8G8R8A8_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B8G8R8A8_UNORM",19 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 20,"B8G8R8A8_SNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B8G8R8A8_SNORM",20 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 21,"B8G8R8A8_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B8G8R8A8_UINT",21 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 22,"B8G8R8A8_SINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B8G8R8A8_SINT",22 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 23,"B8G8R8A8_SRGB" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B8G8R8A8_SRGB",23 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 24,"R16_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R16_UNORM",24 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 25,"R16_SNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R16_SNORM",25 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 26,"R16_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R16_UINT",26 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 27,"R16_SINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R16_SINT",27 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 28,"R16_SFLOAT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "R16_SFLOAT",28 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 29,"B10G11R11_UFLOAT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "B10G11R11_UFLOAT",29 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 30,"BC1_RGB_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "BC1_RGB_UNORM",30 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 31,"BC1_RGB_SRGB" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "BC1_RGB_SRGB",31 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 32,"BC3_RGBA_UNORM" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "BC3_RGBA_UNORM",32 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 33,"BC3_RGBA_SRGB" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "BC3_RGBA_SRGB",33 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 34,"D32_SFLOAT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "D32_SFLOAT",34 });
-  enumReflect_TexturePixelFormat.map_intToString.insert({ 35,"D24_UNORM_S8_UINT" });
-  enumReflect_TexturePixelFormat.map_stringToInt.insert({ "D24_UNORM_S8_UINT",35 });
-  enumReflect_ThreadGUID.name="ThreadGUID";
-  enumReflect_ThreadGUID.map_intToString.insert({ 0,"Main" });
-  enumReflect_ThreadGUID.map_stringToInt.insert({ "Main",0 });
-  enumReflect_ThreadGUID.map_intToString.insert({ 1,"GILTasks" });
-  enumReflect_ThreadGUID.map_stringToInt.insert({ "GILTasks",1 });
-  enumReflect_ThreadGUID.map_intToString.insert({ 2,"AssetManager" });
-  enumReflect_ThreadGUID.map_stringToInt.insert({ "AssetManager",2 });
-  enumReflect_ThreadGUID.map_intToString.insert({ 3,"Render" });
-  enumReflect_ThreadGUID.map_stringToInt.insert({ "Render",3 });
-  enumReflect_ThreadGUID.map_intToString.insert({ 4,"MAX" });
-  enumReflect_ThreadGUID.map_stringToInt.insert({ "MAX",4 });
-  enumReflect_VertexFormat.name="VertexFormat";
-  enumReflect_VertexFormat.map_intToString.insert({ 0,"R8G8B8A8_UNORM" });
-  enumReflect_VertexFormat.map_stringToInt.insert({ "R8G8B8A8_UNORM",0 });
-  enumReflect_VertexFormat.map_intToString.insert({ 1,"R32G32_SFLOAT" });
-  enumReflect_VertexFormat.map_stringToInt.insert({ "R32G32_SFLOAT",1 });
-  enumReflect_VertexFormat.map_intToString.insert({ 2,"R32G32B32_SFLOAT" });
-  enumReflect_VertexFormat.map_stringToInt.insert({ "R32G32B32_SFLOAT",2 });
-  enumReflect_VertAttribType.name="VertAttribType";
-  enumReflect_VertAttribType.map_intToString.insert({ 0,"f32" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "f32",0 });
-  enumReflect_VertAttribType.map_intToString.insert({ 1,"i32" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "i32",1 });
-  enumReflect_VertAttribType.map_intToString.insert({ 2,"vec2" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "vec2",2 });
-  enumReflect_VertAttribType.map_intToString.insert({ 3,"vec3" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "vec3",3 });
-  enumReflect_VertAttribType.map_intToString.insert({ 4,"vec4" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "vec4",4 });
-  enumReflect_VertAttribType.map_intToString.insert({ 5,"ivec2" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "ivec2",5 });
-  enumReflect_VertAttribType.map_intToString.insert({ 6,"ivec3" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "ivec3",6 });
-  enumReflect_VertAttribType.map_intToString.insert({ 7,"ivec4" });
-  enumReflect_VertAttribType.map_stringToInt.insert({ "ivec4",7 });
-  enumReflect_Alignment.name="Alignment";
-  enumReflect_Alignment.map_intToString.insert({ 0,"TopLeft" });
-  enumReflect_Alignment.map_stringToInt.insert({ "TopLeft",0 });
-  enumReflect_Alignment.map_intToString.insert({ 1,"TopCenter" });
-  enumReflect_Alignment.map_stringToInt.insert({ "TopCenter",1 });
-  enumReflect_Alignment.map_intToString.insert({ 2,"TopRight" });
-  enumReflect_Alignment.map_stringToInt.insert({ "TopRight",2 });
-  enumReflect_Alignment.map_intToString.insert({ 3,"CenterLeft" });
-  enumReflect_Alignment.map_stringToInt.insert({ "CenterLeft",3 });
-  enumReflect_Alignment.map_intToString.insert({ 4,"Center" });
-  enumReflect_Alignment.map_stringToInt.insert({ "Center",4 });
-  enumReflect_Alignment.map_intToString.insert({ 5,"CenterRight" });
-  enumReflect_Alignment.map_stringToInt.insert({ "CenterRight",5 });
-  enumReflect_Alignment.map_intToString.insert({ 6,"BottomLeft" });
-  enumReflect_Alignment.map_stringToInt.insert({ "BottomLeft",6 });
-  enumReflect_Alignment.map_intToString.insert({ 7,"BottomCenter" });
-  enumReflect_Alignment.map_stringToInt.insert({ "BottomCenter",7 });
-  enumReflect_Alignment.map_intToString.insert({ 8,"BottomRight" });
-  enumReflect_Alignment.map_stringToInt.insert({ "BottomRight",8 });
-  enumReflect_MaterialBlendMode.name="MaterialBlendMode";
-  enumReflect_MaterialBlendMode.map_intToString.insert({ 0,"Opaque" });
-  enumReflect_MaterialBlendMode.map_stringToInt.insert({ "Opaque",0 });
-  enumReflect_MaterialBlendMode.map_intToString.insert({ 1,"Alpha" });
-  enumReflect_MaterialBlendMode.map_stringToInt.insert({ "Alpha",1 });
-  enumReflect_MaterialBlendMode.map_intToString.insert({ 2,"Blend" });
-  enumReflect_MaterialBlendMode.map_stringToInt.insert({ "Blend",2 });
-  enumReflect_MaterialBlendMode.map_intToString.insert({ 3,"Additive" });
-  enumReflect_MaterialBlendMode.map_stringToInt.insert({ "Additive",3 });
-  enumReflect_MaterialBlendMode.map_intToString.insert({ 4,"Subtractive" });
-  enumReflect_MaterialBlendMode.map_stringToInt.insert({ "Subtractive",4 });
-  enumReflect_MaterialCullMode.name="MaterialCullMode";
-  enumReflect_MaterialCullMode.map_intToString.insert({ 0,"None" });
-  enumReflect_MaterialCullMode.map_stringToInt.insert({ "None",0 });
-  enumReflect_MaterialCullMode.map_intToString.insert({ 1,"Front" });
-  enumReflect_MaterialCullMode.map_stringToInt.insert({ "Front",1 });
-  enumReflect_MaterialCullMode.map_intToString.insert({ 2,"Back" });
-  enumReflect_MaterialCullMode.map_stringToInt.insert({ "Back",2 });
-  enumReflect_SamplerFilter.name="SamplerFilter";
-  enumReflect_SamplerFilter.map_intToString.insert({ 0,"Nearest" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "Nearest",0 });
-  enumReflect_SamplerFilter.map_intToString.insert({ 1,"Linear" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "Linear",1 });
-  enumReflect_SamplerFilter.map_intToString.insert({ 2,"NearestMipNearest" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "NearestMipNearest",2 });
-  enumReflect_SamplerFilter.map_intToString.insert({ 3,"NearestMipLinear" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "NearestMipLinear",3 });
-  enumReflect_SamplerFilter.map_intToString.insert({ 4,"LinearMipNearest" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "LinearMipNearest",4 });
-  enumReflect_SamplerFilter.map_intToString.insert({ 5,"LinearMipLinear" });
-  enumReflect_SamplerFilter.map_stringToInt.insert({ "LinearMipLinear",5 });
-  enumReflect_SamplerWrap.name="SamplerWrap";
-  enumReflect_SamplerWrap.map_intToString.insert({ 0,"Clamp" });
-  enumReflect_SamplerWrap.map_stringToInt.insert({ "Clamp",0 });
-  enumReflect_SamplerWrap.map_intToString.insert({ 1,"Repeat" });
-  enumReflect_SamplerWrap.map_stringToInt.insert({ "Repeat",1 });
-  enumReflect_SamplerCompare.name="SamplerCompare";
-  enumReflect_SamplerCompare.map_intToString.insert({ 0,"None" });
-  enumReflect_SamplerCompare.map_stringToInt.insert({ "None",0 });
-  enumReflect_SamplerCompare.map_intToString.insert({ 1,"GEqual" });
-  enumReflect_SamplerCompare.map_stringToInt.insert({ "GEqual",1 });
-  enumReflect_SamplerCompare.map_intToString.insert({ 2,"LEqual" });
-  enumReflect_SamplerCompare.map_stringToInt.insert({ "LEqual",2 });
-  enumReflect_VarType.name="VarType";
-  enumReflect_VarType.map_intToString.insert({ 0,"u8" });
-  enumReflect_VarType.map_stringToInt.insert({ "u8",0 });
-  enumReflect_VarType.map_intToString.insert({ 1,"u16" });
-  enumReflect_VarType.map_stringToInt.insert({ "u16",1 });
-  enumReflect_VarType.map_intToString.insert({ 2,"u32" });
-  enumReflect_VarType.map_stringToInt.insert({ "u32",2 });
-  enumReflect_VarType.map_intToString.insert({ 3,"u64" });
-  enumReflect_VarType.map_stringToInt.insert({ "u64",3 });
-  enumReflect_VarType.map_intToString.insert({ 4,"i8" });
-  enumReflect_VarType.map_stringToInt.insert({ "i8",4 });
-  enumReflect_VarType.map_intToString.insert({ 5,"i16" });
-  enumReflect_VarType.map_stringToInt.insert({ "i16",5 });
-  enumReflect_VarType.map_intToString.insert({ 6,"i32" });
-  enumReflect_VarType.map_stringToInt.insert({ "i32",6 });
-  enumReflect_VarType.map_intToString.insert({ 7,"i64" });
-  enumReflect_VarType.map_stringToInt.insert({ "i64",7 });
-  enumReflect_VarType.map_intToString.insert({ 8,"f32" });
-  enumReflect_VarType.map_stringToInt.insert({ "f32",8 });
-  enumReflect_VarType.map_intToString.insert({ 9,"f64" });
-  enumReflect_VarType.map_stringToInt.insert({ "f64",9 });
-  enumReflect_VarType.map_intToString.insert({ 10,"vec2" });
-  enumReflect_VarType.map_stringToInt.insert({ "vec2",10 });
-  enumReflect_VarType.map_intToString.insert({ 11,"vec3" });
-  enumReflect_VarType.map_stringToInt.insert({ "vec3",11 });
-  enumReflect_VarType.map_intToString.insert({ 12,"vec4" });
-  enumReflect_VarType.map_stringToInt.insert({ "vec4",12 });
-  enumReflect_VarType.map_intToString.insert({ 13,"ivec2" });
-  enumReflect_VarType.map_stringToInt.insert({ "ivec2",13 });
-  enumReflect_VarType.map_intToString.insert({ 14,"ivec3" });
-  enumReflect_VarType.map_stringToInt.insert({ "ivec3",14 });
-  enumReflect_VarType.map_intToString.insert({ 15,"ivec4" });
-  enumReflect_VarType.map_stringToInt.insert({ "ivec4",15 });
-  enumReflect_VarType.map_intToString.insert({ 16,"mat4x4" });
-  enumReflect_VarType.map_stringToInt.insert({ "mat4x4",16 });
-  enumReflect_VarType.map_intToString.insert({ 17,"enum" });
-  enumReflect_VarType.map_stringToInt.insert({ "enum",17 });
-  enumReflect_VarType.map_intToString.insert({ 18,"struct" });
-  enumReflect_VarType.map_stringToInt.insert({ "struct",18 });
-  enumReflect_VarType.map_intToString.insert({ 19,"func" });
-  enumReflect_VarType.map_stringToInt.insert({ "func",19 });
-}
+static constexpr array<const ReflectEnumInfo*, 20> NeoReflectTables_enums =
+{{
+  &reflectEnumInfo_Alignment,
+  &reflectEnumInfo_FSExcludeType,
+  &reflectEnumInfo_MaterialBlendMode,
+  &reflectEnumInfo_MaterialCullMode,
+  &reflectEnumInfo_MemoryGroup,
+  &reflectEnumInfo_NeoModuleInitPri,
+  &reflectEnumInfo_NeoModulePri,
+  &reflectEnumInfo_SROStage,
+  &reflectEnumInfo_SROType,
+  &reflectEnumInfo_SamplerCompare,
+  &reflectEnumInfo_SamplerFilter,
+  &reflectEnumInfo_SamplerWrap,
+  &reflectEnumInfo_SerializerError,
+  &reflectEnumInfo_TextureLayout,
+  &reflectEnumInfo_TexturePixelFormat,
+  &reflectEnumInfo_TextureType,
+  &reflectEnumInfo_ThreadGUID,
+  &reflectEnumInfo_VarType,
+  &reflectEnumInfo_VertAttribType,
+  &reflectEnumInfo_VertexFormat
+}};
+static constexpr array<const ReflectStructInfo*, 3> NeoReflectTables_structs =
+{{
+  &reflectStructInfo_BitmapFontChar,
+  &reflectStructInfo_BitmapFontInfo,
+  &reflectStructInfo_TestStruct
+}};
+constinit const ReflectTables NeoReflectTables = { NeoReflectTables_enums, NeoReflectTables_structs };
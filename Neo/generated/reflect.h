@@ -1,85 +1,126 @@
 #pragma once
-void NeoInitReflection();
 
-enum FSExcludeType;
-bool FSExcludeType_StringToEnum(string name, FSExcludeType &value);
-string FSExcludeType_EnumToString(FSExcludeType value);
-
-enum MemoryGroup;
-bool MemoryGroup_StringToEnum(string name, MemoryGroup &value);
-string MemoryGroup_EnumToString(MemoryGroup value);
-
-enum SerializerError;
-bool SerializerError_StringToEnum(string name, SerializerError &value);
-string SerializerError_EnumToString(SerializerError value);
-
-enum NeoModuleInitPri;
-bool NeoModuleInitPri_StringToEnum(string name, NeoModuleInitPri &value);
-string NeoModuleInitPri_EnumToString(NeoModuleInitPri value);
-
-enum NeoModulePri;
-bool NeoModulePri_StringToEnum(string name, NeoModulePri &value);
-string NeoModulePri_EnumToString(NeoModulePri value);
-
-enum SROType;
-bool SROType_StringToEnum(string name, SROType &value);
-string SROType_EnumToString(SROType value);
-
-enum SROStage;
-bool SROStage_StringToEnum(string name, SROStage &value);
-string SROStage_EnumToString(SROStage value);
+// generated serializers read and write with these (Serializer.h)
+enum class SerializerEndian;
+template <SerializerEndian Endian> class BinaryWriter;
+template <SerializerEndian Endian> class BinaryReader;
 
 enum TextureLayout;
-bool TextureLayout_StringToEnum(string name, TextureLayout &value);
-string TextureLayout_EnumToString(TextureLayout value);
+extern const ReflectEnumInfo reflectEnumInfo_TextureLayout;
+bool TextureLayout_StringToEnum(string_view name, TextureLayout &value);
+string_view TextureLayout_EnumToString(TextureLayout value);
 
 enum TextureType;
-bool TextureType_StringToEnum(string name, TextureType &value);
-string TextureType_EnumToString(TextureType value);
+extern const ReflectEnumInfo reflectEnumInfo_TextureType;
+bool TextureType_StringToEnum(string_view name, TextureType &value);
+string_view TextureType_EnumToString(TextureType value);
 
 enum TexturePixelFormat;
-bool TexturePixelFormat_StringToEnum(string name, TexturePixelFormat &value);
-string TexturePixelFormat_EnumToString(TexturePixelFormat value);
+extern const ReflectEnumInfo reflectEnumInfo_TexturePixelFormat;
+bool TexturePixelFormat_StringToEnum(string_view name, TexturePixelFormat &value);
+string_view TexturePixelFormat_EnumToString(TexturePixelFormat value);
 
 //#### STRUCT TestStruct ####
-extern ReflectStructInfo reflectStructInfo_TestStruct;
-enum ThreadGUID;
-bool ThreadGUID_StringToEnum(string name, ThreadGUID &value);
-string ThreadGUID_EnumToString(ThreadGUID value);
+struct TestStruct;
+extern const ReflectStructInfo reflectStructInfo_TestStruct;
+const u64 TestStruct_SchemaHash = 0x5eb28885ae3c3f4bull;
+template <SerializerEndian Endian> void TestStruct_Write(BinaryWriter<Endian>& stream, const TestStruct& value);
+template <SerializerEndian Endian> bool TestStruct_Read(BinaryReader<Endian>& stream, TestStruct& value);
+enum SROType;
+extern const ReflectEnumInfo reflectEnumInfo_SROType;
+bool SROType_StringToEnum(string_view name, SROType &value);
+string_view SROType_EnumToString(SROType value);
 
-enum VertexFormat;
-bool VertexFormat_StringToEnum(string name, VertexFormat &value);
-string VertexFormat_EnumToString(VertexFormat value);
+enum SROStage;
+extern const ReflectEnumInfo reflectEnumInfo_SROStage;
+bool SROStage_StringToEnum(string_view name, SROStage &value);
+string_view SROStage_EnumToString(SROStage value);
 
-enum VertAttribType;
-bool VertAttribType_StringToEnum(string name, VertAttribType &value);
-string VertAttribType_EnumToString(VertAttribType value);
+enum NeoModuleInitPri;
+extern const ReflectEnumInfo reflectEnumInfo_NeoModuleInitPri;
+bool NeoModuleInitPri_StringToEnum(string_view name, NeoModuleInitPri &value);
+string_view NeoModuleInitPri_EnumToString(NeoModuleInitPri value);
 
-enum Alignment;
-bool Alignment_StringToEnum(string name, Alignment &value);
-string Alignment_EnumToString(Alignment value);
+enum NeoModulePri;
+extern const ReflectEnumInfo reflectEnumInfo_NeoModulePri;
+bool NeoModulePri_StringToEnum(string_view name, NeoModulePri &value);
+string_view NeoModulePri_EnumToString(NeoModulePri value);
+
+enum SerializerError;
+extern const ReflectEnumInfo reflectEnumInfo_SerializerError;
+bool SerializerError_StringToEnum(string_view name, SerializerError &value);
+string_view SerializerError_EnumToString(SerializerError value);
 
 enum MaterialBlendMode;
-bool MaterialBlendMode_StringToEnum(string name, MaterialBlendMode &value);
-string MaterialBlendMode_EnumToString(MaterialBlendMode value);
+extern const ReflectEnumInfo reflectEnumInfo_MaterialBlendMode;
+bool MaterialBlendMode_StringToEnum(string_view name, MaterialBlendMode &value);
+string_view MaterialBlendMode_EnumToString(MaterialBlendMode value);
 
 enum MaterialCullMode;
-bool MaterialCullMode_StringToEnum(string name, MaterialCullMode &value);
-string MaterialCullMode_EnumToString(MaterialCullMode value);
+extern const ReflectEnumInfo reflectEnumInfo_MaterialCullMode;
+bool MaterialCullMode_StringToEnum(string_view name, MaterialCullMode &value);
+string_view MaterialCullMode_EnumToString(MaterialCullMode value);
 
 enum SamplerFilter;
-bool SamplerFilter_StringToEnum(string name, SamplerFilter &value);
-string SamplerFilter_EnumToString(SamplerFilter value);
+extern const ReflectEnumInfo reflectEnumInfo_SamplerFilter;
+bool SamplerFilter_StringToEnum(string_view name, SamplerFilter &value);
+string_view SamplerFilter_EnumToString(SamplerFilter value);
 
 enum SamplerWrap;
-bool SamplerWrap_StringToEnum(string name, SamplerWrap &value);
-string SamplerWrap_EnumToString(SamplerWrap value);
+extern const ReflectEnumInfo reflectEnumInfo_SamplerWrap;
+bool SamplerWrap_StringToEnum(string_view name, SamplerWrap &value);
+string_view SamplerWrap_EnumToString(SamplerWrap value);
 
 enum SamplerCompare;
-bool SamplerCompare_StringToEnum(string name, SamplerCompare &value);
-string SamplerCompare_EnumToString(SamplerCompare value);
+extern const ReflectEnumInfo reflectEnumInfo_SamplerCompare;
+bool SamplerCompare_StringToEnum(string_view name, SamplerCompare &value);
+string_view SamplerCompare_EnumToString(SamplerCompare value);
+
+enum FSExcludeType;
+extern const ReflectEnumInfo reflectEnumInfo_FSExcludeType;
+bool FSExcludeType_StringToEnum(string_view name, FSExcludeType &value);
+string_view FSExcludeType_EnumToString(FSExcludeType value);
+
+enum Alignment;
+extern const ReflectEnumInfo reflectEnumInfo_Alignment;
+bool Alignment_StringToEnum(string_view name, Alignment &value);
+string_view Alignment_EnumToString(Alignment value);
+
+//#### STRUCT BitmapFontInfo ####
+struct BitmapFontInfo;
+extern const ReflectStructInfo reflectStructInfo_BitmapFontInfo;
+const u64 BitmapFontInfo_SchemaHash = 0x8a956f600c8e6bedull;
+template <SerializerEndian Endian> void BitmapFontInfo_Write(BinaryWriter<Endian>& stream, const BitmapFontInfo& value);
+template <SerializerEndian Endian> bool BitmapFontInfo_Read(BinaryReader<Endian>& stream, BitmapFontInfo& value);
+//#### STRUCT BitmapFontChar ####
+struct BitmapFontChar;
+extern const ReflectStructInfo reflectStructInfo_BitmapFontChar;
+const u64 BitmapFontChar_SchemaHash = 0x2a62d569499ff661ull;
+template <SerializerEndian Endian> void BitmapFontChar_Write(BinaryWriter<Endian>& stream, const BitmapFontChar& value);
+template <SerializerEndian Endian> bool BitmapFontChar_Read(BinaryReader<Endian>& stream, BitmapFontChar& value);
+enum VertexFormat;
+extern const ReflectEnumInfo reflectEnumInfo_VertexFormat;
+bool VertexFormat_StringToEnum(string_view name, VertexFormat &value);
+string_view VertexFormat_EnumToString(VertexFormat value);
+
+enum VertAttribType;
+extern const ReflectEnumInfo reflectEnumInfo_VertAttribType;
+bool VertAttribType_StringToEnum(string_view name, VertAttribType &value);
+string_view VertAttribType_EnumToString(VertAttribType value);
+
+enum MemoryGroup;
+extern const ReflectEnumInfo reflectEnumInfo_MemoryGroup;
+bool MemoryGroup_StringToEnum(string_view name, MemoryGroup &value);
+string_view MemoryGroup_EnumToString(MemoryGroup value);
+
+enum ThreadGUID;
+extern const ReflectEnumInfo reflectEnumInfo_ThreadGUID;
+bool ThreadGUID_StringToEnum(string_view name, ThreadGUID &value);
+string_view ThreadGUID_EnumToString(ThreadGUID value);
 
 enum VarType;
-bool VarType_StringToEnum(string name, VarType &value);
-string VarType_EnumToString(VarType value);
+extern const ReflectEnumInfo reflectEnumInfo_VarType;
+bool VarType_StringToEnum(string_view name, VarType &value);
+string_view VarType_EnumToString(VarType value);
 
+extern const ReflectTables NeoReflectTables;
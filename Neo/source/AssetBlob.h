@@ -0,0 +1,132 @@
+#pragma once
+
+/**************************************************************************
+AssetBlob  -  relocatable asset data that loads in place
+
+the asset's root struct sits at the start of the blob, and every array it
+refers to is stored as an offset from the start of the blob.  loading is just
+checking the header and turning offsets into pointers - the asset keeps the
+blob and its vertices, indices and pixels are used straight out of it.
+arrays are 16 byte aligned so they can be handed to the gpu upload as is.
+
+***************************************************************************/
+
+#include "MemBlock.h"
+#include "Serializer.h"
+
+#define ASSETBLOB_MAGIC 0x424f454e	// 'NEOB'
+
+// the version comes first, where every asset data format keeps it
+struct AssetBlobHeader
+{
+	u16 version;
+	u16 rootSize;		// sizeof the asset's root struct, header included
+	u32 magic;
+	u32 blobSize;
+	u32 reserved;
+};
+
+// offset from the start of the blob and element count
+template <class T>
+struct BlobArray
+{
+	u32 offset = 0;
+	u32 count = 0;
+};
+
+// true if the block starts with a blob header - older stream formats can't match the magic
+inline bool IsAssetBlob(const MemBlock& block)
+{
+	if (block.Size() < sizeof(AssetBlobHeader))
+		return false;
+	u32 magic;
+	memcpy(&magic, block.Mem() + offsetof(AssetBlobHeader, magic), sizeof(magic));
+	return magic == ASSETBLOB_MAGIC;
+}
+
+template <class Root>
+class AssetBlobWriter
+{
+	static_assert(std::is_trivially_copyable_v<Root>, "blob roots must be trivially copyable");
+	static const size_t Alignment = 16;
+
+public:
+	AssetBlobWriter(u16 version, size_t reserve = 0) : m_stream(sizeof(Root) + reserve)
+	{
+		m_stream.WriteZeros(sizeof(Root));
+		auto header = (AssetBlobHeader*)m_stream.DataStart();
+		header->version = version;
+		header->rootSize = (u16)sizeof(Root);
+		header->magic = ASSETBLOB_MAGIC;
+	}
+
+	// only valid until the next Add - adding can move the buffer
+	Root& GetRoot() { return *(Root*)m_stream.DataStart(); }
+
+	template <class T>
+	BlobArray<T> Add(std::span<const T> items)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "blob arrays must be trivially copyable");
+		m_stream.WriteZeros((Alignment - (m_stream.DataSize() & (Alignment - 1))) & (Alignment - 1));
+		BlobArray<T> array;
+		array.offset = (u32)m_stream.DataSize();
+		array.count = (u32)items.size();
+		m_stream.WriteMemory(items.data(), items.size_bytes());
+		return array;
+	}
+	template <class T>
+	BlobArray<T> Add(const vector<T>& items) { return Add(std::span<const T>(items)); }
+	BlobArray<char> Add(const string& value) { return Add(std::span<const char>(value.data(), value.size())); }
+
+	MemBlock Finish()
+	{
+		GetRoot().header.blobSize = (u32)m_stream.DataSize();
+		return m_stream.TakeBlock();
+	}
+
+protected:
+	BinaryWriter<> m_stream;
+};
+
+// checks a loaded blob and turns its offsets into pointers
+// an offset outside the blob fails the whole load rather than reading past it
+class AssetBlobReader
+{
+public:
+	AssetBlobReader(MemBlock& block) : m_mem(block.Mem()), m_size(block.Size()) {}
+
+	template <class Root>
+	Root* GetRoot(u16 version)
+	{
+		if (m_size < sizeof(Root) || ((uintptr_t)m_mem & (alignof(Root) - 1)) != 0)
+			return nullptr;
+		auto root = (Root*)m_mem;
+		if (root->header.magic != ASSETBLOB_MAGIC || root->header.version != version || root->header.rootSize != sizeof(Root) || root->header.blobSize != m_size)
+			return nullptr;
+		return root;
+	}
+
+	template <class T>
+	std::span<T> Resolve(const BlobArray<T>& array)
+	{
+		u64 end = (u64)array.offset + (u64)array.count * sizeof(T);
+		if (end > m_size || ((uintptr_t)(m_mem + array.offset) & (alignof(T) - 1)) != 0)
+		{
+			m_good = false;
+			return {};
+		}
+		return std::span<T>((T*)(m_mem + array.offset), array.count);
+	}
+	string ResolveString(const BlobArray<char>& array)
+	{
+		auto chars = Resolve(array);
+		return string(chars.data(), chars.size());
+	}
+
+	bool IsGood() const { return m_good; }
+
+protected:
+	u8* m_mem;
+	size_t m_size;
+	bool m_good = true;
+};
@@ -6,154 +6,630 @@
 
 DECLARE_MODULE(AssetManager, NeoModuleInitPri_AssetManager, NeoModulePri_None);
 
-AssetManager::AssetManager() : m_assetTasks(ThreadGUID_AssetManager, "AssetManager", 16, false)
+CmdLineVar<bool> CLV_KeepAssetData("keepassetdata", "keep cpu side asset data after upload, regardless of the asset type's residency policy", false);
+
+static const int ReadThreadCount = 4;
+
+static int DecodeThreadCount()
 {
+	return Max(2, (int)std::thread::hardware_concurrency());
+}
+
+AssetManager::AssetManager() :
+	m_assetTasks(ThreadGUID_AssetManager, "AssetManager", ReadThreadCount, false),
+	m_decodeTasks(ThreadGUID_AssetDecode, "AssetDecode", DecodeThreadCount(), false),
+	m_decodeSlots(DecodeThreadCount() * 2),
+	m_assetWriter(ThreadGUID_AssetWriter, "AssetWriter")
+{
+	// enough requests to keep every stage busy - any more would just sit in the worker queues where they can't be re-prioritized
+	m_maxRequestsInFlight = ReadThreadCount + DecodeThreadCount() * 2;
+
+	m_assetWriter.Start();
+
+	// keep the manifest in step with files edited outside the engine
+	FileManager::Instance().AddFileChangeCallback([this](FileSystem* fs, const string& name) { m_manifest.UpdateFile(fs->Name() + ":" + name); });
 }
 
 void AssetManager::StartWork()
 {
 	m_assetTasks.StartWork();
+	m_decodeTasks.StartWork();
 }
 
-
 void AssetManager::KillWorkerFarm()
 {
+	// stop requests moving between stages, and wake any reader waiting on a decode slot
+	// queued requests will never be launched now
+	bool drained;
+	{
+		ScopedMutexLock lock(m_requestLock);
+		m_shuttingDown = true;
+		for (auto request : m_queuedRequests)
+		{
+			ForgetRequest(request);
+			ReleaseFollowers(request);
+			delete request;
+		}
+		m_queuedRequests.clear();
+		drained = (m_requestsInFlight == 0);
+	}
+	m_decodeSlots.Signal();
+
+	// launched requests retire at their next stage - let the workers run them out before killing them
+	// make sure the workers have started, or tasks queued before then would never run
+	m_assetTasks.StartWork();
+	m_decodeTasks.StartWork();
+	if (!drained)
+		m_requestsDrained.Wait();
+
 	m_assetTasks.KillWorkers();
+	m_decodeTasks.KillWorkers();
+
+	FlushWrites();
+	{
+		ScopedMutexLock lock(m_pendingWritesLock);
+		m_writerStopped = true;
+	}
+	m_assetWriter.StopAndWait();
 }
 
-static int GetTime(const string name, const stringlist &extensions, u64& time)
+void AssetManager::FlushWrites()
 {
-	auto& fm = FileManager::Instance();
-	for (int i = 0; i < extensions.size(); i++)
+	// once the writer has stopped, writes are done inline - there's nothing left to wait for
 	{
-		if (fm.GetTime(name + extensions[i], time))
-			return i;
+		ScopedMutexLock lock(m_pendingWritesLock);
+		if (m_writerStopped)
+			return;
 	}
-	return -1;
+
+	// writes run in order on a single thread, so once this task runs everything queued before it is done
+	Semaphore flushed;
+	m_assetWriter.AddTask([&flushed]() { flushed.Signal(); });
+	flushed.Wait();
 }
 
-void AssetManager::DeliverAssetDataAsync(const string &assetType, const string& name, AssetCreateParams* params, const DeliverAssetDataCB& cb)
+void AssetManager::QueueWrite(const string& path, PendingWrite&& write)
 {
-	Assert(m_assetTypeInfoMap.contains(assetType), std::format("Cannot create asset: {} - unregistered asset type: {}", name, assetType));
+	{
+		ScopedMutexLock lock(m_pendingWritesLock);
+		write.serial = ++m_pendingWriteSerial;
+		auto it = m_pendingWrites.find(path);
+		if (it != m_pendingWrites.end() && it->second.taskQueued)
+		{
+			// coalesce - the task already queued for this path will write the newest data
+			write.taskQueued = true;
+			it->second = std::move(write);
+			return;
+		}
 
-	auto assetTypeInfo = m_assetTypeInfoMap[assetType];
-	m_assetTasks.AddTask
-	(
-		[assetType, assetTypeInfo, name, cb, params]()
+		// either nothing is pending, or the older write is already going to disk and this needs a task of its own
+		write.taskQueued = true;
+		m_pendingWrites[path] = std::move(write);
+		if (!m_writerStopped)
 		{
-			auto& fm = FileManager::Instance();
+			m_assetWriter.AddTask([this, path]() { ProcessWrite(path); });
+			return;
+		}
+	}
+
+	// the writer has shut down, so nothing would ever pick this up
+	ProcessWrite(path);
+}
 
-			// get datestamp of current asset file
-			u64 assetDateStamp = 0;
-			string assetDataPath = string("data:") + name + assetTypeInfo->assetExt;
-			fm.GetTime(assetDataPath, assetDateStamp);
+void AssetManager::ProcessWrite(const string& path)
+{
+	// copy rather than take the data, since loads can still find it here until it's on disk
+	PendingWrite write;
+	{
+		ScopedMutexLock lock(m_pendingWritesLock);
+		auto it = m_pendingWrites.find(path);
+		if (it == m_pendingWrites.end())
+			return;
+		it->second.taskQueued = false;
+		write = it->second;
+	}
 
-			LOG(Asset, STR(">> Request Asset: {} [{}]", name, assetType));
+	MemBlock assetBlock;
+	if (write.compressed)
+		assetBlock = std::move(write.block);
+	else
+		write.block.CompressTo(assetBlock, write.codec);
 
-			// get datestamp of each source file
-			stringlist srcFiles;
-			bool missingSrcFile = false;
-			int idx = 0;
-			u64 earliestSourceDateStamp = 0;
+	// the file system writes to a temp file and renames it into place, so a half written asset is never seen
+	if (!FileManager::Instance().Write(path, assetBlock))
+	{
+		// non fatal error, since the asset was converted ok, we just can't write it
+		Error(std::format("Error trying to write asset to path: {}\nCheck disk space and permissions.", path));
+	}
+	m_manifest.UpdateFile(path);
+	if (write.cacheKey)
+		m_derivedDataCache.Write(write.cacheKey, write.ext, assetBlock);
 
-			for (auto& srcExt : assetTypeInfo->sourceExt)
-			{
-				u64 srcDateStamp;
-				int ext = GetTime(string("src:") + name, srcExt.first, srcDateStamp);
-				srcFiles.push_back((ext == -1) ? "" : string("src:") + name + srcExt.first[ext]);
-				if (srcDateStamp > 0 && (idx == 0 || srcDateStamp < earliestSourceDateStamp))
-					earliestSourceDateStamp = srcDateStamp;
-
-				// if this is a non-optional source file and it wasn't found, then we can't convert the asset
-				if (srcExt.second && (ext == -1 || srcDateStamp == 0))
-				{
-					LOG(Asset, std::format("Asset '{}' [{}] missing src file {}", name, assetType, idx));
-					missingSrcFile = true;
-				}
-				idx++;
-			}
+	// the file is in place now - unless newer data was queued while we were writing
+	ScopedMutexLock lock(m_pendingWritesLock);
+	auto it = m_pendingWrites.find(path);
+	if (it != m_pendingWrites.end() && it->second.serial == write.serial)
+		m_pendingWrites.erase(it);
+}
 
-			// missing at least one non-optional source file
-			if (missingSrcFile)
-			{
-				Error("Asset conversion aborted due to missing source files!");
-				cb(nullptr);
-				return;
-			}
+bool AssetManager::FindPendingWrite(const string& path, MemBlock& serializedBlock)
+{
+	ScopedMutexLock lock(m_pendingWritesLock);
+	auto it = m_pendingWrites.find(path);
+	if (it == m_pendingWrites.end())
+		return false;
+
+	if (it->second.compressed)
+		return it->second.block.DecompressTo(serializedBlock);
+	it->second.block.CopyTo(serializedBlock);
+	return true;
+}
 
-			// if asset is newer than source files, just load and createFromData
-			AssetData* assetData = assetTypeInfo->assetCreator();
-			if (assetDateStamp > earliestSourceDateStamp)
+int AssetPriorityFromHint(f32 distance, bool visible)
+{
+	int priority = visible ? AssetPriority_Visible : AssetPriority_Normal;
+	return priority - (int)Clamp(distance, 0.0f, (f32)(AssetPriority_Normal - 1));
+}
+
+AssetRequestHandle AssetManager::DeliverAssetDataAsync(const string &assetType, const string& name, AssetCreateParams* params, const DeliverAssetDataCB& cb, int priority)
+{
+	Assert(m_assetTypeInfoMap.contains(assetType), std::format("Cannot create asset: {} - unregistered asset type: {}", name, assetType));
+
+	u64 key = params ? 0 : StringHash64(assetType + ":" + name);
+	{
+		ScopedMutexLock lock(m_requestLock);
+
+		// the resource was released & created again before its asset arrived - pick up the cancelled request where it is
+		auto it = key ? m_requestsByKey.find(key) : m_requestsByKey.end();
+		if (it != m_requestsByKey.end() && it->second->cancelled && !it->second->delivering)
+		{
+			auto request = it->second;
+			LOG(Asset, STR(">> Resume Asset: {} [{}]", name, assetType));
+			request->cb = cb;
+			request->cancelled = false;
+			if (!request->launched)
+				m_queuedRequests.erase(request);
+			request->priority = priority;
+			if (!request->launched)
+				m_queuedRequests.insert(request);
+			return request->handle;
+		}
+	}
+
+	auto request = new AssetRequest;
+	request->key = key;
+	request->priority = priority;
+	request->type = assetType;
+	request->name = name;
+	request->assetTypeInfo = m_assetTypeInfoMap[assetType];
+	request->params = params;
+	request->cb = cb;
+	request->assetDataPath = string("data:") + name + request->assetTypeInfo->assetExt;
+
+	AssetRequestHandle handle;
+	{
+		ScopedMutexLock lock(m_requestLock);
+		handle = request->handle = m_nextRequestHandle++;
+		request->order = m_nextRequestOrder++;
+		request->epoch = m_requestEpoch;
+		m_requests[handle] = request;
+		auto it = key ? m_requestsByKey.find(key) : m_requestsByKey.end();
+		if (it != m_requestsByKey.end() && !it->second->cancelled)
+		{
+			// the same asset is already on its way - wait for it rather than loading it twice
+			auto leader = it->second;
+			LOG(Asset, STR(">> Follow Asset: {} [{}]", name, assetType));
+			request->leader = leader;
+			leader->followers.push_back(request);
+			if (!leader->launched && leader->priority < priority)
 			{
-				MemBlock assetBlock;
-				LOG(Asset, STR("  deliver {} [{}] from asset data", name, assetType));
-				
-				if (!fm.Read(assetDataPath, assetBlock))
-				{
-					Error(std::format("Failed to read asset data file: {}\nTry deleting that file and run again.", assetDataPath));
-					cb(nullptr);
-					return;
-				}
-				MemBlock serializedBlock;
-				assetBlock.DecompressTo(serializedBlock);
-
-				// create from data
-				// this can return nullptr if version is old
-				if (assetData->MemoryToAsset(serializedBlock))
-				{
-					LOG(Asset, STR("Deliver Asset: {}", name));
-					cb(assetData);
-					return;
-				}
+				m_queuedRequests.erase(leader);
+				leader->priority = priority;
+				m_queuedRequests.insert(leader);
 			}
+			return handle;
+		}
+		if (key && it == m_requestsByKey.end())
+			m_requestsByKey[key] = request;
+		m_queuedRequests.insert(request);
+	}
+	LaunchQueuedRequests();
+	return handle;
+}
+
+void AssetManager::SetRequestPriority(AssetRequestHandle handle, int priority)
+{
+	ScopedMutexLock lock(m_requestLock);
+	auto it = m_requests.find(handle);
+	if (it == m_requests.end() || it->second->priority == priority)
+		return;
+
+	// the set is ordered by priority, so take the request out while it changes
+	auto request = it->second;
+	bool queued = !request->launched && !request->leader;
+	if (queued)
+		m_queuedRequests.erase(request);
+	request->priority = priority;
+	if (queued)
+		m_queuedRequests.insert(request);
+}
+
+void AssetManager::CancelRequest(AssetRequestHandle handle)
+{
+	m_requestLock.Lock();
+	auto it = m_requests.find(handle);
+	if (it != m_requests.end())
+	{
+		auto request = it->second;
+		if (!request->launched)
+		{
+			// still queued, so nothing else knows about it
+			LOG(Asset, STR("<< Cancel Asset: {} [{}]", request->name, request->type));
+			if (request->leader)
+				std::erase(request->leader->followers, request);
+			else
+				m_queuedRequests.erase(request);
+			ForgetRequest(request);
+			ReleaseFollowers(request);
+			delete request;
+		}
+		else
+		{
+			// launched - the pipeline drops it at the next stage
+			request->cancelled = true;
+		}
+	}
+
+	// the callback may be running right now - wait for it so the caller can free anything the callback uses
+	while (IsDeliveringOnOtherThread(handle))
+	{
+		m_requestLock.Release();
+		std::this_thread::yield();
+		m_requestLock.Lock();
+	}
+	m_requestLock.Release();
+}
+
+bool AssetManager::IsDeliveringOnOtherThread(AssetRequestHandle handle)
+{
+	// NOTE: assume the caller has locked m_requestLock
+	auto it = m_requests.find(handle);
+	return it != m_requests.end() && it->second->delivering && it->second->deliveringThread != Thread::CurrentThreadID();
+}
 
-			// didn't return assetData, so try building an asset from source
-			// first we load each src file into an array of memblocks
-			vector<MemBlock> srcFileMem;
-			for (auto &src : srcFiles)
+void AssetManager::LaunchQueuedRequests()
+{
+	vector<AssetRequest*> launch;
+	{
+		ScopedMutexLock lock(m_requestLock);
+		while (!m_shuttingDown && !m_queuedRequests.empty() && m_requestsInFlight < m_maxRequestsInFlight)
+		{
+			auto request = *m_queuedRequests.begin();
+			if (request->epoch != m_launchEpoch)
 			{
-				MemBlock memblock;
-				if (src.empty())
-				{
-					// just push an empty memblock - the asset creator should be prepared for these if it had optional src files
-					srcFileMem.emplace_back(memblock);
-				}
-				else
-				{
-					if (!fm.Read(src, memblock))
-					{
-						Error(std::format("Asset building error trying to load src: {}", src));
-						srcFiles.clear();
-						delete assetData;
-						cb(nullptr);
-						return;
-					}
-					srcFileMem.emplace_back(memblock);
-				}
+				// behind a barrier - wait until everything before it has been delivered
+				if (m_requestsInFlight > 0)
+					break;
+				m_launchEpoch = request->epoch;
 			}
+			m_queuedRequests.erase(m_queuedRequests.begin());
+			request->launched = true;
+			m_requestsInFlight++;
+			launch.push_back(request);
+		}
+	}
+
+	for (auto request : launch)
+	{
+		LOG(Asset, STR(">> Request Asset: {} [{}] priority {}", request->name, request->type, request->priority));
+		QueueStage(m_assetTasks, request, &AssetManager::StageRead);
+	}
+}
+
+void AssetManager::QueueStage(WorkerFarm& farm, AssetRequest* request, RequestStage stage)
+{
+	{
+		ScopedMutexLock lock(m_requestLock);
+		if (!m_shuttingDown && !request->cancelled)
+		{
+			farm.AddTask([this, request, stage]() { (this->*stage)(request); });
+			return;
+		}
+		ForgetRequest(request);
+	}
+	RetireRequest(request);
+}
+
+bool AssetManager::AcquireDecodeSlot(AssetRequest* request)
+{
+	if (m_shuttingDown)
+		return false;
+
+	m_decodeSlots.Wait();
+	if (m_shuttingDown)
+	{
+		// pass the wake up on to the next waiting reader
+		m_decodeSlots.Signal();
+		return false;
+	}
+	request->holdsDecodeSlot = true;
+	return true;
+}
+
+void AssetManager::ReleaseDecodeSlot(AssetRequest* request)
+{
+	if (request->holdsDecodeSlot)
+	{
+		request->holdsDecodeSlot = false;
+		m_decodeSlots.Signal();
+	}
+}
+
+void AssetManager::StageRead(AssetRequest* request)
+{
+	if (RetireIfCancelled(request))
+		return;
+
+	auto assetTypeInfo = request->assetTypeInfo;
+
+	// a freshly converted copy may still be waiting to be written out
+	if (FindPendingWrite(request->assetDataPath, request->block))
+	{
+		LOG(Asset, STR("  deliver {} [{}] from pending write", request->name, request->type));
+		request->blockCompressed = false;
+		QueueStage(m_decodeTasks, request, &AssetManager::StageDecode);
+		return;
+	}
 
-			// now create the AssetData from the src files
-			LOG(Asset, STR("  deliver {} [{}] from src files", name, assetType));
-			assetData->name = name;
-			assetData->type = assetType;
-			assetData->SrcFilesToAsset(srcFileMem, params);
-
-			// write out the asset to then data folder
-			// write the texture asset to data
-			MemBlock serializedBlock = assetData->AssetToMemory();
-			MemBlock assetBlock;
-			serializedBlock.CompressTo(assetBlock);
-			if (!fm.Write(assetDataPath, assetBlock))
+	// find which source files exist and when everything was last written
+	m_manifest.Lookup(assetTypeInfo, request->name, request->fileInfo);
+
+	// missing at least one non-optional source file, so we can't convert the asset
+	if (request->fileInfo.missingSrcFile)
+	{
+		for (int idx = 0; idx < (int)assetTypeInfo->sourceExt.size(); idx++)
+		{
+			if (assetTypeInfo->sourceExt[idx].second && request->fileInfo.srcFiles[idx].empty())
+				LOG(Asset, std::format("Asset '{}' [{}] missing src file {}", request->name, request->type, idx));
+		}
+		Error("Asset conversion aborted due to missing source files!");
+		FinishRequest(request, nullptr);
+		return;
+	}
+
+	// if asset is newer than source files, just load it and decode it on the decode threads
+	if (!request->fileInfo.IsDataUpToDate())
+	{
+		StageReadSources(request);
+		return;
+	}
+
+	if (!AcquireDecodeSlot(request))
+	{
+		RetireRequest(request);
+		return;
+	}
+
+	LOG(Asset, STR("  deliver {} [{}] from asset data", request->name, request->type));
+	if (!FileManager::Instance().Read(request->assetDataPath, request->block))
+	{
+		Error(std::format("Failed to read asset data file: {}\nTry deleting that file and run again.", request->assetDataPath));
+		FinishRequest(request, nullptr);
+		return;
+	}
+	request->blockCompressed = true;
+	QueueStage(m_decodeTasks, request, &AssetManager::StageDecode);
+}
+
+void AssetManager::StageDecode(AssetRequest* request)
+{
+	if (RetireIfCancelled(request))
+		return;
+
+	MemBlock serializedBlock;
+	if (request->blockCompressed)
+	{
+		// a corrupt data file is rebuilt from source, the same as an out of date one
+		if (!request->block.DecompressTo(serializedBlock))
+			serializedBlock = MemBlock();
+	}
+	else
+		serializedBlock = std::move(request->block);
+	request->block = MemBlock();
+
+	// create from data
+	// this can fail if version is old
+	AssetData* assetData = request->assetTypeInfo->assetCreator();
+	if (assetData->MemoryToAssetInPlace(std::move(serializedBlock)))
+	{
+		FinishRequest(request, assetData);
+		return;
+	}
+	delete assetData;
+
+	// go back to the read threads for the source files
+	ReleaseDecodeSlot(request);
+	QueueStage(m_assetTasks, request, &AssetManager::StageReadSources);
+}
+
+void AssetManager::StageReadSources(AssetRequest* request)
+{
+	if (RetireIfCancelled(request))
+		return;
+
+	if (!AcquireDecodeSlot(request))
+	{
+		RetireRequest(request);
+		return;
+	}
+
+	// load each src file into an array of memblocks
+	auto& fm = FileManager::Instance();
+	request->srcFileMem.clear();
+	for (auto& src : request->fileInfo.srcFiles)
+	{
+		MemBlock memblock;
+		if (!src.empty() && !fm.Read(src, memblock))
+		{
+			Error(std::format("Asset building error trying to load src: {}", src));
+			FinishRequest(request, nullptr);
+			return;
+		}
+
+		// missing optional src files get an empty memblock - the asset creator should be prepared for these
+		request->srcFileMem.emplace_back(std::move(memblock));
+	}
+	QueueStage(m_decodeTasks, request, &AssetManager::StageConvert);
+}
+
+void AssetManager::StageConvert(AssetRequest* request)
+{
+	if (RetireIfCancelled(request))
+		return;
+
+	auto assetTypeInfo = request->assetTypeInfo;
+	AssetData* assetData = assetTypeInfo->assetCreator();
+
+	// the data file is missing or out of date, but these exact sources may have been converted before
+	u64 cacheKey = 0;
+	if (m_derivedDataCache.IsEnabled())
+	{
+		cacheKey = DerivedDataCache::MakeKey(assetTypeInfo, request->name, request->fileInfo.srcFiles, request->srcFileMem, request->params);
+		MemBlock assetBlock;
+		if (m_derivedDataCache.Read(cacheKey, assetTypeInfo->assetExt, assetBlock))
+		{
+			MemBlock serializedBlock;
+			if (assetBlock.DecompressTo(serializedBlock) && assetData->MemoryToAssetInPlace(std::move(serializedBlock)))
 			{
-				// non fatal error, since we have converted the asset ok, we just can't write it
-				Error(std::format("Error trying to write asset to path: {}\nCheck disk space and permissions.", assetDataPath));
+				LOG(Asset, STR("  deliver {} [{}] from derived data cache {:016x}", request->name, request->type, cacheKey));
+
+				// refresh the data file so the next load takes the fast path
+				PendingWrite write;
+				write.block = std::move(assetBlock);
+				write.compressed = true;
+				QueueWrite(request->assetDataPath, std::move(write));
+
+				FinishRequest(request, assetData);
+				return;
 			}
+		}
+	}
+
+	// now create the AssetData from the src files
+	LOG(Asset, STR("  deliver {} [{}] from src files", request->name, request->type));
+	assetData->name = request->name;
+	assetData->type = request->type;
+	assetData->SrcFilesToAsset(request->srcFileMem, request->params);
+
+	// compress & write the asset out to the data folder in the background - the resource doesn't need to wait for the disk
+	PendingWrite write;
+	write.block = assetData->AssetToMemory();
+	write.codec = assetTypeInfo->codec;
+	write.ext = assetTypeInfo->assetExt;
+	write.cacheKey = cacheKey;
+	QueueWrite(request->assetDataPath, std::move(write));
+
+	FinishRequest(request, assetData);
+}
+
+void AssetManager::FinishRequest(AssetRequest* request, AssetData* assetData)
+{
+	// free the decode slot before the callback, so the next read can start while the resource takes its delivery
+	ReleaseDecodeSlot(request);
+
+	// data read back from data: only has what was serialized - the residency policy needs to know what it is
+	if (assetData)
+	{
+		assetData->type = request->type;
+		assetData->name = request->name;
+	}
+
+	DeliverAssetDataCB cb;
+	{
+		ScopedMutexLock lock(m_requestLock);
+		if (request->cancelled)
+		{
+			ForgetRequest(request);
+		}
+		else
+		{
+			request->delivering = true;
+			request->deliveringThread = Thread::CurrentThreadID();
+			cb = request->cb;
+		}
+	}
+
+	if (cb)
+	{
+		if (assetData)
+			LOG(Asset, STR("Deliver Asset: {}", request->name));
+		cb(assetData);
+	}
+	else
+	{
+		LOG(Asset, STR("<< Cancel Asset: {} [{}]", request->name, request->type));
+		delete assetData;
+	}
+	RetireRequest(request);
+}
+
+bool AssetManager::RetireIfCancelled(AssetRequest* request)
+{
+	{
+		ScopedMutexLock lock(m_requestLock);
+		if (!m_shuttingDown && !request->cancelled)
+			return false;
+		ForgetRequest(request);
+	}
+	RetireRequest(request);
+	return true;
+}
+
+void AssetManager::RetireRequest(AssetRequest* request)
+{
+	ReleaseDecodeSlot(request);
+	{
+		ScopedMutexLock lock(m_requestLock);
+		ForgetRequest(request);
+		ReleaseFollowers(request);
+		if (--m_requestsInFlight == 0 && m_shuttingDown)
+			m_requestsDrained.Signal();
+	}
+	delete request;
+
+	// room in the pipeline for the next queued request
+	LaunchQueuedRequests();
+}
+
+void AssetManager::ForgetRequest(AssetRequest* request)
+{
+	// NOTE: assume the caller has locked m_requestLock
+	m_requests.erase(request->handle);
+	auto it = m_requestsByKey.find(request->key);
+	if (it != m_requestsByKey.end() && it->second == request)
+		m_requestsByKey.erase(it);
+}
 
-			// finally we can deliver the asset back to the resource
-			LOG(Asset, STR("Deliver Asset: {}", name));
-			cb(assetData);
+void AssetManager::ReleaseFollowers(AssetRequest* request)
+{
+	// NOTE: assume the caller has locked m_requestLock
+	for (auto follower : request->followers)
+	{
+		follower->leader = nullptr;
+		if (m_shuttingDown)
+		{
+			ForgetRequest(follower);
+			delete follower;
+			continue;
 		}
-	);
+
+		// back in the queue - the asset is written by now so it takes the quick path
+		// the first takes over the key so anyone later follows it instead
+		if (follower->key && !m_requestsByKey.contains(follower->key))
+			m_requestsByKey[follower->key] = follower;
+		m_queuedRequests.insert(follower);
+	}
+	request->followers.clear();
 }
 
 AssetTypeInfo* AssetManager::FindAssetTypeInfo(const string &type)
@@ -162,8 +638,72 @@ AssetTypeInfo* AssetManager::FindAssetTypeInfo(const string &type)
 	return (it != m_assetTypeInfoMap.end()) ? it->second : nullptr;
 }
 
+void AssetManager::GetAssetFileInfo(const string& type, const stringlist& names, vector<AssetFileInfo>& infos)
+{
+	auto assetTypeInfo = FindAssetTypeInfo(type);
+	Assert(assetTypeInfo, std::format("Cannot get asset file info - unregistered asset type: {}", type));
+	m_manifest.Lookup(assetTypeInfo, names, infos);
+}
+
+void AssetManager::ApplyResidency(AssetData* assetData)
+{
+	auto assetTypeInfo = assetData ? FindAssetTypeInfo(assetData->type) : nullptr;
+	if (!assetTypeInfo || assetTypeInfo->residency != AssetResidency_ReleaseAfterUpload || assetData->bulkDataReleased || CLV_KeepAssetData.Value())
+		return;
+
+	u64 released = assetData->ReleaseBulkData();
+	assetData->bulkDataReleased = true;
+	gMemoryTracker.RecordResidencyRelease(assetTypeInfo->memoryGroup, released);
+	LOG(Asset, STR("Released {} bytes of {} [{}] after upload", released, assetData->name, assetData->type));
+}
+
+bool AssetManager::RestoreBulkData(AssetData* assetData)
+{
+	ScopedMutexLock lock(m_restoreLock);
+	if (!assetData->bulkDataReleased)
+		return true;
+
+	auto assetTypeInfo = FindAssetTypeInfo(assetData->type);
+	Assert(assetTypeInfo, std::format("Cannot restore asset data: {} - unregistered asset type: {}", assetData->name, assetData->type));
+
+	// the data file was written when the asset was converted, or may still be waiting to be written
+	string assetDataPath = string("data:") + assetData->name + assetTypeInfo->assetExt;
+	MemBlock serializedBlock;
+	if (!FindPendingWrite(assetDataPath, serializedBlock))
+	{
+		MemBlock assetBlock;
+		if (!FileManager::Instance().Read(assetDataPath, assetBlock))
+		{
+			Error(std::format("Failed to restore asset data from: {}", assetDataPath));
+			return false;
+		}
+		if (!assetBlock.DecompressTo(serializedBlock))
+			return false;
+	}
+
+	AssetData* loaded = assetTypeInfo->assetCreator();
+	bool ok = loaded->MemoryToAssetInPlace(std::move(serializedBlock));
+	if (ok)
+	{
+		u64 restored = assetData->RestoreBulkData(loaded);
+		assetData->bulkDataReleased = false;
+		gMemoryTracker.RecordResidencyRestore(assetTypeInfo->memoryGroup, restored);
+		LOG(Asset, STR("Restored {} bytes of {} [{}]", restored, assetData->name, assetData->type));
+	}
+	delete loaded;
+	return ok;
+}
+
+void AssetManager::RestoreBulkDataAsync(AssetData* assetData, const std::function<void(bool)>& cb)
+{
+	m_assetTasks.AddTask([this, assetData, cb]() { cb(RestoreBulkData(assetData)); });
+}
+
 void AssetManager::AddBarrier()
 {
-	m_assetTasks.AddBarrier();
+	// requests made after this wait until every earlier request has been delivered
+	ScopedMutexLock lock(m_requestLock);
+	if (m_requestsInFlight > 0 || !m_queuedRequests.empty())
+		m_requestEpoch++;
 }
 
@@ -4,6 +4,8 @@
 #include "Thread.h"
 #include "MemBlock.h"
 #include "Serializer.h"
+#include "DerivedDataCache.h"
+#include "AssetManifest.h"
 
 struct AssetData
 {
@@ -16,7 +18,22 @@ struct AssetData
 
 	virtual MemBlock AssetToMemory() = 0;
 	virtual bool MemoryToAsset(const MemBlock& block) = 0;
+	// same, but the asset may keep the block and point into it rather than copying out of it
+	virtual bool MemoryToAssetInPlace(MemBlock&& block) { return MemoryToAsset(block); }
 	virtual bool SrcFilesToAsset(vector<MemBlock>& srcBlocks, struct AssetCreateParams* params) = 0;
+
+	// residency - free the large cpu side data once it's been uploaded, and take it back from a freshly loaded copy
+	// both return the number of bytes freed or taken back
+	virtual u64 ReleaseBulkData() { return 0; }
+	virtual u64 RestoreBulkData(AssetData* loaded) { return 0; }
+	bool bulkDataReleased = false;
+};
+
+// what happens to an asset's cpu side data once its platform data has been created
+enum AssetResidency
+{
+	AssetResidency_Keep,				// keep everything for the life of the resource
+	AssetResidency_ReleaseAfterUpload,	// free the bulk data - AssetManager::RestoreBulkData loads it back from data: if needed
 };
 
 // derive options asset creation params off this
@@ -25,7 +42,10 @@ struct AssetData
 struct AssetCreateParams
 {
 public:
-	~AssetCreateParams() {}
+	virtual ~AssetCreateParams() {}
+
+	// hash of every param that changes the converted data - part of the derived data cache key
+	virtual u64 Hash() const { return 0; }
 };
 
 // asset type info creates all the functions and data needed to create this asset type
@@ -43,39 +63,202 @@ struct AssetTypeInfo
 	// list of extensions for source files
 	// some source files could be one of many extensions (ie.  png, tga, jpg)
 	vector<std::pair<stringlist,bool>> sourceExt;
+
+	// codec for the converted asset data - LZ is much faster to load, Zlib packs smaller
+	MemBlockCodecType codec = MemBlockCodec_Zlib;
+
+	// converter version (the asset's *_VERSION define) - bumping it invalidates the derived data cache for this type
+	u16 version = 0;
+
+	// cpu side data policy once uploaded, and the memory group released data is accounted against
+	AssetResidency residency = AssetResidency_Keep;
+	MemoryGroup memoryGroup = MemoryGroup_General;
 };
 
 // callback when resource data has been finally loaded
 typedef std::function<void(AssetData*)> DeliverAssetDataCB;
 
+// identifies an asset request so it can be re-prioritized or cancelled - 0 is never a valid handle
+typedef u64 AssetRequestHandle;
+
+// load priority of an asset request - higher priorities are loaded first
+enum AssetPriority
+{
+	AssetPriority_Background = 0,		// prefetch - nothing is waiting on it yet
+	AssetPriority_Normal = 1000,
+	AssetPriority_Visible = 2000,		// on screen now
+	AssetPriority_Critical = 3000,		// nothing can draw without it
+};
+
+// priority from a streaming hint - visible assets first, then nearest first
+int AssetPriorityFromHint(f32 distance, bool visible);
+
 class AssetManager : public Module<AssetManager>
 {
-	// asset delivery thread can handle a maximum number of tasks at once
+	// assets load through a pipeline, each stage with its own threads so different assets overlap:
+	//   read   (m_assetTasks)  - file i/o, a few threads
+	//   decode (m_decodeTasks) - decompress & deserialize, or convert from source - a thread per core
+	//   create (render thread) - platform creation queued by the resource's deliver callback
+	// a read must take a decode slot first, so a slow decode stage holds reads back rather than filling memory
 	WorkerFarm m_assetTasks;
+	WorkerFarm m_decodeTasks;
+	Semaphore m_decodeSlots;
+
+	// an asset request as it waits in the queue and moves through the pipeline
+	struct AssetRequest
+	{
+		AssetRequestHandle handle = 0;
+		u64 key = 0;					// type & name - requests with create params aren't shared, so have no key
+		int priority = AssetPriority_Normal;
+		u64 epoch = 0;					// barriers passed before this request was made
+		u64 order = 0;					// requests of the same priority launch in the order they were made
+		bool launched = false;			// has left the queue and entered the pipeline
+		std::atomic<bool> cancelled = false;
+		bool delivering = false;		// the callback is running right now, on deliveringThread
+		ThreadID deliveringThread;
+
+		string type;
+		string name;
+		AssetTypeInfo* assetTypeInfo;
+		AssetCreateParams* params;
+		DeliverAssetDataCB cb;
+		string assetDataPath;
+		AssetFileInfo fileInfo;
+		MemBlock block;					// data read for the decode stage
+		bool blockCompressed = false;
+		vector<MemBlock> srcFileMem;	// source files read for conversion
+		bool holdsDecodeSlot = false;
+
+		// later requests for the same key wait on the one in flight rather than converting it again
+		// they're queued when it retires, and find its data written by then
+		AssetRequest* leader = nullptr;
+		vector<AssetRequest*> followers;
+	};
+
+	// queued requests launch in order of barrier epoch, then priority, then age
+	struct AssetRequestOrder
+	{
+		bool operator()(const AssetRequest* a, const AssetRequest* b) const
+		{
+			if (a->epoch != b->epoch)
+				return a->epoch < b->epoch;
+			if (a->priority != b->priority)
+				return a->priority > b->priority;
+			return a->order < b->order;
+		}
+	};
+
+	// only a few requests are in the pipeline at once, the rest wait here so a higher priority request can overtake them
+	// a barrier bumps the epoch - requests of a later epoch wait until every earlier request has been delivered
+	Mutex m_requestLock;
+	std::set<AssetRequest*, AssetRequestOrder> m_queuedRequests;
+	hashtable<AssetRequestHandle, AssetRequest*> m_requests;	// every queued or launched request
+	hashtable<u64, AssetRequest*> m_requestsByKey;
+	AssetRequestHandle m_nextRequestHandle = 1;
+	u64 m_nextRequestOrder = 0;
+	u64 m_requestEpoch = 0;
+	u64 m_launchEpoch = 0;
+	int m_requestsInFlight = 0;
+	int m_maxRequestsInFlight;
+	std::atomic<bool> m_shuttingDown = false;
+	Semaphore m_requestsDrained;		// signalled when the last launched request retires during shutdown
+
+	typedef void (AssetManager::*RequestStage)(AssetRequest*);
+	void LaunchQueuedRequests();
+	void QueueStage(WorkerFarm& farm, AssetRequest* request, RequestStage stage);
+	bool AcquireDecodeSlot(AssetRequest* request);
+	void ReleaseDecodeSlot(AssetRequest* request);
+	void StageRead(AssetRequest* request);
+	void StageReadSources(AssetRequest* request);
+	void StageDecode(AssetRequest* request);
+	void StageConvert(AssetRequest* request);
+	void FinishRequest(AssetRequest* request, AssetData* assetData);
+	bool RetireIfCancelled(AssetRequest* request);
+	void RetireRequest(AssetRequest* request);
+	void ForgetRequest(AssetRequest* request);
+	void ReleaseFollowers(AssetRequest* request);
+	bool IsDeliveringOnOtherThread(AssetRequestHandle handle);
 
 	// map of asset type creators
 	hashtable<string, AssetTypeInfo*> m_assetTypeInfoMap;
 
+	// converted assets keyed by the content of their source files
+	DerivedDataCache m_derivedDataCache;
+
+	// write times of all data: & src: files, for deciding if an asset needs converting
+	AssetManifest m_manifest;
+
+	// converted assets waiting to be compressed & written out in the background, keyed by data path
+	// writing the same path again before it hits the disk just replaces the queued data
+	// an entry stays here until its data is on disk, so loads never miss a file that's still being written
+	struct PendingWrite
+	{
+		MemBlock block;
+		bool compressed = false;		// block is already compressed (ie. came from the derived data cache)
+		MemBlockCodecType codec = MemBlockCodec_Zlib;
+		string ext;
+		u64 cacheKey = 0;				// also store in the derived data cache if non zero
+		u32 serial = 0;					// which queued write this is - a newer write replaces the entry while an older one is on disk
+		bool taskQueued = false;		// a writer task is waiting to pick this entry up
+	};
+	WorkerThread m_assetWriter;
+	Mutex m_pendingWritesLock;
+	hashtable<string, PendingWrite> m_pendingWrites;
+	u32 m_pendingWriteSerial = 0;
+	bool m_writerStopped = false;		// shut down - writes are done on the calling thread
+
+	Mutex m_restoreLock;				// two reloads of the same asset can't restore it at once
+
+	void QueueWrite(const string& path, PendingWrite&& write);
+	void ProcessWrite(const string& path);
+	bool FindPendingWrite(const string& path, MemBlock& serializedBlock);
+
 public:
 	AssetManager();
 
-	// start worker farm
+	// start the pipeline threads
 	void StartWork();
 
-	// add barrier to ensure all previous assets complete before others start
+	// add barrier to ensure all previous assets are delivered before others start
 	// this is important for renderPasses to complete first since they must create all the render targets before materials try to access them
 	// if a material runs first, it will try to load the texture since it didn't find the render target
 	void AddBarrier();
 
-	// kill the worker farm
+	// kill the pipeline threads, then flush any asset writes still queued
 	void KillWorkerFarm();
 
+	// block until all queued asset writes are on disk
+	void FlushWrites();
+
+	// converters can keep their own intermediate data here, keyed on the source bytes
+	DerivedDataCache& GetDerivedDataCache() { return m_derivedDataCache; }
+
 	// register an asset type that can be delivered
 	void RegisterAssetType(AssetTypeInfo* assetCreator) { m_assetTypeInfoMap[assetCreator->name] = assetCreator; }
 
 	// gather all data from file systems
-	void DeliverAssetDataAsync(const string &type, const string &name, AssetCreateParams* params, const DeliverAssetDataCB& cb);
+	// a request for an asset whose earlier request was cancelled takes over that request, rather than starting again
+	AssetRequestHandle DeliverAssetDataAsync(const string &type, const string &name, AssetCreateParams* params, const DeliverAssetDataCB& cb, int priority = AssetPriority_Normal);
+
+	// change the priority of a request - only has an effect while it's still queued
+	void SetRequestPriority(AssetRequestHandle handle, int priority);
+
+	// the callback won't be called once this returns - if it is running on another thread, this waits for it to finish
+	// does nothing if the request has already been delivered
+	void CancelRequest(AssetRequestHandle handle);
 
 	// get registered asset type info for a specified type
 	AssetTypeInfo *FindAssetTypeInfo(const string& type);
+
+	// call once the platform data has been created - frees the cpu side bulk data if the asset type's residency policy allows it
+	void ApplyResidency(AssetData* assetData);
+
+	// load released bulk data back in from data: (ie. for readback or tools) - blocks until it's read
+	bool RestoreBulkData(AssetData* assetData);
+
+	// same, but the read runs on an asset worker - cb is called from that worker, with false if the data couldn't be brought back
+	void RestoreBulkDataAsync(AssetData* assetData, const std::function<void(bool)>& cb);
+
+	// which source files exist for a list of assets, and if their data files are up to date - answered from memory
+	void GetAssetFileInfo(const string& type, const stringlist& names, vector<AssetFileInfo>& infos);
 };
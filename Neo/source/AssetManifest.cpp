@@ -0,0 +1,111 @@
+#include "Neo.h"
+#include "AssetManifest.h"
+#include "AssetManager.h"
+#include "FileManager.h"
+#include "StringUtils.h"
+#include "TimeManager.h"
+
+hashtable<u64, u64>* AssetManifest::FindTimes(const string& fsName)
+{
+	if (fsName == "data")
+		return &m_dataTimes;
+	if (fsName == "src")
+		return &m_srcTimes;
+	return nullptr;
+}
+
+void AssetManifest::BuildIfNeeded()
+{
+	if (m_built)
+		return;
+
+	double startTime = NeoTimeNow;
+	auto& fm = FileManager::Instance();
+	for (auto fsName : { "data", "src" })
+	{
+		vector<std::pair<string, u64>> times;
+		fm.GetFileTimes(fsName, times);
+
+		auto table = FindTimes(fsName);
+		table->clear();
+		table->reserve(times.size());
+		for (auto& it : times)
+		{
+			if (it.second)
+				(*table)[StringHash64(it.first)] = it.second;
+		}
+	}
+	m_built = true;
+	LOG(Asset, STR("Asset manifest: {} data files, {} src files in {:.1f}ms", m_dataTimes.size(), m_srcTimes.size(), (NeoTimeNow - startTime) * 1000.0));
+}
+
+void AssetManifest::LookupLocked(const AssetTypeInfo* assetTypeInfo, const string& name, AssetFileInfo& info)
+{
+	auto dataIt = m_dataTimes.find(StringHash64(name + assetTypeInfo->assetExt));
+	info.dataTime = (dataIt != m_dataTimes.end()) ? dataIt->second : 0;
+
+	// each source slot takes the first of its extensions that exists
+	info.srcFiles.clear();
+	info.earliestSrcTime = 0;
+	info.missingSrcFile = false;
+	int idx = 0;
+	for (auto& srcExt : assetTypeInfo->sourceExt)
+	{
+		u64 srcTime = 0;
+		string srcFile;
+		for (auto& ext : srcExt.first)
+		{
+			auto srcIt = m_srcTimes.find(StringHash64(name + ext));
+			if (srcIt != m_srcTimes.end())
+			{
+				srcTime = srcIt->second;
+				srcFile = string("src:") + name + ext;
+				break;
+			}
+		}
+
+		if (srcTime > 0 && (idx == 0 || srcTime < info.earliestSrcTime))
+			info.earliestSrcTime = srcTime;
+		if (srcExt.second && srcTime == 0)
+			info.missingSrcFile = true;
+		info.srcFiles.push_back(std::move(srcFile));
+		idx++;
+	}
+}
+
+void AssetManifest::Lookup(const AssetTypeInfo* assetTypeInfo, const string& name, AssetFileInfo& info)
+{
+	ScopedMutexLock lock(m_lock);
+	BuildIfNeeded();
+	LookupLocked(assetTypeInfo, name, info);
+}
+
+void AssetManifest::Lookup(const AssetTypeInfo* assetTypeInfo, const stringlist& names, vector<AssetFileInfo>& infos)
+{
+	ScopedMutexLock lock(m_lock);
+	BuildIfNeeded();
+	infos.resize(names.size());
+	for (size_t i = 0; i < names.size(); i++)
+		LookupLocked(assetTypeInfo, names[i], infos[i]);
+}
+
+void AssetManifest::UpdateFile(const string& path)
+{
+	string fsName, name;
+	StringSplitIntoFSAndPath(path, fsName, name);
+
+	// ask the file system before taking the lock - it may be slow
+	u64 time = 0;
+	if (!FileManager::Instance().GetTime(path, time))
+		time = 0;
+
+	ScopedMutexLock lock(m_lock);
+	auto table = FindTimes(fsName);
+	if (!m_built || !table)
+		return;
+
+	if (time)
+		(*table)[StringHash64(name)] = time;
+	else
+		table->erase(StringHash64(name));
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+/**************************************************************************
+AssetManifest  -  in memory write times of every data: and src: file
+
+built in one bulk pass the first time it's needed, then kept up to date from
+file change notifications and the asset writer.  answers "which source files
+exist and is the data file newer" without going near the file systems.
+
+***************************************************************************/
+
+#include "Thread.h"
+
+struct AssetTypeInfo;
+
+// everything needed to decide how to deliver an asset
+struct AssetFileInfo
+{
+	u64 dataTime = 0;				// 0 if there is no data file
+	stringlist srcFiles;			// src: path for each source slot of the asset type, blank if none of its extensions exist
+	u64 earliestSrcTime = 0;
+	bool missingSrcFile = false;	// a non optional source slot has no file
+
+	bool IsDataUpToDate() const { return dataTime > earliestSrcTime; }
+};
+
+class AssetManifest
+{
+public:
+	// look up the files behind one asset, or a whole list of them under a single lock
+	void Lookup(const AssetTypeInfo* assetTypeInfo, const string& name, AssetFileInfo& info);
+	void Lookup(const AssetTypeInfo* assetTypeInfo, const stringlist& names, vector<AssetFileInfo>& infos);
+
+	// refresh a single file (ie. "data:brick.neotex") - removes it if it no longer exists
+	void UpdateFile(const string& path);
+
+protected:
+	void BuildIfNeeded();
+	void LookupLocked(const AssetTypeInfo* assetTypeInfo, const string& name, AssetFileInfo& info);
+	hashtable<u64, u64>* FindTimes(const string& fsName);
+
+	Mutex m_lock;
+	bool m_built = false;
+	hashtable<u64, u64> m_dataTimes;	// name hash -> write time
+	hashtable<u64, u64> m_srcTimes;
+};
@@ -6,7 +6,7 @@
 #include "ImmDynamicRenderer.h"
 #include <stb_image.h>
 
-#define BITMAPFONT_VERSION 1
+#define BITMAPFONT_VERSION 2
 
 CmdLineVar<bool> CLV_ShowFontBorders("showFontBorders", "draw a white border around font draw areas", false);
 
@@ -54,6 +54,7 @@ template <> ResourceFactory<BitmapFont>::ResourceFactory()
 	auto ati = new AssetTypeInfo();
 	ati->name = BitmapFont::AssetType;
 	ati->assetExt = ".neobmf";
+	ati->version = BITMAPFONT_VERSION;
 	ati->assetCreator = []() -> AssetData* { return new BitmapFontAssetData; };
 	ati->sourceExt.push_back({ { ".fnt", }, true });		// on of these src image files
 	AssetManager::Instance().RegisterAssetType(ati);
@@ -283,37 +284,79 @@ bool BitmapFontAssetData::SrcFilesToAsset(vector<MemBlock>& srcFiles, AssetCreat
 	return true;
 }
 
-MemBlock BitmapFontAssetData::AssetToMemory()
+static void WriteBitmapFont(BinaryWriter<>& stream, const BitmapFontAssetData& font)
 {
-	Serializer_BinaryWriteGrow stream;
-
-	stream << version << name;
+	stream.WriteU16(font.version);
+	stream.WriteString(font.name);
+	BitmapFontInfo_Write(stream, font.info);
+
+	stream.WriteU32((u32)font.pages.size());
+	for (auto& page : font.pages)
+		stream.WriteString(page.file);
+
+	// in id order, so the same font always gives the same bytes
+	vector<const BitmapFontChar*> chars;
+	chars.reserve(font.chars.size());
+	for (auto& it : font.chars)
+		chars.push_back(&it.second);
+	std::sort(chars.begin(), chars.end(), [](const BitmapFontChar* a, const BitmapFontChar* b) { return a->id < b->id; });
+
+	stream.WriteU32((u32)chars.size());
+	for (auto ch : chars)
+		BitmapFontChar_Write(stream, *ch);
+}
 
-	stream << info.face << info.charset << info.stretchH << info.bold << info.italic << info.unicode << info.smooth
-		   << info.aa << info.outline << info.packed << info.alphaChnl << info.padding << info.spacing << info.lineHeight
-		   << info.base << info.scaleW << info.scaleH << info.pages << info.redChnl << info.greenChnl << info.blueChnl;
+static bool ReadBitmapFont(BinaryReader<>& stream, BitmapFontAssetData& font)
+{
+	if (!BitmapFontInfo_Read(stream, font.info))
+		return false;
 
-	stream << (u32)pages.size();
-	for (auto& page : pages)
+	u32 count = stream.ReadU32();
+	font.pages.clear();
+	for (u32 i = 0; i < count && stream.IsGood(); i++)
 	{
-		stream << page.file;
+		BitmapFontAssetData::PageInfo page;
+		page.file = stream.ReadString();
+		font.pages.push_back(page);
 	}
 
-	stream << (u32)chars.size();
-	for (auto &it : chars)
+	count = stream.ReadU32();
+	font.chars.clear();
+	for (u32 i = 0; i < count; i++)
 	{
-		auto& ch = it.second;
-		stream << ch.id << ch.pos << ch.size << ch.offset << ch.xadvance << ch.page << ch.channel;
+		BitmapFontChar ch;
+		if (!BitmapFontChar_Read(stream, ch))
+			return false;
+		font.chars[ch.id] = ch;
 	}
+	return stream.IsGood();
+}
 
-	return MemBlock::CloneMem(stream.DataStart(), stream.DataSize());
+MemBlock BitmapFontAssetData::AssetToMemory()
+{
+	BinaryWriter<> stream;
+	WriteBitmapFont(stream, *this);
+
+#if defined(_DEBUG)
+	// round trip check for the generated serializers - reading the data back and writing it again must give the same bytes
+	BitmapFontAssetData check;
+	BinaryReader<> reader(stream.DataStart(), stream.DataSize());
+	check.version = reader.ReadU16();
+	check.name = reader.ReadString();
+	BinaryWriter<> rewrite;
+	if (ReadBitmapFont(reader, check))
+		WriteBitmapFont(rewrite, check);
+	Assert(rewrite.DataSize() == stream.DataSize() && memcmp(rewrite.DataStart(), stream.DataStart(), stream.DataSize()) == 0, STR("BitmapFont {} doesn't survive a serialize round trip", name));
+#endif
+
+	return stream.TakeBlock();
 }
 
 bool BitmapFontAssetData::MemoryToAsset(const MemBlock& block)
 {
-	Serializer_BinaryRead stream(block);
-
-	stream >> version >> name;
+	BinaryReader<> stream(block);
+	version = stream.ReadU16();
+	name = stream.ReadString();
 
 	if (version != BITMAPFONT_VERSION)
 	{
@@ -321,24 +364,10 @@ bool BitmapFontAssetData::MemoryToAsset(const MemBlock& block)
 		return false;
 	}
 
-	stream >> info.face >> info.charset >> info.stretchH >> info.bold >> info.italic >> info.unicode >> info.smooth
-		>> info.aa >> info.outline >> info.packed >> info.alphaChnl >> info.padding >> info.spacing >> info.lineHeight
-		>> info.base >> info.scaleW >> info.scaleH >> info.pages >> info.redChnl >> info.greenChnl >> info.blueChnl;
-
-	u32 size = stream.ReadU32();
-	pages.clear();
-	for (u32 i = 0; i < size; i++)
+	if (!ReadBitmapFont(stream, *this))
 	{
-		PageInfo page;
-		stream >> page.file;
-		pages.push_back(page);
-	}
-
-	size = stream.ReadU32();
-	for (auto& it : chars)
-	{
-		auto& ch = it.second;
-		stream << ch.id << ch.pos << ch.size << ch.offset << ch.xadvance << ch.page << ch.channel;
+		Error(STR("Corrupt bitmap font data: {}", name));
+		return false;
 	}
 	return true;
 }
@@ -24,6 +24,47 @@ enum Alignment
 };
 
 
+// font wide settings - reflected so the asset data uses the generated serializers
+//<REFLECT>
+struct BitmapFontInfo
+{
+	string face;
+	string charset;
+	i32 size = 0;
+	i32 stretchH = 0;
+	bool bold = false;
+	bool italic = false;
+	bool unicode = false;
+	bool smooth = false;
+	bool aa = false;
+	bool outline = false;
+	bool packed = false;
+	bool alphaChnl = false;
+	ivec4 padding{};
+	ivec2 spacing{};
+	i32 lineHeight = 0;
+	i32 base = 0;
+	i32 scaleW = 0;
+	i32 scaleH = 0;
+	i32 pages = 0;
+	i32 redChnl = 0;
+	i32 greenChnl = 0;
+	i32 blueChnl = 0;
+};
+
+// one glyph - all plain data, so the generated serializer copies it in one go
+//<REFLECT>
+struct BitmapFontChar
+{
+	i32 id = 0;
+	ivec2 pos{};
+	ivec2 size{};
+	ivec2 offset{};
+	i32 xadvance = 0;
+	i32 page = 0;
+	i32 channel = 0;
+};
+
 // Asset data is the file data for this asset
 // this class managed serializing to and from disk
 struct BitmapFontAssetData : public AssetData
@@ -31,31 +72,8 @@ struct BitmapFontAssetData : public AssetData
 public:
 	~BitmapFontAssetData() {}
 
-	struct FontInfo
-	{
-		string face;
-		string charset;
-		int size = 0;
-		int stretchH = 0;
-		bool bold = false;
-		bool italic = false;
-		bool unicode = false;
-		bool smooth = false;
-		bool aa = false;
-		bool outline = false;
-		bool packed = false;
-		bool alphaChnl = false;
-		ivec4 padding{};
-		ivec2 spacing{};
-		int lineHeight = 0;
-		int base = 0;
-		int scaleW = 0;
-		int scaleH = 0;
-		int pages = 0;
-		int redChnl = 0;
-		int greenChnl = 0;
-		int blueChnl = 0;
-	} info;
+	using FontInfo = BitmapFontInfo;
+	FontInfo info;
 
 	struct PageInfo
 	{
@@ -64,16 +82,7 @@ public:
 	};
 	vector<PageInfo> pages;
 
-	struct CharInfo
-	{
-		int id = 0;
-		ivec2 pos{};
-		ivec2 size{};
-		ivec2 offset{};
-		int xadvance = 0;
-		int page = 0;
-		int channel = 0;
-	};
+	using CharInfo = BitmapFontChar;
 	hashtable<u32, CharInfo> chars;
 
 	virtual MemBlock AssetToMemory() override;
@@ -32,6 +32,7 @@ void DefDynamicRenderer::BeginFrame()
 	m_renderBlocks[m_updateFrame].clear();
 	m_cmds[m_updateFrame].clear();
 	m_materials[m_updateFrame].clear();
+	m_materialHandles[m_updateFrame].clear();
 }
 
 void DefDynamicRenderer::BeginRender(u32 drawOrder)
@@ -50,6 +51,7 @@ void DefDynamicRenderer::UseMaterial(Material* mat)
 	cmd.cmdData = (u32)m_materials[m_updateFrame].size();
 	m_cmds[m_updateFrame].emplace_back(cmd);
 	m_materials[m_updateFrame].emplace_back(MaterialRef(mat));
+	m_materialHandles[m_updateFrame].push_back(mat ? mat->GetHandle() : 0);
 }
 
 void DefDynamicRenderer::StartPrimitive(PrimType primType)
@@ -151,7 +153,7 @@ void DefDynamicRenderer::Render(u32 endDrawOrder)
 			switch (cmd.cmdType)
 			{
 				case CmdType_SetMaterial:
-					gil.BindMaterial(m_materials[m_drawFrame][cmd.cmdData], lines);
+					gil.BindMaterial(m_materialHandles[m_drawFrame][cmd.cmdData], lines);
 					break;
 				case CmdType_SetPrimType:
 					gil.SetRenderPrimitiveType((PrimType)cmd.cmdData);
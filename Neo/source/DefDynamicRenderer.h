@@ -35,7 +35,8 @@ class DefDynamicRenderer : public Module<DefDynamicRenderer>
 	};
 	vector<RenderBlock> m_renderBlocks[DYNREN_FRAMES];
 	vector<Cmd> m_cmds[DYNREN_FRAMES];
-	vector<MaterialRef> m_materials[DYNREN_FRAMES];
+	vector<MaterialRef> m_materials[DYNREN_FRAMES];			// keeps the materials alive until the frame has drawn
+	vector<ResourceHandle> m_materialHandles[DYNREN_FRAMES];	// what the draw loop binds
 
 	// geometry buffers have vertex buffers
 	NeoGeometryBuffer* m_geomBuffers[DYNREN_FRAMES]{};
@@ -0,0 +1,130 @@
+#include "Neo.h"
+#include "DerivedDataCache.h"
+#include "AssetManager.h"
+#include "StringUtils.h"
+
+#include <filesystem>
+#include <thread>
+#if !defined(PLATFORM_Windows)
+#include <unistd.h>
+#endif
+
+CmdLineVar<string> CLV_DerivedDataCache("ddc", "folder for the shared derived data cache - 'none' to disable, blank for the per user default", "");
+
+static u32 CurrentProcessId()
+{
+#if defined(PLATFORM_Windows)
+	return (u32)::GetCurrentProcessId();
+#else
+	return (u32)getpid();
+#endif
+}
+
+static string DefaultCacheFolder()
+{
+#if defined(PLATFORM_Windows)
+	char buffer[MAX_PATH];
+	if (::SHGetFolderPathA(NULL, CSIDL_LOCAL_APPDATA, NULL, 0, buffer) == 0)
+		return StringAddPath(buffer, "NeoDerivedData");
+#else
+	if (const char* xdgCache = getenv("XDG_CACHE_HOME"))
+		return StringAddPath(xdgCache, "NeoDerivedData");
+	if (const char* home = getenv("HOME"))
+		return StringAddPath(StringAddPath(home, ".cache"), "NeoDerivedData");
+#endif
+	return "";
+}
+
+DerivedDataCache::DerivedDataCache()
+{
+	string folder = CLV_DerivedDataCache.Value();
+	if (folder.empty())
+		folder = DefaultCacheFolder();
+	if (folder.empty() || StringEqual(folder, "none"))
+		return;
+
+	std::error_code error;
+	std::filesystem::create_directories(folder, error);
+	if (error)
+	{
+		LOG(Asset, STR("Derived data cache disabled - unable to create {}: {}", folder, error.message()));
+		return;
+	}
+	m_folder = folder;
+	LOG(Asset, STR("Derived data cache: {}", m_folder));
+}
+
+u64 DerivedDataCache::MakeKey(const AssetTypeInfo* assetTypeInfo, const string& name, const stringlist& srcPaths, const vector<MemBlock>& srcFiles, const AssetCreateParams* params)
+{
+	// the name is stored in the converted data, and the extension picks the converter path (ie. .png vs .dds)
+	u64 key = StringHash64(assetTypeInfo->name);
+	key = key * 0x100000001b3ull ^ assetTypeInfo->version;
+	key = key * 0x100000001b3ull ^ StringHash64(name);
+	key = key * 0x100000001b3ull ^ (params ? params->Hash() : 0);
+	for (auto& path : srcPaths)
+		key = key * 0x100000001b3ull ^ StringHash64(StringGetExtension(path));
+	for (auto& src : srcFiles)
+		key = src.Hash64(key);
+	return key;
+}
+
+string DerivedDataCache::KeyPath(u64 key, const string& ext)
+{
+	return StringAddPath(m_folder, STR("{:016x}{}", key, ext));
+}
+
+bool DerivedDataCache::Read(u64 key, const string& ext, MemBlock& block)
+{
+	if (!IsEnabled())
+		return false;
+
+	string path = KeyPath(key, ext);
+	FILE* fh = fopen(path.c_str(), "rb");
+	if (!fh)
+		return false;
+
+	fseek(fh, 0, SEEK_END);
+	size_t size = (size_t)ftell(fh);
+	fseek(fh, 0, SEEK_SET);
+	bool ok = block.Resize(size) && fread(block.Mem(), 1, size, fh) == size;
+	fclose(fh);
+	return ok;
+}
+
+bool DerivedDataCache::Find(u64 key, const string& ext, string& path)
+{
+	if (!IsEnabled())
+		return false;
+
+	std::error_code error;
+	path = KeyPath(key, ext);
+	return std::filesystem::is_regular_file(path, error);
+}
+
+void DerivedDataCache::Write(u64 key, const string& ext, const MemBlock& block)
+{
+	if (!IsEnabled())
+		return;
+
+	// write under a name unique to this process & thread, then rename it into place
+	// readers in other processes only ever see a missing file or a complete one
+	string path = KeyPath(key, ext);
+	string tempPath = STR("{}.{:x}.{:x}.tmp", path, CurrentProcessId(), std::hash<std::thread::id>()(std::this_thread::get_id()));
+	FILE* fh = fopen(tempPath.c_str(), "wb");
+	if (!fh)
+	{
+		LOG(Asset, STR("Unable to write derived data: {}", tempPath));
+		return;
+	}
+	bool written = fwrite(block.Mem(), 1, block.Size(), fh) == block.Size();
+	fclose(fh);
+
+	std::error_code error;
+	if (written)
+		std::filesystem::rename(tempPath, path, error);
+	if (!written || error)
+	{
+		// another process may have the same key open - it holds identical data, so just drop ours
+		std::filesystem::remove(tempPath, error);
+	}
+}
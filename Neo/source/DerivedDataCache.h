@@ -0,0 +1,43 @@
+#pragma once
+
+/**************************************************************************
+DerivedDataCache  -  content addressed store of converted asset data
+
+converted assets are stored under a key made from the asset's name, the bytes and
+extensions of the source files, the asset type's converter version and the create
+params, so the same sources are only ever converted once - no matter what their
+timestamps say.
+the cache folder is outside the working copy, so several working copies can share it.
+
+***************************************************************************/
+
+#include "MemBlock.h"
+
+struct AssetTypeInfo;
+struct AssetCreateParams;
+
+class DerivedDataCache
+{
+public:
+	DerivedDataCache();
+
+	bool IsEnabled() const { return !m_folder.empty(); }
+
+	// key for converted data - changes if the asset name, any source byte or extension, the converter version or the create params change
+	// srcPaths and srcFiles are slot for slot - the path only contributes its extension, so moving a source doesn't miss the cache
+	static u64 MakeKey(const AssetTypeInfo* assetTypeInfo, const string& name, const stringlist& srcPaths, const vector<MemBlock>& srcFiles, const AssetCreateParams* params);
+
+	// read compressed asset data for this key, returns false on a cache miss
+	bool Read(u64 key, const string& ext, MemBlock& block);
+
+	// store compressed asset data - safe to call from several threads and processes at once
+	void Write(u64 key, const string& ext, const MemBlock& block);
+
+	// path of the cached file for this key, for data that's mapped rather than read - false on a cache miss
+	bool Find(u64 key, const string& ext, string& path);
+
+protected:
+	string KeyPath(u64 key, const string& ext);
+
+	string m_folder;
+};
@@ -56,6 +56,17 @@ FileExcludes::~FileExcludes()
 {
 }
 
+u64 FileExcludes::Signature() const
+{
+	u64 signature = 0;
+	for (int i = 0; i < FSExcludeType_MAX; i++)
+	{
+		for (auto exclude : m_excludes[i])
+			signature = (signature ^ exclude) * 0x100000001b3ull + i;
+	}
+	return signature;
+}
+
 bool FileExcludes::IsExcluded(const char *dir, const char *filename, const char *ext)
 {
 	u64 hash[FSExcludeType_MAX];
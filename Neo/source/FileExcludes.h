@@ -17,6 +17,9 @@ public:
 
 	bool IsExcluded(const char *dir, const char *filename, const char *ext);
 
+	// hash of all the excludes - changes if the exclude rules change
+	u64 Signature() const;
+
 protected:
 	vector<u64> m_excludes[FSExcludeType_MAX];
 };
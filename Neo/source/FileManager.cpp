@@ -52,6 +52,19 @@ FileManager::FileManager() : m_nextUniqueFileHandle(0)
 
 FileManager::~FileManager()
 {
+	// don't lose anything still sitting in a stream buffer
+	for (auto &stream : m_streams)
+	{
+		FileHandle handle = stream.handle.load(std::memory_order_acquire);
+		if (handle == nullFileHandle)
+			continue;
+
+		if (stream.writing)
+			StreamWriteEnd(handle);
+		else
+			StreamReadEnd(handle);
+	}
+
 	for (auto fs : m_fileSystems)
 	{
 		delete fs;
@@ -84,14 +97,13 @@ bool FileManager::GetAbsolutePath(const string &name, string &path)
 {
 	SCOPED_MUTEX;
 
-	string filesys, dir, filename, ext;
-	StringSplitIntoFileParts(name, &filesys, &dir, &filename, &ext);
-
-	string localPath = StringAddPath(dir, filesys + ext);
+	string fsName, localPath;
+	StringSplitIntoFSAndPath(name, fsName, localPath);
+	NeoNameKey localName(localPath);
 
 	for (auto fs : m_fileSystems)
 	{
-		if ((!filesys.empty() || filesys == fs->Name()) && fs->GetAbsolutePath(localPath, path))
+		if ((fsName.empty() || fsName == fs->Name()) && fs->GetAbsolutePath(localName, path))
 			return true;
 	}
 	return false;
@@ -103,10 +115,11 @@ bool FileManager::Read(const string &name, MemBlock &block)
 	SCOPED_MUTEX;
 	string fsName, path;
 	StringSplitIntoFSAndPath(name, fsName, path);
+	NeoNameKey pathName(path);
 
 	for (auto fs : m_fileSystems)
 	{
-		if ((fsName.empty() || fsName == fs->Name()) && fs->Read(path, block))
+		if ((fsName.empty() || fsName == fs->Name()) && fs->Read(pathName, block))
 			return true;
 	}
 	return false;
@@ -131,10 +144,11 @@ bool FileManager::Exists(const string &name)
 	SCOPED_MUTEX;
 	string fsName, path;
 	StringSplitIntoFSAndPath(name, fsName, path);
+	NeoNameKey pathName(path);
 
 	for (auto fs : m_fileSystems)
 	{
-		if ((fsName.empty() || fsName == fs->Name()) && fs->Exists(path))
+		if ((fsName.empty() || fsName == fs->Name()) && fs->Exists(pathName))
 			return true;
 	}
 	return false;
@@ -145,10 +159,11 @@ bool FileManager::GetSize(const string &name, u32 &size)
 	SCOPED_MUTEX;
 	string fsName, path;
 	StringSplitIntoFSAndPath(name, fsName, path);
+	NeoNameKey pathName(path);
 
 	for (auto fs : m_fileSystems)
 	{
-		if ((fsName.empty() || fsName == fs->Name()) && fs->GetSize(path, size))
+		if ((fsName.empty() || fsName == fs->Name()) && fs->GetSize(pathName, size))
 			return true;
 	}
 	return false;
@@ -159,15 +174,26 @@ bool FileManager::GetTime(const string &name, u64 &time)
 	SCOPED_MUTEX;
 	string fsName, path;
 	StringSplitIntoFSAndPath(name, fsName, path);
+	NeoNameKey pathName(path);
 
 	for (auto fs : m_fileSystems)
 	{
-		if ((fsName.empty() || fsName == fs->Name()) && fs->GetTime(path, time))
+		if ((fsName.empty() || fsName == fs->Name()) && fs->GetTime(pathName, time))
 			return true;
 	}
 	return false;
 }
 
+void FileManager::GetFileTimes(const string &fsName, vector<std::pair<string, u64>> &times)
+{
+	SCOPED_MUTEX;
+	for (auto fs : m_fileSystems)
+	{
+		if (fsName == fs->Name())
+			fs->GetFileTimes(times);
+	}
+}
+
 bool FileManager::Delete(const string &name)
 {
 	SCOPED_MUTEX;
@@ -279,101 +305,257 @@ string FileManager::MakeLocalPath(const string &name, bool createFolder)
 }
 #endif
 
-bool FileManager::StreamWriteBegin(FileHandle &handle, const string &name)
+FileManager::Stream *FileManager::FindStream(FileHandle handle)
+{
+	u32 index = (handle & 0xffff) - 1;
+	return (index < MaxStreams) ? &m_streams[index] : nullptr;
+}
+
+// called with m_accessMutex held
+FileHandle FileManager::OpenStream(FileSystem *fs, FileHandle fsHandle, bool writing, u32 bufferSize)
 {
+	for (u32 i = 0; i < MaxStreams; i++)
+	{
+		Stream &stream = m_streams[i];
+		if (stream.handle.load(std::memory_order_acquire) != nullFileHandle)
+			continue;
+
+		// nothing else touches a free slot's fields, so set them up before publishing the handle
+		stream.fs = fs;
+		stream.fsHandle = fsHandle;
+		stream.writing = writing;
+		stream.buffer.resize(bufferSize);
+		stream.bufferUsed = 0;
+		stream.bufferPos = 0;
+		stream.generation++;
+
+		FileHandle handle = ((FileHandle)stream.generation << 16) | (i + 1);
+		stream.handle.store(handle, std::memory_order_release);
+		return handle;
+	}
+
+	Error(std::format("Too many open file streams (max {})", MaxStreams));
+	return nullFileHandle;
+}
+
+// called with the stream's lock held
+// the filesystem guards its own stream table, so this doesn't need m_accessMutex - code holding that lock can still log
+bool FileManager::FlushStreamBuffer(Stream *stream)
+{
+	if (stream->bufferUsed == 0)
+		return true;
+
+	u32 size = stream->bufferUsed;
+	stream->bufferUsed = 0;
+	return stream->fs->StreamWrite(stream->fsHandle, stream->buffer.data(), size);
+}
+
+// flush and release the slot, then end the filesystem's stream
+// m_accessMutex is never taken while a stream lock is held, since code holding m_accessMutex may be logging into a stream
+bool FileManager::EndStream(FileHandle handle, bool writing)
+{
+	Stream *stream = FindStream(handle);
+	if (!stream)
+		return false;
+
+	FileSystem *fs;
+	FileHandle fsHandle;
+	bool result = true;
+	{
+		ScopedMutexLock lock(stream->lock);
+		if (stream->handle.load(std::memory_order_acquire) != handle || stream->writing != writing)
+			return false;
+
+		if (writing)
+			result = FlushStreamBuffer(stream);
+
+		fs = stream->fs;
+		fsHandle = stream->fsHandle;
+		stream->fs = nullptr;
+		stream->fsHandle = nullFileHandle;
+		stream->bufferUsed = 0;
+		stream->bufferPos = 0;
+
+		// the slot can be reopened as soon as the handle is cleared, so this goes last
+		stream->handle.store(nullFileHandle, std::memory_order_release);
+	}
+
+	// ending a write can add the file to the filesystem's file list
 	SCOPED_MUTEX;
-	handle = ++m_nextUniqueFileHandle;
+	if (writing)
+		return fs->StreamWriteEnd(fsHandle) && result;
+	return fs->StreamReadEnd(fsHandle);
+}
+
+bool FileManager::StreamWriteBegin(FileHandle &handle, const string &name, u32 bufferSize)
+{
+	handle = nullFileHandle;
 
 	string _fs, _path;
 	StringSplitIntoFSAndPath(name, _fs, _path);
 
+	SCOPED_MUTEX;
+	FileHandle fsHandle = ++m_nextUniqueFileHandle;
+
 	// first try only overwriting files that exist...
+	FileSystem *owner = nullptr;
 	for (auto fs : m_fileSystems)
 	{
-		if ((_fs.empty() || _fs == fs->Name()) && fs->Exists(_path) && fs->StreamWriteBegin(handle, _path))
-			return true;
+		if ((_fs.empty() || _fs == fs->Name()) && fs->Exists(_path) && fs->StreamWriteBegin(fsHandle, _path))
+		{
+			owner = fs;
+			break;
+		}
 	}
 
 	// otherwise, just write to whatever system first says it can - usually the settings folder..
-	for (auto fs : m_fileSystems)
+	if (!owner)
 	{
-		if ((_fs.empty() || _fs == fs->Name()) && fs->StreamWriteBegin(handle, _path))
-			return true;
+		for (auto fs : m_fileSystems)
+		{
+			if ((_fs.empty() || _fs == fs->Name()) && fs->StreamWriteBegin(fsHandle, _path))
+			{
+				owner = fs;
+				break;
+			}
+		}
 	}
-	return false;
+
+	if (!owner)
+		return false;
+
+	handle = OpenStream(owner, fsHandle, true, bufferSize);
+	if (handle == nullFileHandle)
+	{
+		owner->StreamWriteEnd(fsHandle);
+		return false;
+	}
+	return true;
 }
 
 bool FileManager::StreamWrite(FileHandle handle, u8 *mem, u32 size)
 {
-	SCOPED_MUTEX;
-	for (auto fs : m_fileSystems)
+	Stream *stream = FindStream(handle);
+	if (!stream)
+		return false;
+
+	ScopedMutexLock lock(stream->lock);
+	if (stream->handle.load(std::memory_order_acquire) != handle || !stream->writing)
+		return false;
+	if (size == 0)
+		return true;
+
+	u32 capacity = (u32)stream->buffer.size();
+	if (stream->bufferUsed + size > capacity)
 	{
-		if (fs->StreamWrite(handle, mem, size))
-			return true;
+		if (!FlushStreamBuffer(stream))
+			return false;
+
+		// too big to be worth copying through the buffer
+		if (size >= capacity)
+			return stream->fs->StreamWrite(stream->fsHandle, mem, size);
 	}
-	return false;
+
+	memcpy(stream->buffer.data() + stream->bufferUsed, mem, size);
+	stream->bufferUsed += size;
+	return true;
 }
 
 bool FileManager::StreamFlush(FileHandle handle)
 {
-	SCOPED_MUTEX;
-	for (auto fs : m_fileSystems)
-	{
-		if (fs->StreamFlush(handle))
-			return true;
-	}
-	return false;
+	Stream *stream = FindStream(handle);
+	if (!stream)
+		return false;
+
+	ScopedMutexLock lock(stream->lock);
+	if (stream->handle.load(std::memory_order_acquire) != handle || !stream->writing)
+		return false;
+
+	if (!FlushStreamBuffer(stream))
+		return false;
+	return stream->fs->StreamFlush(stream->fsHandle);
 }
 
 bool FileManager::StreamWriteEnd(FileHandle handle)
 {
-	SCOPED_MUTEX;
-	for (auto fs : m_fileSystems)
-	{
-		if (fs->StreamWriteEnd(handle))
-			return true;
-	}
-	return false;
+	return EndStream(handle, true);
 }
 
-bool FileManager::StreamReadBegin(FileHandle &handle, const string &name)
+bool FileManager::StreamReadBegin(FileHandle &handle, const string &name, u32 bufferSize)
 {
 	LOG(File, std::format("Stream Read {}", name));
 
-	SCOPED_MUTEX;
-	handle = ++m_nextUniqueFileHandle;
+	handle = nullFileHandle;
 
 	string _fs, _path;
 	StringSplitIntoFSAndPath(name, _fs, _path);
 
+	SCOPED_MUTEX;
+	FileHandle fsHandle = ++m_nextUniqueFileHandle;
+
 	for (auto fs : m_fileSystems)
 	{
-		if ((_fs.empty() || _fs == fs->Name()) && fs->Exists(_path) && fs->StreamReadBegin(handle, _path))
+		if ((_fs.empty() || _fs == fs->Name()) && fs->Exists(_path) && fs->StreamReadBegin(fsHandle, _path))
+		{
+			handle = OpenStream(fs, fsHandle, false, bufferSize);
+			if (handle == nullFileHandle)
+			{
+				fs->StreamReadEnd(fsHandle);
+				return false;
+			}
 			return true;
+		}
 	}
 	return false;
 }
 
 bool FileManager::StreamRead(FileHandle handle, u8 *mem, u32 size, u32 &sizeRead)
 {
-	SCOPED_MUTEX;
-	for (auto fs : m_fileSystems)
+	sizeRead = 0;
+
+	Stream *stream = FindStream(handle);
+	if (!stream)
+		return false;
+
+	ScopedMutexLock lock(stream->lock);
+	if (stream->handle.load(std::memory_order_acquire) != handle || stream->writing)
+		return false;
+
+	u32 capacity = (u32)stream->buffer.size();
+	while (sizeRead < size)
 	{
-		if (fs->StreamRead(handle, mem, size, sizeRead))
-			return true;
+		if (stream->bufferPos == stream->bufferUsed)
+		{
+			u32 remaining = size - sizeRead;
+			u32 chunkRead = 0;
+
+			// big reads go straight into the caller's memory
+			if (remaining >= capacity)
+			{
+				if (!stream->fs->StreamRead(stream->fsHandle, mem + sizeRead, remaining, chunkRead) || chunkRead == 0)
+					break;
+				sizeRead += chunkRead;
+				continue;
+			}
+
+			stream->bufferPos = 0;
+			stream->bufferUsed = 0;
+			if (!stream->fs->StreamRead(stream->fsHandle, stream->buffer.data(), capacity, chunkRead) || chunkRead == 0)
+				break;
+			stream->bufferUsed = chunkRead;
+		}
+
+		u32 copySize = Min(size - sizeRead, stream->bufferUsed - stream->bufferPos);
+		memcpy(mem + sizeRead, stream->buffer.data() + stream->bufferPos, copySize);
+		stream->bufferPos += copySize;
+		sizeRead += copySize;
 	}
-	return false;
+	return sizeRead > 0;
 }
 
 bool FileManager::StreamReadEnd(FileHandle handle)
 {
-	SCOPED_MUTEX;
-	for (auto fs : m_fileSystems)
-	{
-		if (fs->StreamReadEnd(handle))
-			return true;
-	}
-	return false;
+	return EndStream(handle, false);
 }
 
 CallbackHandle FileManager::AddFileChangeCallback(const FileSystem_FileChangeCallback &callback)
@@ -396,7 +578,6 @@ void FileManager::RemoveFileChangeCallback(CallbackHandle handle)
 
 void FileManager::Update()
 {
-#if defined(PLATFORM_Windows)
 	SCOPED_MUTEX;
 
 	struct Change
@@ -410,7 +591,7 @@ void FileManager::Update()
 	for (auto fs : m_fileSystems)
 	{
 		string filename;
-		if (fs->PopChangedFile(filename))
+		while (fs->PopChangedFile(filename))
 		{
 			if (!changes)
 				changes = new vector<Change>();
@@ -436,5 +617,4 @@ void FileManager::Update()
 		m_accessMutex.Lock();
 		delete changes;
 	}
-#endif
 }
@@ -3,6 +3,7 @@
 #include "Module.h"
 #include "FileSystem.h"
 #include "Thread.h"
+#include <atomic>
 
 class FileManager : public Module<FileManager>
 {
@@ -38,6 +39,9 @@ public:
 	// returns TRUE if the file was found
 	bool GetTime(const string &name, u64 &time);
 
+	// name & write time of every file on one file system (ie. "src") - for building manifests in bulk
+	void GetFileTimes(const string &fsName, vector<std::pair<string, u64>> &times);
+
 	// delete the file from the first filesystem we find it in that 
 	bool Delete(const string &name);
 
@@ -59,14 +63,19 @@ public:
 	// rebuild files for any filesystem that may have changed
 	void Rescan();
 
+	// streams are buffered in user space - writes only reach the filesystem when the buffer fills, on StreamFlush or on StreamWriteEnd
+	// bufferSize 0 passes every call straight through to the filesystem
+	// calls on the same handle from different threads are serialised by the stream's own lock - only opening & ending a stream take the FileManager lock
+	static constexpr u32 DefaultStreamBufferSize = 64 * 1024;
+
 	// create file for writing
-	bool StreamWriteBegin(FileHandle &handle, const string &name);
+	bool StreamWriteBegin(FileHandle &handle, const string &name, u32 bufferSize = DefaultStreamBufferSize);
 	bool StreamWrite(FileHandle handle, u8 *mem, u32 size);
 	bool StreamFlush(FileHandle handle);
 	bool StreamWriteEnd(FileHandle handle);
 	inline bool StreamWrite(FileHandle handle, const string &str) { return StreamWrite(handle, (u8*)str.c_str(), (u32)str.size()); }
 
-	bool StreamReadBegin(FileHandle &handle, const string &name);
+	bool StreamReadBegin(FileHandle &handle, const string &name, u32 bufferSize = DefaultStreamBufferSize);
 	bool StreamRead(FileHandle handle, u8 *mem, u32 size, u32 &sizeRead);
 	bool StreamReadEnd(FileHandle handle);
 
@@ -77,6 +86,28 @@ public:
 	void Update();
 
 protected:
+	// open streams live in a fixed slot table - a handle is (generation << 16) | (slot + 1) so finding a stream is just index math
+	// the generation stops a stale handle from reaching a slot that has since been reused
+	static constexpr u32 MaxStreams = 256;
+	struct Stream
+	{
+		Mutex lock;
+		std::atomic<FileHandle> handle = nullFileHandle;
+		FileSystem *fs = nullptr;
+		FileHandle fsHandle = nullFileHandle;
+		bool writing = false;
+		vector<u8> buffer;
+		u32 bufferUsed = 0;		// bytes waiting to be written, or bytes read ahead
+		u32 bufferPos = 0;		// read position in the read ahead
+		u16 generation = 0;
+	};
+	Stream m_streams[MaxStreams];
+
+	Stream *FindStream(FileHandle handle);
+	FileHandle OpenStream(FileSystem *fs, FileHandle fsHandle, bool writing, u32 bufferSize);
+	bool FlushStreamBuffer(Stream *stream);
+	bool EndStream(FileHandle handle, bool writing);
+
 	Mutex m_accessMutex;
 
 	vector<FileSystem*> m_fileSystems;
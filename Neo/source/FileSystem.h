@@ -24,12 +24,15 @@ public:
 	virtual bool CanWrite() const = 0;
 	virtual int Priority() const = 0;
 	virtual const string &Name() const = 0;
-	virtual bool GetAbsolutePath(const string &name, string &path) = 0;
-	virtual bool Read(const string &name, MemBlock &block) = 0;
+	virtual bool GetAbsolutePath(const NeoNameKey &name, string &path) = 0;
+	virtual bool Read(const NeoNameKey &name, MemBlock &block) = 0;
 	virtual bool Write(const string &name, MemBlock &block) = 0;
-	virtual bool Exists(const string &name) = 0;
-	virtual bool GetSize(const string &name, u32 &size) = 0;
-	virtual bool GetTime(const string &name, u64 &time) = 0;
+	virtual bool Exists(const NeoNameKey &name) = 0;
+	virtual bool GetSize(const NeoNameKey &name, u32 &size) = 0;
+	virtual bool GetTime(const NeoNameKey &name, u64 &time) = 0;
+	// name & current write time of every file in one pass - much cheaper than a GetTime per file
+	// file systems that can't list their files just leave the list alone
+	virtual void GetFileTimes(vector<std::pair<string, u64>> &times) {}
 	virtual bool Delete(const string &name) = 0;
 	virtual bool Rename(const string &oldName, const string &newName) = 0;
 	virtual void GetListByExt(const string &ext, std::vector<string> &list) = 0;
@@ -39,6 +42,8 @@ public:
 
 	virtual void Rescan() = 0;
 
+	// NOTE: only Begin & End are called with the FileManager lock held - StreamWrite, StreamRead & StreamFlush are called without it,
+	// alongside other streams and any other call on this file system, so each file system must guard its stream table with its own lock
 	virtual bool StreamWriteBegin(FileHandle handle, const string &name) = 0;
 	virtual bool StreamWrite(FileHandle handle, u8 *mem, u32 size) = 0;
 	virtual bool StreamFlush(FileHandle handle) = 0;
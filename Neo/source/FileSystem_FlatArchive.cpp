@@ -4,9 +4,10 @@
 #include "Thread.h"
 #include "MathUtils.h"
 #include "StringUtils.h"
+#include "TimeManager.h"
 
 FileSystem_FlatArchive::FileSystem_FlatArchive(const string &name, const string &path, int priority)
-	: m_name(name), m_path(path), m_priority(priority), m_dataStart(0)
+	: m_name(name), m_path(path), m_priority(priority), m_dataStart(0), m_chunkSize(0)
 {
 	LOG(File, std::format("MOUNT ARCHIVE: {}", name));
 
@@ -14,12 +15,29 @@ FileSystem_FlatArchive::FileSystem_FlatArchive(const string &name, const string
 	m_fh = fopen(path.c_str(), "rb");
 	if (m_fh != 0)
 	{
+		// old archives just start with the toc size
 		u32 tocSize;
 		fread(&tocSize, 4, 1, m_fh);
+		m_dataStart = 4;
+		if (tocSize == ARCHIVE_MAGIC)
+		{
+			ArchiveHeader header;
+			header.magic = tocSize;
+			fread(&header.version, sizeof(header) - 4, 1, m_fh);
+			if (header.version != ARCHIVE_VERSION || header.chunkSize == 0)
+			{
+				Error(std::format("Unsupported archive version {} : {}", header.version, path));
+				return;
+			}
+			tocSize = header.tocSize;
+			m_chunkSize = header.chunkSize;
+			m_dataStart = sizeof(ArchiveHeader);
+		}
+
 		if (tocSize < 10000000)
 		{
 			m_tocMem.Resize(tocSize);
-			m_dataStart = tocSize+4;
+			m_dataStart += tocSize;
 			if (fread(m_tocMem.Mem(), 1, tocSize, m_fh) == tocSize)
 			{
 				u8 *tocPtr = m_tocMem.Mem();
@@ -27,7 +45,7 @@ FileSystem_FlatArchive::FileSystem_FlatArchive(const string &name, const string
 				while (tocPtr < tocEnd)
 				{
 					TOCEntry *entry = (TOCEntry*)tocPtr;
-					u64 hash = StringHash64(entry->name);
+					u64 hash = NeoNameHash(entry->name);
 					m_entries.insert(std::pair<u64, TOCEntry*>(hash, entry));
 					tocPtr += entry->tocEntrySize;
 
@@ -52,10 +70,26 @@ FileSystem_FlatArchive::~FileSystem_FlatArchive()
 		fclose(m_fh);
 }
 
-bool FileSystem_FlatArchive::Read(const string &name, MemBlock &block)
+bool FileSystem_FlatArchive::ReadEntryData(TOCEntry *entry, FILE *fh, u64 offset, u8 *mem, u32 size)
+{
+	u64 seekPos = m_dataStart + entry->offset + offset;
+	if (_fseeki64(fh, seekPos, SEEK_SET) != 0)
+	{
+		Error(std::format("ERROR SEEKING RKV TO {} for file {}", seekPos, entry->name));
+		return false;
+	}
+	if (size > 0 && fread(mem, size, 1, fh) != 1)
+	{
+		Error(std::format("ERROR READING File {} from Archive {}", entry->name, m_path));
+		return false;
+	}
+	return true;
+}
+
+bool FileSystem_FlatArchive::Read(const NeoNameKey &name, MemBlock &block)
 {
 	// check if entry is in the TOC
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto it = m_entries.find(hash);
 	if (it == m_entries.end())
 		return false;
@@ -73,8 +107,8 @@ bool FileSystem_FlatArchive::Read(const string &name, MemBlock &block)
 	if (currentThread == m_threadID)
 	{
 		// main thread can just seek and read for speed
-		_fseeki64(m_fh, m_dataStart + entry->offset, SEEK_SET);
-		fread(temp.Mem(), temp.Size(), 1, m_fh);
+		if (!ReadEntryData(entry, m_fh, 0, temp.Mem(), entry->compressedSize))
+			return false;
 	}
 	else
 	{
@@ -85,27 +119,47 @@ bool FileSystem_FlatArchive::Read(const string &name, MemBlock &block)
 			Error(std::format("ERROR opening RKV {}", m_path));
 			return false;
 		}
-		u64 seekPos = m_dataStart + entry->offset;
-		if (_fseeki64(fh, seekPos, SEEK_SET) != 0)
+		bool ok = ReadEntryData(entry, fh, 0, temp.Mem(), entry->compressedSize);
+		fclose(fh);
+		if (!ok)
+			return false;
+	}
+
+	if (m_chunkSize == 0)
+		return temp.DecompressTo(block);
+
+	// decompress each chunk straight into its place in the output block
+	u32 numChunks = NumChunks(entry);
+	u32 *chunkOffsets = (u32*)temp.Mem();
+	// the first chunk starts after the table, so a smaller offset would decompress the table itself
+	if ((u64)(numChunks + 1) * 4 > entry->compressedSize || chunkOffsets[0] < (numChunks + 1) * 4 || chunkOffsets[numChunks] > entry->compressedSize)
+	{
+		Error(std::format("Corrupt chunk table for file {} in archive {}", name, m_path));
+		return false;
+	}
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		if (chunkOffsets[i] > chunkOffsets[i + 1])
 		{
-			Error(std::format("ERROR SEEKING RKV TO {} for file {}", m_dataStart + entry->offset, entry->name));
+			Error(std::format("Corrupt chunk table for file {} in archive {}", name, m_path));
 			return false;
 		}
-		if (fread(temp.Mem(), temp.Size(), 1, fh) != 1)
+		u32 chunkStart = i * m_chunkSize;
+		MemBlock chunk(temp.Mem() + chunkOffsets[i], chunkOffsets[i + 1] - chunkOffsets[i], true);
+		MemBlock dest(block.Mem() + chunkStart, Min(m_chunkSize, entry->decompressedSize - chunkStart), true);
+		if (!chunk.DecompressTo(dest))
 		{
-			Error(std::format("ERROR READING File {} from Archive {}", entry->name, m_path));
+			Error(std::format("Corrupt chunk {} for file {} in archive {}", i, name, m_path));
 			return false;
 		}
-		fclose(fh);
 	}
-	temp.DecompressTo(block);
 	return true;
 }
 
-bool FileSystem_FlatArchive::Exists(const string &name)
+bool FileSystem_FlatArchive::Exists(const NeoNameKey &name)
 {
 	// check if entry is in the TOC
-	auto it = m_entries.find(StringHash64(name));
+	auto it = m_entries.find(name.Hash());
 	return (it != m_entries.end());
 }
 
@@ -128,17 +182,17 @@ void FileSystem_FlatArchive::GetListByDelegate(const FileSystem_FilenameFilterDe
 	}
 }
 
-bool FileSystem_FlatArchive::GetSize(const string &name, u32 &size)
+bool FileSystem_FlatArchive::GetSize(const NeoNameKey &name, u32 &size)
 {
 	// check if entry is in the TOC
-	auto it = m_entries.find(StringHash64(name));
+	auto it = m_entries.find(name.Hash());
 	if (it == m_entries.end())
 		return false;
 	size = it->second->decompressedSize;
 	return true;
 }
 
-bool FileSystem_FlatArchive::GetTime(const string &name, u64 &time)
+bool FileSystem_FlatArchive::GetTime(const NeoNameKey &name, u64 &time)
 {
 	// check if entry is in the TOC
 	if (Exists(name))
@@ -165,58 +219,140 @@ void FileSystem_FlatArchive::GetListByExt(const string &ext, std::vector<string>
 
 bool FileSystem_FlatArchive::StreamReadBegin(FileHandle handle, const string &name)
 {
-	if (!Exists(name))
+	auto it = m_entries.find(NeoNameHash(name));
+	if (it == m_entries.end())
 		return false;
 
+	auto entry = it->second;
 	auto fileStream = new FileStream;
-	if (Read(name, fileStream->memory))
+	fileStream->id = handle;
+	fileStream->entry = entry;
+	if (m_chunkSize == 0)
 	{
-		LOG(File, std::format("STREAM READ BEGIN {} -> {}", name, fileStream->memory.Size()));
-		fileStream->id = handle;
+		// old style archive - the whole file has to be decompressed up front
+		if (!Read(name, fileStream->memory))
+		{
+			Error(std::format("Load Error on Archive: {} - loading file {}", m_name, name));
+			delete fileStream;
+			return false;
+		}
 		fileStream->readPtr = fileStream->memory.Mem();
 		fileStream->remaining = (u32)fileStream->memory.Size();
-		m_activeStreams.push_back(fileStream);
-		return true;
 	}
 	else
 	{
-		Error(std::format("Load Error on Archive: {} - loading file {}", m_name, name));
+		// just load the chunk table - chunks are decompressed one at a time as the stream reaches them
+		u32 numChunks = NumChunks(entry);
+		fileStream->chunkOffsets.resize(numChunks + 1);
+		fileStream->fh = fopen(m_path.c_str(), "rb");
+		if (!fileStream->fh || !ReadEntryData(entry, fileStream->fh, 0, (u8*)fileStream->chunkOffsets.data(), (numChunks + 1) * 4))
+		{
+			Error(std::format("Load Error on Archive: {} - loading file {}", m_name, name));
+			if (fileStream->fh)
+				fclose(fileStream->fh);
+			delete fileStream;
+			return false;
+		}
+		if (fileStream->chunkOffsets[0] < (numChunks + 1) * 4)
+		{
+			Error(std::format("Corrupt chunk table for file {} in archive {}", name, m_path));
+			fclose(fileStream->fh);
+			delete fileStream;
+			return false;
+		}
+		fileStream->memory.Resize(Min(m_chunkSize, entry->decompressedSize));
+		fileStream->readPtr = fileStream->memory.Mem();
+		fileStream->remaining = 0;
 	}
-	return false;
+
+	LOG(File, std::format("STREAM READ BEGIN {} -> {}", name, entry->decompressedSize));
+	{
+		ScopedMutexLock lock(m_streamLock);
+		m_activeStreams[handle] = fileStream;
+	}
+	return true;
+}
+
+bool FileSystem_FlatArchive::StreamNextChunk(FileStream *fileStream)
+{
+	u32 chunk = fileStream->nextChunk;
+	if (chunk + 1 >= fileStream->chunkOffsets.size())
+		return false;
+
+	auto entry = fileStream->entry;
+	u32 chunkStart = chunk * m_chunkSize;
+	u32 chunkOffset = fileStream->chunkOffsets[chunk];
+	u32 chunkEnd = fileStream->chunkOffsets[chunk + 1];
+	if (chunkEnd < chunkOffset || chunkEnd > entry->compressedSize)
+	{
+		Error(std::format("Corrupt chunk table for file {} in archive {}", entry->name, m_path));
+		return false;
+	}
+
+	// reuse the stream's buffers, so memory stays at one chunk however big the file is
+	u32 compressedSize = chunkEnd - chunkOffset;
+	if (fileStream->compressed.Size() < compressedSize)
+		fileStream->compressed.Resize(compressedSize);
+	if (!ReadEntryData(entry, fileStream->fh, chunkOffset, fileStream->compressed.Mem(), compressedSize))
+		return false;
+
+	u32 decompressedSize = Min(m_chunkSize, entry->decompressedSize - chunkStart);
+	MemBlock chunkBlock(fileStream->compressed.Mem(), compressedSize, true);
+	MemBlock window(fileStream->memory.Mem(), decompressedSize, true);
+	if (!chunkBlock.DecompressTo(window))
+	{
+		Error(std::format("Corrupt chunk {} for file {} in archive {}", chunk, entry->name, m_path));
+		return false;
+	}
+
+	fileStream->readPtr = fileStream->memory.Mem();
+	fileStream->remaining = decompressedSize;
+	fileStream->nextChunk++;
+	return true;
 }
 
 bool FileSystem_FlatArchive::StreamRead(FileHandle handle, u8 *mem, u32 size, u32 &sizeRead)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle)
-		{
-			sizeRead = Min(size, fileStream->remaining);
-			if (sizeRead > 0)
-			{
-				memcpy(mem, fileStream->readPtr, sizeRead);
-				fileStream->readPtr += sizeRead;
-				fileStream->remaining -= sizeRead;
-			}
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	sizeRead = 0;
+	while (sizeRead < size)
+	{
+		if (fileStream->remaining == 0 && (!fileStream->fh || !StreamNextChunk(fileStream)))
+			break;
+
+		u32 copySize = Min(size - sizeRead, fileStream->remaining);
+		memcpy(mem + sizeRead, fileStream->readPtr, copySize);
+		fileStream->readPtr += copySize;
+		fileStream->remaining -= copySize;
+		sizeRead += copySize;
+	}
+	return true;
 }
 
 bool FileSystem_FlatArchive::StreamReadEnd(FileHandle handle)
 {
-	for (auto it = m_activeStreams.begin(); it != m_activeStreams.end(); ++it)
+	FileStream *fileStream;
 	{
-		FileStream *fileStream = *it;
-		if (fileStream->id == handle)
-		{
-			delete fileStream;
-			m_activeStreams.erase(it);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
+		m_activeStreams.erase(it);
 	}
-	return false;
+
+	if (fileStream->fh)
+		fclose(fileStream->fh);
+	delete fileStream;
+	return true;
 }
 
 struct BTOCEntry
@@ -225,11 +361,40 @@ struct BTOCEntry
 	MemBlock compressed;
 	u64 tocEntryOffset;
 	u32 tocEntrySize;
+	u32 decompressedSize = 0;
+	Semaphore ready;
 };
 
-void FileSystem_FlatArchive::WriteArchive(const string &outputFile)
+// split a file into separately compressed chunks, laid out as a table of chunk offsets followed by the chunks
+static void CompressChunks(MemBlock &src, MemBlock &dest, MemBlockCodecType codec)
+{
+	u32 numChunks = (u32)((src.Size() + ARCHIVE_CHUNK_SIZE - 1) / ARCHIVE_CHUNK_SIZE);
+	vector<MemBlock> chunks(numChunks);
+	u32 totalSize = (numChunks + 1) * 4;
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		size_t chunkStart = (size_t)i * ARCHIVE_CHUNK_SIZE;
+		MemBlock chunk(src.Mem() + chunkStart, Min(src.Size() - chunkStart, (size_t)ARCHIVE_CHUNK_SIZE), true);
+		chunk.CompressTo(chunks[i], codec);
+		totalSize += (u32)chunks[i].Size();
+	}
+
+	dest.Resize(totalSize);
+	u32 *chunkOffsets = (u32*)dest.Mem();
+	u32 offset = (numChunks + 1) * 4;
+	for (u32 i = 0; i < numChunks; i++)
+	{
+		chunkOffsets[i] = offset;
+		memcpy(dest.Mem() + offset, chunks[i].Mem(), chunks[i].Size());
+		offset += (u32)chunks[i].Size();
+	}
+	chunkOffsets[numChunks] = offset;
+}
+
+void FileSystem_FlatArchive::WriteArchive(const string &outputFile, int maxThreads, MemBlockCodecType codec)
 {
 	FileManager &fm = FileManager::Instance();
+	double startTime = NeoTimeNow;
 
 	// first we build a list of all known files that match our excludes criteria
 	string archiveName = outputFile + ".rkv";
@@ -237,6 +402,7 @@ void FileSystem_FlatArchive::WriteArchive(const string &outputFile)
 	auto excludes = new FileExcludes(excludesFile);
 	std::vector<string> files;
 	fm.GetListByExcludes(excludes, files);
+	delete excludes;
 
 	// first pass - calculate the toc size
 	u64 tocSize = 0;
@@ -252,45 +418,85 @@ void FileSystem_FlatArchive::WriteArchive(const string &outputFile)
 		btocsList.push_back(btoc);
 	}
 
-	// allocate the toc
+	// allocate the toc - clear it so that trailing space is blank, we want the archive to generate EXACTLY the same every time
 	u8 *tocMem = new u8[tocSize];
+	memset(tocMem, 0, tocSize);
 
-	// second pass - build the toc by reading files in and compressing them and keeping them in memory for now
-	u32 dataOffset = 0;
-	MemBlock tmpMem;
-
-    for (auto btoc : btocsList)
+	FILE *fh = fopen(archiveName.c_str(), "wb");
+	if (!fh)
 	{
-		fm.Read(btoc->filename, tmpMem);
-		tmpMem.CompressTo(btoc->compressed);
-		TOCEntry *toc = (TOCEntry*)(tocMem + btoc->tocEntryOffset);
+		Error(std::format("Unable to create archive: {}", outputFile));
+		for (auto btoc : btocsList)
+			delete btoc;
+		delete [] tocMem;
+		return;
+	}
 
-		// clear the toc so that trailing space is blank - we want the archive to generate EXACTLY the same every time
-		memset(toc, 0, btoc->tocEntrySize);
+	// reserve space for the toc, it gets written for real once all the compressed sizes are known
+	ArchiveHeader header = { ARCHIVE_MAGIC, ARCHIVE_VERSION, (u32)tocSize, ARCHIVE_CHUNK_SIZE };
+	fwrite(&header, sizeof(header), 1, fh);
+	fwrite(tocMem, tocSize, 1, fh);
+
+	// second pass - read & compress on a worker farm, while this thread writes the finished entries out in list order
+	// the output only depends on the list order, so it is identical no matter how many threads are used
+	if (maxThreads <= 0)
+		maxThreads = Max(1, (int)std::thread::hardware_concurrency());
+	WorkerFarm compressFarm(ThreadGUID_ArchiveBuilder, "ArchiveBuilder", maxThreads, false);
+	compressFarm.StartWork();
+
+	// only keep a window of entries in flight so we don't hold the whole archive in memory
+	int window = maxThreads * 4;
+	int nextToQueue = 0;
+	auto queueNext = [&]()
+		{
+			if (nextToQueue < (int)btocsList.size())
+			{
+				BTOCEntry *btoc = btocsList[nextToQueue++];
+				compressFarm.AddTask([btoc, codec, &fm]()
+					{
+						MemBlock tmpMem;
+						if (!fm.Read(btoc->filename, tmpMem))
+							LOG(Error, STR("Archive: unable to read {}", btoc->filename));
+						CompressChunks(tmpMem, btoc->compressed, codec);
+						btoc->decompressedSize = (u32)tmpMem.Size();
+						btoc->ready.Signal();
+					});
+			}
+		};
+	for (int i = 0; i < window; i++)
+		queueNext();
+
+	u64 dataOffset = 0;
+	u64 totalDecompressed = 0;
+	for (auto btoc : btocsList)
+	{
+		btoc->ready.Wait();
+		queueNext();
 
+		TOCEntry *toc = (TOCEntry*)(tocMem + btoc->tocEntryOffset);
 		toc->compressedSize = (u32)btoc->compressed.Size();
-		toc->decompressedSize = (u32)tmpMem.Size();
+		toc->decompressedSize = btoc->decompressedSize;
 		strcpy(toc->name, btoc->filename.c_str());
 		toc->offset = dataOffset;
 		toc->tocEntrySize = btoc->tocEntrySize;
+		LOG(File, STR("TOC[{:5}] : <{} -> {}>({}%) @ {:8} {}", btoc->tocEntryOffset, toc->decompressedSize, toc->compressedSize, toc->compressedSize * 100 / Max(1u, toc->decompressedSize), toc->offset, toc->name));
+
+		fwrite(btoc->compressed.Mem(), btoc->compressed.Size(), 1, fh);
 		dataOffset += toc->compressedSize;
-		LOG(File, STR("TOC[%5d] : <%d -> %d>(%d%%) @ %8d %s", btoc->tocEntryOffset, toc->decompressedSize, toc->compressedSize, toc->compressedSize * 100 / toc->decompressedSize, toc->offset, toc->name));
+		totalDecompressed += toc->decompressedSize;
+		btoc->compressed = MemBlock();
 	}
+	compressFarm.KillWorkers();
+	for (auto btoc : btocsList)
+		delete btoc;
 
-	// finally ready to write out the toc and those files out
-	FILE *fh = fopen(archiveName.c_str(), "wb");
-	if (fh)
-	{
-		fwrite(&tocSize, 4, 1, fh);
-		fwrite(tocMem, tocSize, 1, fh);
-		for (auto btoc : btocsList)
-		{
-			fwrite(btoc->compressed.Mem(), btoc->compressed.Size(), 1, fh);
-		}
-		fclose(fh);
-	}
-	else
-	{
-		Error(std::format("Unable to create archive: {}", outputFile));
-	}
+	// finally go back and fill in the toc
+	_fseeki64(fh, sizeof(ArchiveHeader), SEEK_SET);
+	fwrite(tocMem, tocSize, 1, fh);
+	fclose(fh);
+	delete [] tocMem;
+
+	double elapsed = Max(NeoTimeNow - startTime, 0.000001);
+	LOG(File, STR("Archive {} : {} files, {} -> {} bytes ({}%) in {:.2f}s, {:.1f} MB/s on {} threads", archiveName, btocsList.size(), totalDecompressed, dataOffset + tocSize + sizeof(ArchiveHeader),
+		(dataOffset + tocSize + sizeof(ArchiveHeader)) * 100 / Max((u64)1, totalDecompressed), elapsed, (double)totalDecompressed / (1024.0 * 1024.0) / elapsed, maxThreads));
 }
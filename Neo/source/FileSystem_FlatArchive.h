@@ -4,6 +4,13 @@
 #include "FileExcludes.h"
 #include "Thread.h"
 
+// archive files start with this header, followed by the toc, then the file data
+// each file is split into chunks that are compressed separately, so streams only ever need one chunk in memory
+// old archives without the header (just a u32 toc size) still load, but stream by reading the whole file
+#define ARCHIVE_MAGIC 0x564b5221		// '!RKV'
+#define ARCHIVE_VERSION 2
+#define ARCHIVE_CHUNK_SIZE (64*1024)
+
 class FileSystem_FlatArchive : public FileSystem
 {
 public:
@@ -12,16 +19,18 @@ public:
 
 	// write an archive file
 	// outputFile - full path name of output archive (ie ".\data.rkv")
-	static void WriteArchive(const string &outputFile);
+	// maxThreads - number of compression threads, 0 uses all hardware threads. output is identical regardless
+	// codec - compression used for each entry
+	static void WriteArchive(const string &outputFile, int maxThreads = 0, MemBlockCodecType codec = MemBlockCodec_Zlib);
 
 	virtual bool CanWrite() const { return false; }
 	virtual int Priority() const { return m_priority; }
 	virtual const string &Name() const { return m_name; }
 
-	virtual bool Read(const string &name, MemBlock &block);
-	virtual bool Exists(const string &name);
-	virtual bool GetSize(const string &name, u32 &size);
-	virtual bool GetTime(const string &name, u64 &time);
+	virtual bool Read(const NeoNameKey &name, MemBlock &block);
+	virtual bool Exists(const NeoNameKey &name);
+	virtual bool GetSize(const NeoNameKey &name, u32 &size);
+	virtual bool GetTime(const NeoNameKey &name, u64 &time);
 	virtual void GetListByExt(const string &ext, std::vector<string> &list);
 
 	virtual bool StreamReadBegin(FileHandle handle, const string &name);
@@ -30,7 +39,7 @@ public:
 
 	// not supported by archives...
 	virtual void Rescan() {}
-	virtual bool GetAbsolutePath(const string &name, string &path) { return false; }
+	virtual bool GetAbsolutePath(const NeoNameKey &name, string &path) { return false; }
 	virtual bool Write(const string &name, MemBlock &block) { return false; }
 	virtual bool Delete(const string &name) { return false; }
 	virtual bool Rename(const string &oldName, const string &newName) { return false; }
@@ -45,6 +54,15 @@ public:
 	virtual bool PopChangedFile(string &name) { return false;	}
 
 protected:
+	struct ArchiveHeader
+	{
+		u32 magic;
+		u32 version;
+		u32 tocSize;
+		u32 chunkSize;
+	};
+
+	// in chunked archives, file data is a table of numChunks+1 offsets (relative to the file data) followed by each compressed chunk
 	struct TOCEntry
 	{
 		u64 offset;
@@ -58,17 +76,31 @@ protected:
 	string m_path;
 	MemBlock m_tocMem;
 	u32 m_dataStart;
+	u32 m_chunkSize;	// 0 for old archives that compress each file as one block
 	FILE *m_fh;
 	ThreadID m_threadID;
 	int m_priority;
 
+	u32 NumChunks(const TOCEntry *entry) const { return (entry->decompressedSize + m_chunkSize - 1) / m_chunkSize; }
+
+	// read raw (compressed) bytes of a file entry from an open archive file
+	bool ReadEntryData(TOCEntry *entry, FILE *fh, u64 offset, u8 *mem, u32 size);
+
 	struct FileStream
 	{
 		FileHandle id;
 		TOCEntry *entry;
-		MemBlock memory;
+		MemBlock memory;		// whole file for old archives, or the current decompressed chunk
 		u8 *readPtr;
 		u32 remaining;
+
+		// chunked streaming
+		FILE *fh = nullptr;
+		vector<u32> chunkOffsets;
+		MemBlock compressed;
+		u32 nextChunk = 0;
 	};
-	std::vector<FileStream*> m_activeStreams;
+	bool StreamNextChunk(FileStream *fileStream);
+	hashtable<FileHandle, FileStream*> m_activeStreams;
+	Mutex m_streamLock;		// streams are read & written outside the FileManager lock, so the stream table has its own
 };
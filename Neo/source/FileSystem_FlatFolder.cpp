@@ -1,14 +1,88 @@
 #include "Neo.h"
 #include "FileSystem_FlatFolder.h"
 #include "StringUtils.h"
+#include "Serializer.h"
+#include "TimeManager.h"
+#include "Thread.h"
+
+#if defined(PLATFORM_Unix)
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/syscall.h>
+#endif
+
+#define FOLDER_INDEX_VERSION 1
+
+// Write puts the new data here first and renames it into place - it's never scanned or reported as a change
+#define FLATFOLDER_TEMP_EXT ".neotmp"
+
+CmdLineVar<bool> CLV_FolderIndex("folderindex", "cache folder scans in an index file and only relist folders that have changed", true);
+
+// last write time of a file or folder
+// a folder's time only changes when entries are added, removed or renamed in it
+static bool GetPathTime(const string &path, u64 &time)
+{
+#if defined(PLATFORM_Windows)
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &info))
+	{
+		time = ((u64)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+		return true;
+	}
+#elif defined(PLATFORM_Unix)
+	struct stat info;
+	if (stat(path.c_str(), &info) == 0)
+	{
+		time = (u64)info.st_mtim.tv_sec * 1000000000ull + info.st_mtim.tv_nsec;
+		return true;
+	}
+#endif
+	return false;
+}
+
+// a few workers for batches of file system calls - run blocks until every task in the batch is done
+// the semaphore is declared before the farm, so it outlives any worker that could still be signalling it
+class FolderScanFarm
+{
+	Semaphore m_done;
+	WorkerFarm m_farm;
+
+public:
+	FolderScanFarm(int maxWorkers) : m_farm(ThreadGUID_FileScan, "FileScan", Min(maxWorkers, Min(Max(1, (int)std::thread::hardware_concurrency()), 8)), false) { m_farm.StartWork(); }
+
+	void Run(int count, const std::function<void(int)> &task)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			m_farm.AddTask([this, &task, i]()
+				{
+					task(i);
+					m_done.Signal();
+				});
+		}
+		for (int i = 0; i < count; i++)
+			m_done.Wait();
+	}
+};
 
 FileSystem_FlatFolder::FileSystem_FlatFolder(const string &name, const string &folder, int priority, bool writable, FileExcludes *excludes)
 	: m_name(name), m_rootFolder(folder), m_priority(priority), m_writable(writable), m_excludes(excludes)
 #if defined(PLATFORM_Windows)
     , m_readDirBuffer(0), m_rootFolderHandle(0)
+#elif defined(PLATFORM_Unix)
+	, m_inotifyFD(-1)
 #endif
 {
 	LOG(File, std::format("Mount Flat Folder FS [{}] : {}", name, folder));
+
+	// the index lives beside the folder rather than in it, so it never shows up as one of its files
+	string root = m_rootFolder;
+	while (root.size() > 1 && (root.back() == '/' || root.back() == '\\'))
+		root.pop_back();
+	m_indexPath = root + ".index";
 	Rescan();
 	
 #if defined(PLATFORM_Windows)
@@ -43,6 +117,26 @@ void FileSystem_FlatFolder::EnableMonitorFileChanges(bool enable)
 		}
 		m_monitorFileChanges = enable;
 	}
+#elif defined(PLATFORM_Unix)
+	if (enable && m_inotifyFD < 0)
+	{
+		m_inotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotifyFD < 0)
+		{
+			LOG(File, std::format("Unable to monitor {} - inotify_init1 failed: {}", m_rootFolder, strerror(errno)));
+			return;
+		}
+		for (auto &folder : m_knownFolders)
+			WatchFolder(folder);
+	}
+	else if (!enable && m_inotifyFD >= 0)
+	{
+		close(m_inotifyFD);
+		m_inotifyFD = -1;
+		m_watchFolders.clear();
+		m_changedFiles.clear();
+		m_changedFileSet.clear();
+	}
 #endif
 }
 
@@ -59,6 +153,103 @@ void FileSystem_FlatFolder::StartReadDirCall()
 }
 #endif
 
+#if defined(PLATFORM_Unix)
+void FileSystem_FlatFolder::WatchFolder(const string &folder)
+{
+	if (m_inotifyFD < 0)
+		return;
+
+	// only whole writes (close_write) count as changes, not every partial modify
+	u32 mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR;
+	int wd = inotify_add_watch(m_inotifyFD, folder.c_str(), mask);
+	if (wd < 0)
+		LOG(File, std::format("Unable to watch folder {} : {}", folder, strerror(errno)));
+	else
+		m_watchFolders[wd] = folder;
+}
+
+void FileSystem_FlatFolder::ProcessFolderEvent(const string &folder, const char *name, u32 mask)
+{
+	string path = folder + "/" + name;
+	if (mask & IN_ISDIR)
+	{
+		if (mask & (IN_CREATE | IN_MOVED_TO))
+			ProcessFolderAdded(path);
+		else if (mask & IN_MOVED_FROM)
+			ProcessFolderRemoved(path);
+		return;
+	}
+
+	ProcessFileChange(path, name, (mask & (IN_DELETE | IN_MOVED_FROM)) != 0, (mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0);
+}
+#endif
+
+void FileSystem_FlatFolder::AddChangedFile(const string &name)
+{
+	// coalesce repeated changes to the same file until they are popped
+	if (m_changedFileSet.insert(name).second)
+		m_changedFiles.push_back(name);
+}
+
+void FileSystem_FlatFolder::ProcessFileChange(const string &path, const string &name, bool removed, bool written)
+{
+	auto it = m_files.find(StringHash64(name));
+	if (removed)
+	{
+		// only remove if it is the file we know about, not a duplicate name in another folder
+		if (it != m_files.end() && it->second->fullPath == path)
+		{
+			delete it->second;
+			m_files.erase(it);
+			AddChangedFile(name);
+		}
+	}
+	else if (it == m_files.end())
+	{
+		if (AddScannedEntry(name, path))
+			AddChangedFile(name);
+	}
+	else if (it->second->fullPath == path && written)
+	{
+		AddChangedFile(name);
+	}
+}
+
+void FileSystem_FlatFolder::ProcessFolderAdded(const string &path)
+{
+	// new folder - scan it so files already in it get picked up
+	string name = StringGetFilename(path);
+	if (name.empty() || name[0] == '.' || m_knownFolders.contains(path) || (m_excludes && m_excludes->IsExcluded(name.c_str(), 0, 0)))
+		return;
+
+	stringlist added;
+	ScanFolder(path, &added);
+	for (auto &file : added)
+		AddChangedFile(file);
+}
+
+void FileSystem_FlatFolder::ProcessFolderRemoved(const string &path)
+{
+	// folder moved away - it won't send deletes for its contents
+	// removes for plain files come through here too, so anything that was never scanned as a folder stops here
+	if (!m_knownFolders.erase(path))
+		return;
+
+	string prefix = path + "/";
+	std::erase_if(m_knownFolders, [&prefix](const string &folder) { return folder.starts_with(prefix); });
+	for (auto it = m_files.begin(); it != m_files.end();)
+	{
+		if (it->second->fullPath.starts_with(prefix))
+		{
+			AddChangedFile(it->second->name);
+			delete it->second;
+			it = m_files.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
 bool FileSystem_FlatFolder::PopChangedFile(string &name)
 {
 #if defined(PLATFORM_Windows)
@@ -78,8 +269,25 @@ bool FileSystem_FlatFolder::PopChangedFile(string &name)
 					if (len > 0)
 					{
 						path[len] = 0;
-						name = StringGetFilename(path);
-						m_changedFiles.push_back(name);
+						string fullPath = StringReplace(StringAddPath(m_rootFolder, path), '\\', '/');
+						string fileName = StringGetFilename(fullPath);
+						if (change->Action == FILE_ACTION_REMOVED || change->Action == FILE_ACTION_RENAMED_OLD_NAME)
+						{
+							// a folder renamed away doesn't send removes for its contents - only known folders take the folder path
+							ProcessFolderRemoved(fullPath);
+							ProcessFileChange(fullPath, fileName, true, false);
+						}
+						else
+						{
+							DWORD attributes = GetFileAttributesA(fullPath.c_str());
+							if (attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY))
+							{
+								if (change->Action != FILE_ACTION_MODIFIED)
+									ProcessFolderAdded(fullPath);
+							}
+							else
+								ProcessFileChange(fullPath, fileName, false, true);
+						}
 					}
 				}
 				if (change->NextEntryOffset)
@@ -94,8 +302,50 @@ bool FileSystem_FlatFolder::PopChangedFile(string &name)
 
 		if (!m_changedFiles.empty())
 		{
-			name = m_changedFiles.back();
-			m_changedFiles.pop_back();
+			name = m_changedFiles.front();
+			m_changedFiles.pop_front();
+			m_changedFileSet.erase(name);
+			return true;
+		}
+	}
+#elif defined(PLATFORM_Unix)
+	if (m_inotifyFD >= 0)
+	{
+		alignas(inotify_event) char buffer[4096];
+		ssize_t len;
+		while ((len = read(m_inotifyFD, buffer, sizeof(buffer))) > 0)
+		{
+			for (char *ptr = buffer; ptr < buffer + len;)
+			{
+				auto event = (inotify_event*)ptr;
+				ptr += sizeof(inotify_event) + event->len;
+
+				if (event->mask & IN_Q_OVERFLOW)
+				{
+					// missed some events, so the only safe thing is to start again
+					LOG(File, std::format("File monitor overflow on {} - rescanning", m_rootFolder));
+					Rescan();
+					for (auto &entry : m_files)
+						AddChangedFile(entry.second->name);
+					continue;
+				}
+				if (event->mask & IN_IGNORED)
+				{
+					m_watchFolders.erase(event->wd);
+					continue;
+				}
+
+				auto folder = m_watchFolders.find(event->wd);
+				if (folder != m_watchFolders.end() && event->len > 0)
+					ProcessFolderEvent(folder->second, event->name, event->mask);
+			}
+		}
+
+		if (!m_changedFiles.empty())
+		{
+			name = m_changedFiles.front();
+			m_changedFiles.pop_front();
+			m_changedFileSet.erase(name);
 			return true;
 		}
 	}
@@ -113,6 +363,9 @@ FileSystem_FlatFolder::~FileSystem_FlatFolder()
 		::CloseHandle(m_rootFolderHandle);
 	}
     delete m_readDirBuffer;
+#elif defined(PLATFORM_Unix)
+	if (m_inotifyFD >= 0)
+		close(m_inotifyFD);
 #endif
 	
 	for (auto &entry : m_files)
@@ -122,13 +375,14 @@ FileSystem_FlatFolder::~FileSystem_FlatFolder()
 
 	for (auto &stream : m_activeStreams)
 	{
-		delete stream;
+		fclose(stream.second->fh);
+		delete stream.second;
 	}
 }
 
-bool FileSystem_FlatFolder::Read(const string &name, MemBlock &block)
+bool FileSystem_FlatFolder::Read(const NeoNameKey &name, MemBlock &block)
 {
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto entry = m_files.find(hash);
 	if (entry == m_files.end())
 		return false;
@@ -161,9 +415,9 @@ bool FileSystem_FlatFolder::Read(const string &name, MemBlock &block)
 	return true;
 }
 
-bool FileSystem_FlatFolder::GetAbsolutePath(const string &name, string &path)
+bool FileSystem_FlatFolder::GetAbsolutePath(const NeoNameKey &name, string &path)
 {
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto entry = m_files.find(hash);
 	if (entry == m_files.end())
 		return false;
@@ -176,8 +430,17 @@ bool FileSystem_FlatFolder::Write(const string &name, MemBlock &block)
 	if (!m_writable)
 		return false;
 
+	// replace the existing file wherever it lives in the folder tree
+	// writing a new copy into the root instead would leave the entry pointing at the old file, so reads would
+	// keep returning stale data and the next scan would find two files with the same name
 	string path = StringAddPath(m_rootFolder,name);
-	FILE *fh = fopen(path.c_str(), "wb");
+	auto entry = m_files.find(StringHash64(name));
+	if (entry != m_files.end())
+		path = entry->second->fullPath;
+
+	// write to a temp file and rename it over the real one, so readers only ever see the old file or the complete new one
+	string tempPath = path + FLATFOLDER_TEMP_EXT;
+	FILE *fh = fopen(tempPath.c_str(), "wb");
 	if (fh == 0)
 		return false;
 
@@ -186,7 +449,20 @@ bool FileSystem_FlatFolder::Write(const string &name, MemBlock &block)
 
 	if (writeSize != block.Size())
 	{
-		Error(std::format("ERROR Only wrote {}/{} bytes to file: {}", writeSize, block.Size(), path));
+		Error(std::format("ERROR Only wrote {}/{} bytes to file: {}", writeSize, block.Size(), tempPath));
+		remove(tempPath.c_str());
+		return false;
+	}
+
+#if defined(PLATFORM_Windows)
+	bool replaced = MoveFileExA(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	bool replaced = rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+	if (!replaced)
+	{
+		Error(std::format("ERROR Unable to replace file: {}", path));
+		remove(tempPath.c_str());
 		return false;
 	}
 
@@ -196,16 +472,16 @@ bool FileSystem_FlatFolder::Write(const string &name, MemBlock &block)
 	return true;
 }
 
-bool FileSystem_FlatFolder::Exists(const string &name)
+bool FileSystem_FlatFolder::Exists(const NeoNameKey &name)
 {
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto entry = m_files.find(hash);
 	return (entry != m_files.end());
 }
 
-bool FileSystem_FlatFolder::GetSize(const string &name, u32 &size)
+bool FileSystem_FlatFolder::GetSize(const NeoNameKey &name, u32 &size)
 {
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto entry = m_files.find(hash);
 	if (entry == m_files.end())
 		return false;
@@ -223,25 +499,50 @@ bool FileSystem_FlatFolder::GetSize(const string &name, u32 &size)
 	return true;
 }
 
-bool FileSystem_FlatFolder::GetTime(const string &name, u64 &timestamp)
+bool FileSystem_FlatFolder::GetTime(const NeoNameKey &name, u64 &timestamp)
 {
-	u64 hash = StringHash64(name);
+	u64 hash = name.Hash();
 	auto entry = m_files.find(hash);
 	if (entry == m_files.end())
 		return false;
 
-#if defined(PLATFORM_Windows)
-	HANDLE fh = CreateFile(entry->second->fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-	if (fh != INVALID_HANDLE_VALUE)
+	return GetPathTime(entry->second->fullPath, timestamp);
+}
+
+void FileSystem_FlatFolder::GetFileTimes(vector<std::pair<string, u64>> &times)
+{
+	vector<FileEntry*> entries;
+	entries.reserve(m_files.size());
+	for (auto &it : m_files)
+		entries.push_back(it.second);
+
+	// refresh the times in batches spread over a few threads - this is all syscall latency, so it scales well
+	const int batchSize = 256;
+	int numBatches = (int)((entries.size() + batchSize - 1) / batchSize);
+	auto refreshBatch = [&entries, batchSize](int batch)
+		{
+			size_t end = Min(entries.size(), (size_t)(batch + 1) * batchSize);
+			for (size_t i = (size_t)batch * batchSize; i < end; i++)
+			{
+				if (!GetPathTime(entries[i]->fullPath, entries[i]->time))
+					entries[i]->time = 0;
+			}
+		};
+
+	if (numBatches <= 1)
 	{
-		BY_HANDLE_FILE_INFORMATION info;
-		if (GetFileInformationByHandle(fh, &info))
-			timestamp = ((u64)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
-		CloseHandle(fh);
-		return true;
+		if (numBatches)
+			refreshBatch(0);
 	}
-#endif
-	return false;
+	else
+	{
+		FolderScanFarm timeFarm(numBatches);
+		timeFarm.Run(numBatches, refreshBatch);
+	}
+
+	times.reserve(times.size() + entries.size());
+	for (auto entry : entries)
+		times.emplace_back(entry->name, entry->time);
 }
 
 bool FileSystem_FlatFolder::Delete(const string &name)
@@ -263,9 +564,15 @@ bool FileSystem_FlatFolder::Delete(const string &name)
 	NSString *nsFilePath = [[NSString alloc] initWithUTF8String:entry->second->fullPath.c_str()];
 	if ([fileMgr removeItemAtPath : nsFilePath error : &error] != YES)
 		NSLog(@"Unable to delete file: %@",[error localizedDescription]);
+#elif defined(PLATFORM_Unix)
+	if (remove(entry->second->fullPath.c_str()) != 0)
+	{
+		Error(std::format("Failed to delete file: {}", entry->second->fullPath));
+	}
 #else
 	Error("Platform Not Supported!");
 #endif
+	delete entry->second;
 	m_files.erase(entry);
 
 	return true;
@@ -329,6 +636,20 @@ bool FileSystem_FlatFolder::Rename(const string &oldName, const string &newName)
 	}
 	return true;
 		
+#elif defined(PLATFORM_Unix)
+
+	if (entry->second->fullPath != newPath)
+	{
+		if (rename(entry->second->fullPath.c_str(), newPath.c_str()) == 0)
+		{
+			RemoveEntry(oldName);
+			AddEntry(newName, newPath);
+			return true;
+		}
+		LOG(File, std::format("Failed trying to rename: {} -> {} : {}", entry->second->fullPath, newPath, strerror(errno)));
+	}
+	return false;
+
 #elif defined(PLATFORM_Switch)
     Log("Rename not supported");
     return true;
@@ -390,82 +711,364 @@ void FileSystem_FlatFolder::GetListByFolder(const string &folder, std::vector<st
 	}
 }
 
-void FileSystem_FlatFolder::ScanFolder(const string &folder)
+// on file systems with coarse timestamps a folder can change again without its time moving on,
+// so folders that changed in the last couple of seconds aren't trusted by the index
+static bool IsFolderTimeSettled(u64 time)
+{
+#if defined(PLATFORM_Windows)
+	FILETIME now;
+	GetSystemTimeAsFileTime(&now);
+	return time + 2 * 10000000ull < (((u64)now.dwHighDateTime << 32) | now.dwLowDateTime);
+#elif defined(PLATFORM_Unix)
+	timespec now;
+	clock_gettime(CLOCK_REALTIME, &now);
+	return time + 2 * 1000000000ull < (u64)now.tv_sec * 1000000000ull + now.tv_nsec;
+#else
+	return false;
+#endif
+}
+
+#if defined(PLATFORM_Unix)
+// record returned by getdents64 - one syscall fills a whole buffer of these
+struct LinuxDirent64
+{
+	u64 d_ino;
+	i64 d_off;
+	u16 d_reclen;
+	u8 d_type;
+	char d_name[1];
+};
+#endif
+
+// list the files & sub folders of a single folder, without recursing
+// this doesn't touch m_files, so can be run on several folders at once
+bool FileSystem_FlatFolder::ListFolder(const string &folder, FolderListing &listing)
 {
 #if defined(PLATFORM_Windows)
-	string pattern = folder + "/*.*";
-	_finddata_t buffer;
-	intptr_t handle;
-	if ((handle = _findfirst(pattern.c_str(), &buffer)) != -1)
+	if (!GetPathTime(folder, listing.time))
+		return false;
+
+	string pattern = folder + "/*";
+	WIN32_FIND_DATAA data;
+	HANDLE handle = FindFirstFileExA(pattern.c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+
+	do
 	{
-		do
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			if (data.cFileName[0] != '.' && (!m_excludes || !m_excludes->IsExcluded(data.cFileName, 0, 0)))
+				listing.folders.push_back(StringAddPath(folder, data.cFileName));
+		}
+		else
 		{
-			if (buffer.attrib & _A_SUBDIR)
+			string path = StringReplace(StringAddPath(folder, data.cFileName), '\\', '/');
+			if (!IsExcludedFile(path))
 			{
-				if (buffer.name[0] != '.')
-				{
-					if (!m_excludes || !m_excludes->IsExcluded(buffer.name, 0, 0))
-					{
-						ScanFolder(StringAddPath(folder, buffer.name));
-					}
-				}
+				FileEntry file;
+				file.name = data.cFileName;
+				file.fullPath = path;
+				file.hash = StringHash64(file.name);
+				file.size = ((u64)data.nFileSizeHigh << 32) | data.nFileSizeLow;
+				file.time = ((u64)data.ftLastWriteTime.dwHighDateTime << 32) | data.ftLastWriteTime.dwLowDateTime;
+				listing.files.push_back(file);
 			}
-			else
-			{
-				string path = StringAddPath(folder, buffer.name);
-				string fs, dir, name, ext;
-				StringSplitIntoFileParts(path, &fs, &dir, &name, &ext);
-				if (!m_excludes || !m_excludes->IsExcluded(dir.c_str(), name.c_str(), ext.c_str()))
-				{
-					if (!AddEntry(buffer.name, StringReplace(path, '\\', '/')))
-					{
-						auto existing = m_files.find(StringHash64(buffer.name));
-#if defined(_DEBUG)
-						Error(std::format("Duplicate Files: {} == {}", path, existing->second->fullPath));
-#else
-						LOG(File, std::format("Duplicate Files: {} == {}\n", path, existing->second->fullPath));
-#endif
-					}
-				}
-			} // buffer.attrib & _A_SUBDIR
-		} while (_findnext(handle, &buffer) == 0);
-	}
-	_findclose(handle);
+		}
+	} while (FindNextFileA(handle, &data));
+	FindClose(handle);
 #elif defined(PLATFORM_OSX) || defined(PLATFORM_IOS)
-	NSString * resourcePath = [NSString stringWithUTF8String:folder.CStr()];
+	NSString * resourcePath = [NSString stringWithUTF8String:folder.c_str()];
 	NSError * error;
 	NSArray * directoryContents = [[NSFileManager defaultManager] contentsOfDirectoryAtPath:resourcePath error:&error];
-	string path = [resourcePath UTF8String];
 	for (NSString *item in directoryContents)
 	{
 		string entry = [item UTF8String];
-		string path = folder.AddPath(entry);
-		string fs, dir, name, ext;
-		path.SplitIntoFileParts(&fs, &dir, &name, &ext);
-		if (!m_excludes || !m_excludes->IsExcluded(dir.c_str(), name.c_str(), ext.c_str()))
+		string path = StringAddPath(folder, entry);
+		if (!IsExcludedFile(path))
 		{
-			if (!AddEntry(entry, StringReplace(path, '\\', '/')))
+			FileEntry file;
+			file.name = entry;
+			file.fullPath = StringReplace(path, '\\', '/');
+			file.hash = StringHash64(file.name);
+			listing.files.push_back(file);
+		}
+	}
+#elif defined(PLATFORM_Unix)
+	int fd = open(folder.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) == 0)
+		listing.time = (u64)info.st_mtim.tv_sec * 1000000000ull + info.st_mtim.tv_nsec;
+
+	alignas(8) char buffer[32 * 1024];
+	long bytes;
+	while ((bytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer))) > 0)
+	{
+		for (long offset = 0; offset < bytes;)
+		{
+			LinuxDirent64 *item = (LinuxDirent64*)(buffer + offset);
+			offset += item->d_reclen;
+
+			const char *name = item->d_name;
+			if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0)))
+				continue;
+
+			// regular files want their size & time, and unknown types or links need following
+			struct stat entryInfo;
+			bool hasInfo = false;
+			bool isFolder = (item->d_type == DT_DIR);
+			if (item->d_type == DT_REG || item->d_type == DT_UNKNOWN || item->d_type == DT_LNK)
 			{
-				Error(STR("Unable to add entry: %s",path.CStr()));
+				hasInfo = (fstatat(fd, name, &entryInfo, 0) == 0);
+				isFolder = hasInfo && S_ISDIR(entryInfo.st_mode);
+			}
+
+			string path = folder + "/" + name;
+			if (isFolder)
+			{
+				if (name[0] != '.' && (!m_excludes || !m_excludes->IsExcluded(name, 0, 0)))
+					listing.folders.push_back(path);
+			}
+			else if (!IsExcludedFile(path))
+			{
+				FileEntry file;
+				file.name = name;
+				file.fullPath = path;
+				file.hash = StringHash64(file.name);
+				if (hasInfo)
+				{
+					file.size = (u64)entryInfo.st_size;
+					file.time = (u64)entryInfo.st_mtim.tv_sec * 1000000000ull + entryInfo.st_mtim.tv_nsec;
+				}
+				listing.files.push_back(file);
 			}
 		}
 	}
+	close(fd);
 #elif defined(PLATFORM_Switch)
-    Log("FlatFolder::ScanFolder not implemented");
+    Log("FlatFolder::ListFolder not implemented");
+	return false;
 #else
 #error Platform not supported
 #endif
+
+	if (!IsFolderTimeSettled(listing.time))
+		listing.time = 0;
+	return true;
+}
+
+void FileSystem_FlatFolder::AddFolderListing(const string &folder, const FolderListing &listing, stringlist *added)
+{
+	// same separators as the file entries' full paths, which is what the file monitor reports
+	m_knownFolders.insert(StringReplace(folder, '\\', '/'));
+#if defined(PLATFORM_Unix)
+	WatchFolder(folder);
+#endif
+	for (auto &file : listing.files)
+	{
+		if (!AddEntry(file))
+			ReportDuplicate(file);
+		else if (added)
+			added->push_back(file.name);
+	}
+}
+
+void FileSystem_FlatFolder::ScanFolder(const string &folder, stringlist *added)
+{
+	FolderListing listing;
+	if (!ListFolder(folder, listing))
+		return;
+
+	AddFolderListing(folder, listing, added);
+	for (auto &subFolder : listing.folders)
+		ScanFolder(subFolder, added);
 }
 
 void FileSystem_FlatFolder::Rescan()
 {
+	double startTime = NeoTimeNow;
+
 	for (auto item : m_files)
 	{
 		delete item.second;
 	}
 	m_files.clear();
 
-	ScanFolder(m_rootFolder);
+#if defined(PLATFORM_Unix)
+	// watches are re-added as the folders are scanned
+	if (m_inotifyFD >= 0)
+	{
+		for (auto &watch : m_watchFolders)
+			inotify_rm_watch(m_inotifyFD, watch.first);
+		m_watchFolders.clear();
+	}
+#endif
+	m_knownFolders.clear();
+
+	hashtable<string, FolderListing> oldIndex;
+	bool useIndex = CLV_FolderIndex.Value() && LoadIndex(oldIndex);
+
+	// walk the tree a level at a time - the folders in a level are listed in parallel, then merged in order on this thread
+	// any folder whose write time matches the index reuses the old listing instead of going to disk
+	hashtable<string, FolderListing> newIndex;
+	FolderScanFarm *scanFarm = nullptr;
+	int numListed = 0;
+	vector<string> level = { m_rootFolder };
+	while (!level.empty())
+	{
+		vector<FolderListing> listings(level.size());
+		vector<u8> results(level.size(), 0);
+		auto listFolder = [&](int i)
+			{
+				u64 time;
+				auto cached = useIndex ? oldIndex.find(level[i]) : oldIndex.end();
+				if (cached != oldIndex.end() && cached->second.time != 0 && GetPathTime(level[i], time) && time == cached->second.time)
+				{
+					listings[i] = std::move(cached->second);
+					results[i] = 1;
+				}
+				else if (ListFolder(level[i], listings[i]))
+				{
+					results[i] = 2;
+				}
+			};
+
+		if (level.size() == 1)
+		{
+			listFolder(0);
+		}
+		else
+		{
+			if (!scanFarm)
+				scanFarm = new FolderScanFarm(8);
+			scanFarm->Run((int)level.size(), listFolder);
+		}
+
+		vector<string> nextLevel;
+		for (int i = 0; i < (int)level.size(); i++)
+		{
+			if (results[i] == 0)
+				continue;
+
+			numListed += (results[i] == 2);
+			AddFolderListing(level[i], listings[i]);
+			nextLevel.insert(nextLevel.end(), listings[i].folders.begin(), listings[i].folders.end());
+			newIndex[level[i]] = std::move(listings[i]);
+		}
+		level = std::move(nextLevel);
+	}
+	delete scanFarm;
+
+	if (CLV_FolderIndex.Value() && (numListed > 0 || newIndex.size() != oldIndex.size()))
+		SaveIndex(newIndex);
+
+	LOG(File, std::format("Scanned {} : {} files in {} folders, {} listed from disk in {:.1f}ms", m_rootFolder, m_files.size(), newIndex.size(), numListed, (NeoTimeNow - startTime) * 1000.0));
+}
+
+// index file layout - header, then per folder: path, time, files (name, hash, size, time), sub folders
+struct FolderIndexHeader
+{
+	u32 version;
+	u32 size;
+	u64 excludesSignature;
+};
+
+bool FileSystem_FlatFolder::LoadIndex(hashtable<string, FolderListing> &index)
+{
+	FILE *fh = fopen(m_indexPath.c_str(), "rb");
+	if (!fh)
+		return false;
+
+	// the header size comes off disk - don't trust it beyond what the file actually holds
+	fseek(fh, 0, SEEK_END);
+	u64 fileSize = (u64)ftell(fh);
+	fseek(fh, 0, SEEK_SET);
+
+	FolderIndexHeader header;
+	MemBlock block;
+	bool valid = fread(&header, sizeof(header), 1, fh) == 1
+		&& header.version == FOLDER_INDEX_VERSION
+		&& header.excludesSignature == (m_excludes ? m_excludes->Signature() : 0)
+		&& header.size <= fileSize - sizeof(header)
+		&& block.Resize(header.size)
+		&& fread(block.Mem(), 1, header.size, fh) == header.size;
+	fclose(fh);
+	if (!valid)
+	{
+		LOG(File, std::format("Folder index {} is out of date, rescanning everything", m_indexPath));
+		return false;
+	}
+
+	Serializer_BinaryRead stream(block);
+	u32 numFolders = stream.ReadU32();
+	for (u32 i = 0; i < numFolders; i++)
+	{
+		string folder = stream.ReadString();
+		FolderListing &listing = index[folder];
+		listing.time = stream.ReadU64();
+		u32 numFiles = stream.ReadU32();
+		listing.files.resize(numFiles);
+		for (auto &file : listing.files)
+		{
+			file.name = stream.ReadString();
+			file.fullPath = StringReplace(StringAddPath(folder, file.name), '\\', '/');
+			file.hash = stream.ReadU64();
+			file.size = stream.ReadU64();
+			file.time = stream.ReadU64();
+		}
+		u32 numSubFolders = stream.ReadU32();
+		listing.folders.resize(numSubFolders);
+		for (auto &subFolder : listing.folders)
+			subFolder = stream.ReadString();
+	}
+	return stream.IsGood();
+}
+
+void FileSystem_FlatFolder::SaveIndex(const hashtable<string, FolderListing> &index)
+{
+	Serializer_BinaryWriteGrow stream;
+	stream.WriteU32((u32)index.size());
+	for (auto &it : index)
+	{
+		const FolderListing &listing = it.second;
+		stream.WriteString(it.first);
+		stream.WriteU64(listing.time);
+		stream.WriteU32((u32)listing.files.size());
+		for (auto &file : listing.files)
+		{
+			stream.WriteString(file.name);
+			stream.WriteU64(file.hash);
+			stream.WriteU64(file.size);
+			stream.WriteU64(file.time);
+		}
+		stream.WriteU32((u32)listing.folders.size());
+		for (auto &subFolder : listing.folders)
+			stream.WriteString(subFolder);
+	}
+
+	// write to a temp file and rename it over the old index, so a crash never leaves a half written index behind
+	string tempPath = m_indexPath + ".tmp";
+	FILE *fh = fopen(tempPath.c_str(), "wb");
+	if (!fh)
+	{
+		LOG(File, std::format("Unable to write folder index: {}", tempPath));
+		return;
+	}
+	FolderIndexHeader header = { FOLDER_INDEX_VERSION, stream.DataSize(), m_excludes ? m_excludes->Signature() : 0 };
+	bool written = fwrite(&header, sizeof(header), 1, fh) == 1 && fwrite(stream.DataStart(), 1, stream.DataSize(), fh) == stream.DataSize();
+	fclose(fh);
+
+#if defined(PLATFORM_Windows)
+	remove(m_indexPath.c_str());
+#endif
+	if (!written || rename(tempPath.c_str(), m_indexPath.c_str()) != 0)
+	{
+		LOG(File, std::format("Unable to write folder index: {}", m_indexPath));
+		remove(tempPath.c_str());
+	}
 }
 
 bool FileSystem_FlatFolder::StreamWriteBegin(FileHandle handle, const string &name)
@@ -490,7 +1093,10 @@ bool FileSystem_FlatFolder::StreamWriteBegin(FileHandle handle, const string &na
 		fileStream->fh = fh;
 		fileStream->id = handle;
 		fileStream->mode = FileStream::Write;
-		m_activeStreams.push_back(fileStream);
+		{
+			ScopedMutexLock lock(m_streamLock);
+			m_activeStreams[handle] = fileStream;
+		}
 		return true;
 	}
 	return false;
@@ -498,44 +1104,49 @@ bool FileSystem_FlatFolder::StreamWriteBegin(FileHandle handle, const string &na
 
 bool FileSystem_FlatFolder::StreamWrite(FileHandle handle, u8 *mem, u32 size)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle)
-		{
-			return fwrite(mem, 1, size, fileStream->fh) == size;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	return fwrite(mem, 1, size, fileStream->fh) == size;
 }
 
 bool FileSystem_FlatFolder::StreamFlush(FileHandle handle)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle)
-		{
-			fflush(fileStream->fh);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	fflush(fileStream->fh);
+	return true;
 }
 
 bool FileSystem_FlatFolder::StreamWriteEnd(FileHandle handle)
 {
-	for (auto it = m_activeStreams.begin(); it != m_activeStreams.end(); ++it)
+	FileStream *fileStream;
 	{
-		FileStream *fileStream = *it;
-		if (fileStream->id == handle && fileStream->mode == FileStream::Write)
-		{
-			fclose(fileStream->fh);
-			AddEntry(fileStream->name, fileStream->path);
-			delete fileStream;
-			m_activeStreams.erase(it);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Write)
+			return false;
+		fileStream = it->second;
+		m_activeStreams.erase(it);
 	}
-	return false;
+
+	fclose(fileStream->fh);
+	AddEntry(fileStream->name, fileStream->path);
+	delete fileStream;
+	return true;
 }
 
 bool FileSystem_FlatFolder::StreamReadBegin(FileHandle handle, const string &name)
@@ -553,7 +1164,10 @@ bool FileSystem_FlatFolder::StreamReadBegin(FileHandle handle, const string &nam
 		fileStream->fh = fh;
 		fileStream->id = handle;
 		fileStream->mode = FileStream::Read;
-		m_activeStreams.push_back(fileStream);
+		{
+			ScopedMutexLock lock(m_streamLock);
+			m_activeStreams[handle] = fileStream;
+		}
 		return true;
 	}
 	return false;
@@ -561,61 +1175,105 @@ bool FileSystem_FlatFolder::StreamReadBegin(FileHandle handle, const string &nam
 
 bool FileSystem_FlatFolder::StreamRead(FileHandle handle, u8 *mem, u32 size, u32 &sizeRead)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle && fileStream->mode == FileStream::Read)
-		{
-			sizeRead = (u32)fread(mem, 1, size, fileStream->fh);
-			return sizeRead > 0;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Read)
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	sizeRead = (u32)fread(mem, 1, size, fileStream->fh);
+	return sizeRead > 0;
 }
 
 bool FileSystem_FlatFolder::StreamReadEnd(FileHandle handle)
 {
-	for (auto it = m_activeStreams.begin(); it != m_activeStreams.end(); ++it)
+	FileStream *fileStream;
 	{
-		FileStream *fileStream = *it;
-		if (fileStream->id == handle && fileStream->mode == FileStream::Read)
-		{
-			fclose(fileStream->fh);
-			delete fileStream;
-			m_activeStreams.erase(it);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Read)
+			return false;
+		fileStream = it->second;
+		m_activeStreams.erase(it);
 	}
-	return false;
+
+	fclose(fileStream->fh);
+	delete fileStream;
+	return true;
+}
+
+bool FileSystem_FlatFolder::IsExcludedFile(const string &path)
+{
+	// a write in progress (or left behind by a crash) - the monitor sees these come and go inside the tree
+	if (path.ends_with(FLATFOLDER_TEMP_EXT))
+		return true;
+
+	if (!m_excludes)
+		return false;
+
+	string fs, dir, name, ext;
+	StringSplitIntoFileParts(path, &fs, &dir, &name, &ext);
+	return m_excludes->IsExcluded(dir.c_str(), name.c_str(), ext.c_str());
+}
+
+// add a file found while scanning, if it isn't excluded
+bool FileSystem_FlatFolder::AddScannedEntry(const string &filename, const string &path)
+{
+	if (IsExcludedFile(path))
+		return false;
+
+	FileEntry file;
+	file.name = filename;
+	file.fullPath = path;
+	file.hash = StringHash64(filename);
+	if (!AddEntry(file))
+	{
+		ReportDuplicate(file);
+		return false;
+	}
+	return true;
+}
+
+void FileSystem_FlatFolder::ReportDuplicate(const FileEntry &file)
+{
+	auto existing = m_files.find(file.hash);
+#if defined(_DEBUG)
+	Error(std::format("Duplicate Files: {} == {}", file.fullPath, existing->second->fullPath));
+#else
+	LOG(File, std::format("Duplicate Files: {} == {}\n", file.fullPath, existing->second->fullPath));
+#endif
 }
 
 bool FileSystem_FlatFolder::AddEntry(const string &name, const string &path)
 {
 	//DMLOG("Add Entry: %s,  %s",name.CStr(),path.CStr());
 	
-	FileEntry *entry = new FileEntry;
-	entry->name = name;
-	entry->fullPath = path;
-	if (!m_files.insert(std::pair<u64, FileEntry*>(StringHash64(name), entry)).second)
-	{
-		delete entry;
+	FileEntry file;
+	file.name = name;
+	file.fullPath = path;
+	file.hash = StringHash64(name);
+	return AddEntry(file);
+}
+
+bool FileSystem_FlatFolder::AddEntry(const FileEntry &file)
+{
+	if (m_files.find(file.hash) != m_files.end())
 		return false;
-	}
+
+	m_files.insert(std::pair<u64, FileEntry*>(file.hash, new FileEntry(file)));
 	return true;
 }
 
 bool FileSystem_FlatFolder::RemoveEntry(const string &name)
 {
-	bool found = false;
-	auto it = m_files.begin();
-	while (it != m_files.end())
-	{
-		if (it->second->name == name)
-		{
-			it = m_files.erase(it);
-			found = true;
-		}
-		else
-			++it;
-	}
+	auto it = m_files.find(StringHash64(name));
+	if (it == m_files.end())
+		return false;
+
+	delete it->second;
+	m_files.erase(it);
 	return true;
 }
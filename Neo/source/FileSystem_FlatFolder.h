@@ -2,6 +2,7 @@
 
 #include "FileSystem.h"
 #include "FileExcludes.h"
+#include "Thread.h"
 #include <map>
 
 class FileSystem_FlatFolder : public FileSystem
@@ -16,12 +17,13 @@ public:
 	virtual int Priority() const { return m_priority; }
 	virtual const string &Name() const { return m_name; }
 
-	virtual bool GetAbsolutePath(const string &name, string &path);
-	virtual bool Read(const string &name, MemBlock &block);
+	virtual bool GetAbsolutePath(const NeoNameKey &name, string &path);
+	virtual bool Read(const NeoNameKey &name, MemBlock &block);
 	virtual bool Write(const string &name, MemBlock &block);
-	virtual bool Exists(const string &name);
-	virtual bool GetSize(const string &name, u32 &size);
-	virtual bool GetTime(const string &name, u64 &time);
+	virtual bool Exists(const NeoNameKey &name);
+	virtual bool GetSize(const NeoNameKey &name, u32 &size);
+	virtual bool GetTime(const NeoNameKey &name, u64 &time);
+	virtual void GetFileTimes(vector<std::pair<string, u64>> &times);
 	virtual bool Delete(const string &name);
 	virtual bool Rename(const string &oldName, const string &newName);
 	virtual void GetListByExt(const string &ext, std::vector<string> &list);
@@ -42,16 +44,41 @@ public:
 	virtual bool PopChangedFile(string &name);
 
 protected:
-	void ScanFolder(const string &folder);
-	bool AddEntry(const string &name, const string &path);
-	bool RemoveEntry(const string &name);
-
 	struct FileEntry
 	{
 		string name;
 		string fullPath;
+		u64 hash = 0;
+		u64 size = 0;
+		u64 time = 0;		// last write time when the folder was scanned
+	};
+
+	// contents of a single folder, as listed from disk or loaded from the index
+	struct FolderListing
+	{
+		u64 time = 0;				// folder write time - changes when files are added, removed or renamed in it
+		vector<FileEntry> files;
+		vector<string> folders;		// full paths of sub folders
 	};
+
+	// added collects the names of files that weren't already known
+	void ScanFolder(const string &folder, stringlist *added = nullptr);
+	bool ListFolder(const string &folder, FolderListing &listing);
+	void AddFolderListing(const string &folder, const FolderListing &listing, stringlist *added = nullptr);
+	bool IsExcludedFile(const string &path);
+	bool AddScannedEntry(const string &name, const string &path);
+	bool AddEntry(const string &name, const string &path);
+	bool AddEntry(const FileEntry &file);
+	void ReportDuplicate(const FileEntry &file);
+	bool RemoveEntry(const string &name);
+
+	// folder scans are saved to an index file beside the folder, and reused for any folder whose write time hasn't changed
+	bool LoadIndex(hashtable<string, FolderListing> &index);
+	void SaveIndex(const hashtable<string, FolderListing> &index);
+	string m_indexPath;
+
 	std::map<u64, FileEntry*> m_files;
+	hashset<string> m_knownFolders;		// full path of every scanned folder, so removes can tell folders from files without a full walk
 	bool m_writable;
 	int m_priority;
 	string m_name;
@@ -70,7 +97,8 @@ protected:
 		} mode;
 		FILE *fh;
 	};
-	std::vector<FileStream*> m_activeStreams;
+	hashtable<FileHandle, FileStream*> m_activeStreams;
+	Mutex m_streamLock;		// streams are read & written outside the FileManager lock, so the stream table has its own
 
 #if defined(PLATFORM_Windows)
 	bool m_monitorFileChanges;
@@ -79,6 +107,19 @@ protected:
 	u8 *m_readDirBuffer;
 	DWORD m_readDirBytesRead;
 	OVERLAPPED m_readDirOverlapped;
-	std::vector<string> m_changedFiles;
+#elif defined(PLATFORM_Unix)
+	// inotify isn't recursive, so every sub folder gets its own watch
+	int m_inotifyFD;
+	hashtable<int, string> m_watchFolders;
+	void WatchFolder(const string &folder);
+	void ProcessFolderEvent(const string &folder, const char *name, u32 mask);
 #endif
+
+	// changes from the file monitor - m_files is kept up to date as they arrive, and the names queue up for PopChangedFile
+	fifo<string> m_changedFiles;
+	hashset<string> m_changedFileSet;		// what's in m_changedFiles, so repeated changes coalesce
+	void AddChangedFile(const string &name);
+	void ProcessFileChange(const string &path, const string &name, bool removed, bool written);
+	void ProcessFolderAdded(const string &path);
+	void ProcessFolderRemoved(const string &path);
 };
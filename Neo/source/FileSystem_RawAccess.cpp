@@ -10,13 +10,14 @@ FileSystem_RawAccess::FileSystem_RawAccess(const string &name, int priority, boo
 
 FileSystem_RawAccess::~FileSystem_RawAccess()
 {
-	for (auto fstream : m_activeStreams)
+	for (auto &stream : m_activeStreams)
 	{
-		fclose(fstream->fh);
+		fclose(stream.second->fh);
+		delete stream.second;
 	}
 }
 
-bool FileSystem_RawAccess::Read(const string &name, MemBlock &block)
+bool FileSystem_RawAccess::Read(const NeoNameKey &name, MemBlock &block)
 {
 	FILE *fh = fopen(name.c_str(), "rb");
 	if (!fh)
@@ -41,9 +42,9 @@ bool FileSystem_RawAccess::Read(const string &name, MemBlock &block)
 	return true;
 }
 
-bool FileSystem_RawAccess::GetAbsolutePath(const string &name, string &path)
+bool FileSystem_RawAccess::GetAbsolutePath(const NeoNameKey &name, string &path)
 {
-	path = name;
+	path = name.String();
 	FILE *fh = fopen(name.c_str(), "rb");
 	if (!fh)
 		return false;
@@ -71,7 +72,7 @@ bool FileSystem_RawAccess::Write(const string &name, MemBlock &block)
 	return true;
 }
 
-bool FileSystem_RawAccess::Exists(const string &name)
+bool FileSystem_RawAccess::Exists(const NeoNameKey &name)
 {
 	FILE *fh = fopen(name.c_str(), "rb");
 	if (fh == 0)
@@ -80,7 +81,7 @@ bool FileSystem_RawAccess::Exists(const string &name)
 	return true;
 }
 
-bool FileSystem_RawAccess::GetSize(const string &name, u32 &size)
+bool FileSystem_RawAccess::GetSize(const NeoNameKey &name, u32 &size)
 {
 	FILE *fh = fopen(name.c_str(), "rb");
 	if (!fh)
@@ -92,7 +93,7 @@ bool FileSystem_RawAccess::GetSize(const string &name, u32 &size)
 	return true;
 }
 
-bool FileSystem_RawAccess::GetTime(const string &name, u64 &timestamp)
+bool FileSystem_RawAccess::GetTime(const NeoNameKey &name, u64 &timestamp)
 {
 #if defined(PLATFORM_Windows)
 	HANDLE fh = CreateFileA(name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -258,7 +259,10 @@ bool FileSystem_RawAccess::StreamWriteBegin(FileHandle handle, const string &pat
 		fileStream->fh = fh;
 		fileStream->id = handle;
 		fileStream->mode = FileStream::Write;
-		m_activeStreams.push_back(fileStream);
+		{
+			ScopedMutexLock lock(m_streamLock);
+			m_activeStreams[handle] = fileStream;
+		}
 		return true;
 	}
 	return false;
@@ -266,43 +270,48 @@ bool FileSystem_RawAccess::StreamWriteBegin(FileHandle handle, const string &pat
 
 bool FileSystem_RawAccess::StreamWrite(FileHandle handle, u8 *mem, u32 size)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle)
-		{
-			return fwrite(mem, 1, size, fileStream->fh) == size;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	return fwrite(mem, 1, size, fileStream->fh) == size;
 }
 
 bool FileSystem_RawAccess::StreamFlush(FileHandle handle)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle)
-		{
-			fflush(fileStream->fh);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end())
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	fflush(fileStream->fh);
+	return true;
 }
 
 bool FileSystem_RawAccess::StreamWriteEnd(FileHandle handle)
 {
-	for (auto it = m_activeStreams.begin(); it != m_activeStreams.end(); ++it)
+	FileStream *fileStream;
 	{
-		FileStream *fileStream = *it;
-		if (fileStream->id == handle && fileStream->mode == FileStream::Write)
-		{
-			fclose(fileStream->fh);
-			delete fileStream;
-			m_activeStreams.erase(it);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Write)
+			return false;
+		fileStream = it->second;
+		m_activeStreams.erase(it);
 	}
-	return false;
+
+	fclose(fileStream->fh);
+	delete fileStream;
+	return true;
 }
 
 bool FileSystem_RawAccess::StreamReadBegin(FileHandle handle, const string &path)
@@ -315,7 +324,10 @@ bool FileSystem_RawAccess::StreamReadBegin(FileHandle handle, const string &path
 		fileStream->fh = fh;
 		fileStream->id = handle;
 		fileStream->mode = FileStream::Read;
-		m_activeStreams.push_back(fileStream);
+		{
+			ScopedMutexLock lock(m_streamLock);
+			m_activeStreams[handle] = fileStream;
+		}
 		return true;
 	}
 	return false;
@@ -323,29 +335,32 @@ bool FileSystem_RawAccess::StreamReadBegin(FileHandle handle, const string &path
 
 bool FileSystem_RawAccess::StreamRead(FileHandle handle, u8 *mem, u32 size, u32 &sizeRead)
 {
-	for (auto fileStream : m_activeStreams)
+	FileStream *fileStream;
 	{
-		if (fileStream->id == handle && fileStream->mode == FileStream::Read)
-		{
-			sizeRead = (u32)fread(mem, 1, size, fileStream->fh);
-			return sizeRead > 0;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Read)
+			return false;
+		fileStream = it->second;
 	}
-	return false;
+
+	sizeRead = (u32)fread(mem, 1, size, fileStream->fh);
+	return sizeRead > 0;
 }
 
 bool FileSystem_RawAccess::StreamReadEnd(FileHandle handle)
 {
-	for (auto it = m_activeStreams.begin(); it != m_activeStreams.end(); ++it)
+	FileStream *fileStream;
 	{
-		FileStream *fileStream = *it;
-		if (fileStream->id == handle && fileStream->mode == FileStream::Read)
-		{
-			fclose(fileStream->fh);
-			delete fileStream;
-			m_activeStreams.erase(it);
-			return true;
-		}
+		ScopedMutexLock lock(m_streamLock);
+		auto it = m_activeStreams.find(handle);
+		if (it == m_activeStreams.end() || it->second->mode != FileStream::Read)
+			return false;
+		fileStream = it->second;
+		m_activeStreams.erase(it);
 	}
-	return false;
+
+	fclose(fileStream->fh);
+	delete fileStream;
+	return true;
 }
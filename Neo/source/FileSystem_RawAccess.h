@@ -2,6 +2,7 @@
 
 #include "FileSystem.h"
 #include "FileExcludes.h"
+#include "Thread.h"
 
 class FileSystem_RawAccess : public FileSystem
 {
@@ -15,12 +16,12 @@ public:
 	virtual int Priority() const { return m_priority; }
 	virtual const string &Name() const { return m_name; }
 
-	virtual bool GetAbsolutePath(const string &name, string &path);
-	virtual bool Read(const string &name, MemBlock &block);
+	virtual bool GetAbsolutePath(const NeoNameKey &name, string &path);
+	virtual bool Read(const NeoNameKey &name, MemBlock &block);
 	virtual bool Write(const string &name, MemBlock &block);
-	virtual bool Exists(const string &name);
-	virtual bool GetSize(const string &name, u32 &size);
-	virtual bool GetTime(const string &name, u64 &time);
+	virtual bool Exists(const NeoNameKey &name);
+	virtual bool GetSize(const NeoNameKey &name, u32 &size);
+	virtual bool GetTime(const NeoNameKey &name, u64 &time);
 	virtual bool Delete(const string &name);
 	virtual bool Rename(const string &oldName, const string &newName);
 	virtual void GetListByExt(const string &ext, std::vector<string> &list);
@@ -56,5 +57,6 @@ protected:
 		} mode;
 		FILE *fh;
 	};
-	std::vector<FileStream*> m_activeStreams;
+	hashtable<FileHandle, FileStream*> m_activeStreams;
+	Mutex m_streamLock;		// streams are read & written outside the FileManager lock, so the stream table has its own
 };
@@ -0,0 +1,207 @@
+#include "Neo.h"
+#include "LZCodec.h"
+#include "MathUtils.h"
+
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_LAST_LITERALS 5		// last bytes of a block are always literals
+#define LZ_MATCH_SAFE_END 12	// no match can start within this many bytes of the end
+#define LZ_HASH_BITS 14
+
+static inline u32 LZ_Read32(const u8* p)
+{
+	u32 value;
+	memcpy(&value, p, 4);
+	return value;
+}
+
+static inline u32 LZ_Hash(u32 sequence)
+{
+	return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// write a 15+ length as a run of extra bytes
+static inline u8* LZ_WriteLength(u8* op, size_t length)
+{
+	while (length >= 255)
+	{
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = (u8)length;
+	return op;
+}
+
+static inline bool LZ_ReadLength(const u8*& ip, const u8* iend, size_t& length)
+{
+	u8 b;
+	do
+	{
+		if (ip >= iend)
+			return false;
+		b = *ip++;
+		length += b;
+	} while (b == 255);
+	return true;
+}
+
+size_t LZ_CompressBound(size_t srcSize)
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+size_t LZ_Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize)
+{
+	const u8* ip = src;
+	const u8* anchor = src;
+	const u8* iend = src + srcSize;
+	u8* op = dest;
+	u8* oend = dest + destSize;
+
+	if (srcSize > LZ_MATCH_SAFE_END)
+	{
+		const u8* matchLimit = iend - LZ_LAST_LITERALS;
+		const u8* mflimit = iend - LZ_MATCH_SAFE_END;
+
+		// positions of the last time each 4 byte sequence was seen
+		static thread_local u32 hashTable[1 << LZ_HASH_BITS];
+		memset(hashTable, 0, sizeof(hashTable));
+
+		ip++;
+		while (ip < mflimit)
+		{
+			u32 sequence = LZ_Read32(ip);
+			u32 hash = LZ_Hash(sequence);
+			const u8* ref = src + hashTable[hash];
+			hashTable[hash] = (u32)(ip - src);
+
+			if (ref >= ip || ip - ref > LZ_MAX_OFFSET || LZ_Read32(ref) != sequence)
+			{
+				// skip faster through data that isn't matching
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			// extend the match backwards into the pending literals, then forwards
+			while (ip > anchor && ref > src && ip[-1] == ref[-1])
+			{
+				ip--;
+				ref--;
+			}
+			const u8* matchEnd = ip + LZ_MIN_MATCH;
+			const u8* refEnd = ref + LZ_MIN_MATCH;
+			while (matchEnd < matchLimit && *matchEnd == *refEnd)
+			{
+				matchEnd++;
+				refEnd++;
+			}
+
+			size_t literals = ip - anchor;
+			size_t matchLength = (matchEnd - ip) - LZ_MIN_MATCH;
+			if ((size_t)(oend - op) < 1 + literals + literals / 255 + 1 + 2 + matchLength / 255 + 1)
+				return 0;
+
+			u8* token = op++;
+			*token = (u8)(Min(literals, (size_t)15) << 4);
+			if (literals >= 15)
+				op = LZ_WriteLength(op, literals - 15);
+			memcpy(op, anchor, literals);
+			op += literals;
+
+			size_t offset = ip - ref;
+			*op++ = (u8)offset;
+			*op++ = (u8)(offset >> 8);
+			*token |= (u8)Min(matchLength, (size_t)15);
+			if (matchLength >= 15)
+				op = LZ_WriteLength(op, matchLength - 15);
+
+			ip = matchEnd;
+			anchor = ip;
+
+			// seed the table with a position inside the match so runs chain together
+			if (ip < mflimit)
+				hashTable[LZ_Hash(LZ_Read32(ip - 2))] = (u32)(ip - 2 - src);
+		}
+	}
+
+	// final literals
+	size_t literals = iend - anchor;
+	if ((size_t)(oend - op) < 1 + literals + literals / 255 + 1)
+		return 0;
+	*op++ = (u8)(Min(literals, (size_t)15) << 4);
+	if (literals >= 15)
+		op = LZ_WriteLength(op, literals - 15);
+	memcpy(op, anchor, literals);
+	op += literals;
+
+	return op - dest;
+}
+
+bool LZ_Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize)
+{
+	const u8* ip = src;
+	const u8* iend = src + srcSize;
+	u8* op = dest;
+	u8* oend = dest + destSize;
+
+	while (ip < iend)
+	{
+		u8 token = *ip++;
+
+		// literals
+		size_t literals = token >> 4;
+		if (literals == 15 && !LZ_ReadLength(ip, iend, literals))
+			return false;
+		if (literals > (size_t)(iend - ip) || literals > (size_t)(oend - op))
+			return false;
+		memcpy(op, ip, literals);
+		op += literals;
+		ip += literals;
+
+		// last sequence has no match
+		if (ip == iend)
+			break;
+
+		// match
+		if (iend - ip < 2)
+			return false;
+		size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > (size_t)(op - dest))
+			return false;
+
+		size_t length = token & 15;
+		if (length == 15 && !LZ_ReadLength(ip, iend, length))
+			return false;
+		length += LZ_MIN_MATCH;
+		if (length > (size_t)(oend - op))
+			return false;
+
+		const u8* ref = op - offset;
+		if (offset >= length)
+		{
+			memcpy(op, ref, length);
+			op += length;
+		}
+		else if (offset >= 8)
+		{
+			// overlapping, but each 8 byte step only reads bytes already written
+			u8* matchEnd = op + length;
+			while (matchEnd - op >= 8)
+			{
+				memcpy(op, ref, 8);
+				op += 8;
+				ref += 8;
+			}
+			while (op < matchEnd)
+				*op++ = *ref++;
+		}
+		else
+		{
+			// short repeating pattern
+			for (size_t i = 0; i < length; i++)
+				*op++ = *ref++;
+		}
+	}
+	return op == oend;
+}
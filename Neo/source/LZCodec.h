@@ -0,0 +1,25 @@
+#pragma once
+
+/**************************************************************************
+LZCodec  -  small, fast LZ77 byte codec (LZ4 block style)
+
+favours decode speed over compression ratio.
+the stream is a list of sequences:
+    token      - high nibble literal count, low nibble match length - 4 (15 = more length bytes follow)
+    [length]   - extra literal length bytes, each 255 means keep reading
+    literals
+    offset     - u16 little endian distance back to the match
+    [length]   - extra match length bytes
+the final sequence is literals only.
+
+***************************************************************************/
+
+// worst case compressed size for a block of srcSize bytes
+size_t LZ_CompressBound(size_t srcSize);
+
+// compress src into dest, returns compressed size, or 0 if it didn't fit in destSize
+size_t LZ_Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize);
+
+// decompress src into dest, destSize must be the exact decompressed size
+// returns false on corrupt data - never reads or writes outside the supplied buffers
+bool LZ_Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize);
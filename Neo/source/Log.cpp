@@ -1,6 +1,8 @@
 #include "Neo.h"
 #include "Log.h"
 #include "StringUtils.h"
+#include "TimeManager.h"
+#include <atomic>
 
 CmdLineVar<bool> CLV_EnableLogging("logenable","enable logging",true);
 CmdLineVar<string> CLV_LogFile("logfile", "set path to log file", "local:log.txt");
@@ -11,6 +13,13 @@ bool __NeoLogFilteringEnabled = false;
 static set<string> s_filtersEnabled;
 static FileHandle s_logHandle;
 
+// lines are buffered, but pushed out at least this often so startup and hangs still leave a log on disk
+static const double LogFlushInterval = 0.1;
+static std::atomic<double> s_lastLogFlush = 0.0;
+
+// stops the file manager logging back into the log while it's writing it
+static thread_local bool s_writingLog = false;
+
 void NeoSetLogFilters(const stringlist& filters)
 {
 	s_filtersEnabled.clear();
@@ -29,8 +38,22 @@ bool NeoLogEnabled(const string& filter)
 
 void NeoEnableFileLogging()
 {
-	if (CLV_EnableLogging.Value())
-		FileManager::Instance().StreamWriteBegin(s_logHandle, CLV_LogFile.Value());
+	if (CLV_EnableLogging.Value() && FileManager::Instance().StreamWriteBegin(s_logHandle, CLV_LogFile.Value()))
+	{
+		// log lines are buffered - push them out to the file once a frame as well as every LogFlushInterval
+		NeoAddBeginUpdateTask([]() { NeoFlushLog(); }, 0);
+	}
+}
+
+void NeoFlushLog()
+{
+	if (s_logHandle != nullFileHandle && !s_writingLog)
+	{
+		s_writingLog = true;
+		s_lastLogFlush = NeoTimeNow;
+		FileManager::Instance().StreamFlush(s_logHandle);
+		s_writingLog = false;
+	}
 }
 
 void NeoLog(const string& filter, const string& text)
@@ -41,9 +64,13 @@ void NeoLog(const string& filter, const string& text)
 #if defined(PLATFORM_Windows)
 	OutputDebugString(outStr.c_str());
 #endif
-	if (s_logHandle != nullFileHandle)
+	if (s_logHandle != nullFileHandle && !s_writingLog)
 	{
+		s_writingLog = true;
 		FileManager::Instance().StreamWrite(s_logHandle, outStr);
-		FileManager::Instance().StreamFlush(s_logHandle);
+		s_writingLog = false;
+
+		if (NeoTimeNow - s_lastLogFlush >= LogFlushInterval)
+			NeoFlushLog();
 	}
 }
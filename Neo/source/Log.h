@@ -1,6 +1,7 @@
 #pragma once
 
 extern void NeoEnableFileLogging();
+extern void NeoFlushLog();
 extern void NeoSetLogFilters(const stringlist& filters);
 extern void NeoEnableLogFiltering(bool enable);
 extern bool NeoLogEnabled(const string &filter);
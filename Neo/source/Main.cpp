@@ -87,6 +87,9 @@ void Error(const string& msg)
     OutputDebugStringA(errorStr.c_str());
 #endif
 
+    // the log is buffered - get the lines leading up to this out before we break
+    NeoFlushLog();
+
     if (Thread::IsOnThread(ThreadGUID_Main) && GIL::Exists())
     {
         if (PIL::Instance().ShowMessageBox(errorStr))
@@ -0,0 +1,106 @@
+#include "Neo.h"
+#include "MappedFile.h"
+#include "FileManager.h"
+
+#if defined(PLATFORM_Unix) || defined(PLATFORM_OSX) || defined(PLATFORM_IOS) || defined(PLATFORM_Android)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#define MAPPEDFILE_POSIX
+#endif
+
+bool MappedFile::Open(const string &name)
+{
+	Close();
+
+	FileManager &fm = FileManager::Instance();
+	string path;
+	if (fm.GetAbsolutePath(name, path) && Map(path))
+		return true;
+
+	// archives and anything else that doesn't sit on disk as a plain file
+	if (!fm.Read(name, m_readMem))
+		return false;
+	m_mem = m_readMem.Mem();
+	m_size = m_readMem.Size();
+	return m_mem != nullptr;
+}
+
+bool MappedFile::OpenAbsolute(const string &path)
+{
+	Close();
+	return Map(path);
+}
+
+bool MappedFile::Map(const string &path)
+{
+#if defined(PLATFORM_Windows)
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	void *view = m_mapping ? MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		Close();
+		return false;
+	}
+	m_mem = (const u8*)view;
+	m_size = (size_t)size.QuadPart;
+	m_mapped = true;
+	return true;
+#elif defined(MAPPEDFILE_POSIX)
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	// the mapping holds its own reference to the file, so the descriptor can go straight away
+	struct stat info;
+	void *view = MAP_FAILED;
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+		view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (view == MAP_FAILED)
+		return false;
+
+	m_mem = (const u8*)view;
+	m_size = (size_t)info.st_size;
+	m_mapped = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void MappedFile::Close()
+{
+	if (m_mapped)
+	{
+#if defined(PLATFORM_Windows)
+		UnmapViewOfFile(m_mem);
+#elif defined(MAPPEDFILE_POSIX)
+		munmap((void*)m_mem, m_size);
+#endif
+	}
+#if defined(PLATFORM_Windows)
+	if (m_mapping)
+		CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+	m_mapping = NULL;
+	m_file = INVALID_HANDLE_VALUE;
+#endif
+
+	m_readMem = MemBlock();
+	m_mem = nullptr;
+	m_size = 0;
+	m_mapped = false;
+}
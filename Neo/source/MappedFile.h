@@ -0,0 +1,53 @@
+#pragma once
+
+/**************************************************************************
+MappedFile  -  read only memory mapped view of a whole file
+
+the os pages the file in as it's touched, so opening is just a couple of
+system calls no matter how big the file is.
+files that only live in an archive can't be mapped - Open falls back to
+reading them into memory, so callers don't need to care which they got.
+
+***************************************************************************/
+
+#include "Neo.h"
+#include "MemBlock.h"
+
+class MappedFile
+{
+public:
+	MappedFile() {}
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// name goes through the FileManager like any other read
+	bool Open(const string &name);
+
+	// a file outside the mounted file systems (ie. the derived data cache) - no read fallback
+	bool OpenAbsolute(const string &path);
+	void Close();
+
+	bool IsOpen() const { return m_mem != nullptr; }
+	bool IsMapped() const { return m_mapped; }
+
+	const u8 *Mem() const { return m_mem; }
+	size_t Size() const { return m_size; }
+
+	// external block over the view - only valid while the file stays open
+	MemBlock AsBlock() const { return MemBlock((u8*)m_mem, m_size, true); }
+
+protected:
+	bool Map(const string &path);
+
+	const u8 *m_mem = nullptr;
+	size_t m_size = 0;
+	bool m_mapped = false;
+	MemBlock m_readMem;		// fallback when the file can't be mapped
+
+#if defined(PLATFORM_Windows)
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = NULL;
+#endif
+};
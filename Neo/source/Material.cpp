@@ -1,7 +1,7 @@
 #include "Neo.h"
 #include "Material.h"
 #include "StringUtils.h"
-#include "SHAD.h"
+#include "SHADBinary.h"
 #include "ResourceLoadedManager.h"
 #include "ShaderManager.h"
 
@@ -11,35 +11,107 @@ DECLARE_MODULE(MaterialFactory, NeoModuleInitPri_MaterialFactory, NeoModulePri_N
 
 const string Material::AssetType = "Material";
 
-void Material::SetUniform(const string& name, VarType type, const void *data, bool flush)
+MaterialUniformHandle Material::FindUniform(NeoName name, RenderPass* renderPass)
 {
-	Assert(Thread::GetCurrentThreadGUID() == ThreadGUID_Render, "Must run on render thread because it uses active render pass!");
 	Assert(IsLoaded(), STR("Attempt to use material {} before it finished loading", name));
 
-	auto& gil = GIL::Instance();
-	auto activeRP = gil.GetActiveRenderPass();
-	Assert(activeRP, "Cannot set a uniform if there is no active renderpass set");
+	MaterialUniformHandle handle;
+	handle.name = name;
+	u32 generation = m_assetGeneration.load();
+
+	if (!renderPass)
+	{
+		Assert(Thread::GetCurrentThreadGUID() == ThreadGUID_Render, "Must run on render thread to use the active render pass!");
+		renderPass = GIL::Instance().GetActiveRenderPass();
+		Assert(renderPass, "Cannot find a uniform if there is no active renderpass set");
+	}
 
-	for (auto rp : m_assetData->renderPasses)
+	for (u32 rpIdx = 0; rpIdx < (u32)m_assetData->renderPasses.size(); rpIdx++)
 	{
-		if (rp->renderPass == activeRP)
+		auto rp = m_assetData->renderPasses[rpIdx];
+		if (rp->renderPass == renderPass)
 		{
 			for (auto mbo : rp->buffers)
 			{
 				for (auto& uniform : mbo->uniforms)
 				{
-					if (StringEqual(uniform.uboMember->name, name))
+					if (uniform.uboMember->name.EqualNoCase(name))
 					{
-						Assert(uniform.uboMember->type == type, STR("Type mismatch setting uniform {} in material {}", name, m_name));
-						GIL::Instance().UpdateUBOInstanceMember(mbo->uboInstance, uniform.uboMember->offset, data, uniform.uboMember->datasize, flush);
-						return;
+						handle.renderPassIndex = rpIdx;
+						handle.uboInstance = mbo->uboInstance;
+						handle.offset = uniform.uboMember->offset;
+						handle.datasize = uniform.uboMember->datasize;
+						handle.type = uniform.uboMember->type;
+
+						// only stamped once found, so a missing uniform is looked for again next time
+						handle.generation = generation;
+						return handle;
 					}
 				}
 			}
 			Error(STR("uniform {} not found in material {}", name, m_name));
+			return handle;
 		}
 	}
-	Error(STR("renderpass {} not supported in material {}", activeRP->GetName(), m_assetData->name));
+	Error(STR("renderpass {} not supported in material {}", renderPass->GetName(), m_assetData->name));
+	return handle;
+}
+
+void Material::SetUniform(NeoName name, VarType type, const void *data, bool flush)
+{
+	MaterialUniformHandle handle = FindUniform(name);
+	if (handle.IsValid())
+		SetUniform(handle, type, data, flush);
+}
+
+bool Material::ResolveUniform(MaterialUniformHandle& handle)
+{
+	if (handle.generation != m_assetGeneration.load())
+		handle = FindUniform(handle.name);
+	return handle.IsValid();
+}
+
+void Material::WriteUniform(const MaterialUniformHandle& handle, const void* data, bool flush)
+{
+#if ASSERTS_ENABLED
+	Assert(Thread::GetCurrentThreadGUID() == ThreadGUID_Render, "Must run on render thread because it uses active render pass!");
+	if (m_assetData->renderPasses[handle.renderPassIndex]->renderPass != GIL::Instance().GetActiveRenderPass())
+		Error(STR("uniform {} of material {} set outside the render pass it was found for", handle.name, m_name));
+#endif
+
+	GIL::Instance().UpdateUBOInstanceMember(handle.uboInstance, handle.offset, data, handle.datasize, flush);
+}
+
+void Material::SetUniform(MaterialUniformHandle& handle, VarType type, const void* data, bool flush)
+{
+	if (!ResolveUniform(handle))
+		return;
+
+#if ASSERTS_ENABLED
+	if (handle.type != type)
+		Error(STR("Type mismatch setting uniform {} in material {}", handle.name, m_name));
+#endif
+
+	WriteUniform(handle, data, flush);
+}
+
+void Material::SetUniforms(std::span<const MaterialUniformValue> values)
+{
+	// resolve everything first - until then a handle doesn't know which ubo it writes to
+	for (auto& value : values)
+		ResolveUniform(*value.handle);
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		auto& handle = *values[i].handle;
+		if (!handle.IsValid())
+			continue;
+
+		// only the last write to each ubo flushes it
+		auto uboInstance = handle.uboInstance;
+		bool flush = std::none_of(values.begin() + i + 1, values.end(), [uboInstance](const MaterialUniformValue& later) { return later.handle->uboInstance == uboInstance; });
+		WriteUniform(handle, values[i].data, flush);
+	}
 }
 
 void Material::OnAssetDeliver(AssetData* data)
@@ -47,6 +119,7 @@ void Material::OnAssetDeliver(AssetData* data)
 	if (data)
 	{
 		m_assetData = dynamic_cast<MaterialAssetData*>(data);
+		m_assetGeneration++;
 
 		// create dependant resources
 		vector<Resource*> dependantResources;
@@ -68,7 +141,7 @@ void Material::OnAssetDeliver(AssetData* data)
 
 		// we need to wait for our dependant resources, like Shaders and Textures,  to load first before creating our platform data (which are pipeline states)
 		// note that if they are already loaded, this will just trigger off the callback immediately
-		ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]() { m_platformData = MaterialPlatformData_Create(m_assetData); OnLoadComplete(); });
+		ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]() { m_platformData = MaterialPlatformData_Create(m_assetData); PublishPlatformData(m_platformData); OnLoadComplete(); });
 	}
 	else
 	{
@@ -89,6 +162,7 @@ template <> ResourceFactory<Material>::ResourceFactory()
 	ati->name = Material::AssetType;
 	ati->assetCreator = []() -> AssetData* { return new MaterialAssetData; };
 	ati->assetExt = ".neomat";
+	ati->version = MATERIAL_VERSION;
 	ati->sourceExt.push_back({ { ".material" }, true });		// on of these src image files
 	AssetManager::Instance().RegisterAssetType(ati);
 }
@@ -108,7 +182,7 @@ static vector<string> s_samplerFilterNames = { "nearest", "linear" };
 static vector<string> s_samplerWrapNames = { "clamp", "repeat" };
 static vector<string> s_samplerCompareNames = { "none", "gequal", "lequal" };
 
-UBOMemberInfo* FindUniformMember(UBOInfo* ubo, const string &name)
+UBOMemberInfo* FindUniformMember(UBOInfo* ubo, NeoName name)
 {
 	for (auto& member : ubo->members)
 	{
@@ -140,7 +214,7 @@ bool MaterialAssetData::SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreateP
 {
 	Assert(srcFiles.size() == 1, STR("Expected 1 src file for material"));
 
-	auto shad = new SHADReader("material", (const char*)srcFiles[0].Mem(), (int)srcFiles[0].Size());
+	auto shad = SHADBinary::FromSource("material", srcFiles[0]);
 	auto rootChildren = shad->root->GetChildren();
 	for (auto renderPassNode : rootChildren)
 	{
@@ -302,6 +376,8 @@ bool MaterialAssetData::SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreateP
 		}
 	}
 
+	delete shad;
+
 	Assert(renderPasses.size() > 0, STR("No renderpasses found for material: {}", name));
 
 	return true;
@@ -331,7 +407,7 @@ MemBlock MaterialAssetData::AssetToMemory()
 			stream.WriteU8((u8)mbo->uniforms.size());
 			for (auto& uniform : mbo->uniforms)
 			{
-				stream.WriteString(uniform.uboMember->name);
+				stream.WriteString(uniform.uboMember->name.String());
 				stream.WriteMemory((u8*)uniform.data, uniform.uboMember->datasize);
 			}
 		}
@@ -424,16 +500,14 @@ bool MaterialAssetData::MemoryToAsset(const MemBlock& block)
 
 void MaterialFactory::OnSwapChainResize()
 {
-	for (auto [hash, material] : m_resources)
-	{
-		material->RecreatePlatformData();
-	}
+	ForEach([](Material* material) { material->RecreatePlatformData(); });
 }
 
 void Material::RecreatePlatformData()
 {
 	MaterialPlatformData_Destroy(m_platformData);
 	m_platformData = MaterialPlatformData_Create(m_assetData);
+	PublishPlatformData(m_platformData);
 }
 
 
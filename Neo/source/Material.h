@@ -75,17 +75,49 @@ struct MaterialSampler
 	TextureRef texture;
 };
 
+// a uniform looked up once by name, for a particular render pass
+// setting a value through it is just a copy into the ubo - no searching
+// a handle made from just a name is found in the active render pass the first time it's set
+struct MaterialUniformHandle
+{
+	MaterialUniformHandle() {}
+	MaterialUniformHandle(NeoName name) : name(name) {}
+
+	NeoName name;
+	u32 renderPassIndex = 0;			// which of the material's render passes it was found in
+	struct UBOInfoInstance* uboInstance = nullptr;
+	u32 offset = 0;
+	u32 datasize = 0;
+	VarType type = VarType_vec4;
+	u32 generation = 0;					// material asset data it was found in - re-found by name if the material reloads, 0 if it wasn't found
+
+	bool IsValid() const { return uboInstance != nullptr; }
+};
+
+// one value for Material::SetUniforms
+struct MaterialUniformValue
+{
+	MaterialUniformHandle* handle;
+	const void* data;
+};
+
 class Material : public Resource
 {
 	virtual void Reload() override;
 
 	struct MaterialAssetData* m_assetData = nullptr;
 	struct MaterialPlatformData* m_platformData = nullptr;
+	std::atomic<u32> m_assetGeneration = 0;		// bumped by each asset delivery, on a loader thread - never 0 once loaded
 
 	// dirty mask gets set if any uniforms are updated (bit 0 is frame 0, bit 1 is frame 1)
 	u32 dirtyMask = 0xf;
 
-	void SetUniform(const string& name, VarType type, const void* data, bool flush);
+	void SetUniform(NeoName name, VarType type, const void* data, bool flush);
+	void SetUniform(MaterialUniformHandle& handle, VarType type, const void* data, bool flush);
+
+	// re-find the handle if it's name only or the material has reloaded - returns false if the uniform isn't there
+	bool ResolveUniform(MaterialUniformHandle& handle);
+	void WriteUniform(const MaterialUniformHandle& handle, const void* data, bool flush);
 
 public:
 	static const string AssetType;
@@ -93,11 +125,25 @@ public:
 	virtual ~Material() {}
 	void OnAssetDeliver(struct AssetData* data);
 
-	void SetUniform_vec4(const string& name, const vec4& value, bool flush) { SetUniform(name, VarType_vec4, &value, flush); }
-	void SetUniform_ivec4(const string& name, const ivec4& value, bool flush) { SetUniform(name, VarType_ivec4, &value, flush); }
-	void SetUniform_f32(const string& name, f32 value, bool flush) { SetUniform(name, VarType_f32, &value, flush); }
-	void SetUniform_i32(const string& name, i32 value, bool flush) { SetUniform(name, VarType_ivec4, &value, flush); }
-	void SetUniform_mat4x4(const string& name, const mat4x4& value, bool flush) { SetUniform(name, VarType_mat4x4, &value, flush); }
+	void SetUniform_vec4(NeoName name, const vec4& value, bool flush) { SetUniform(name, VarType_vec4, &value, flush); }
+	void SetUniform_ivec4(NeoName name, const ivec4& value, bool flush) { SetUniform(name, VarType_ivec4, &value, flush); }
+	void SetUniform_f32(NeoName name, f32 value, bool flush) { SetUniform(name, VarType_f32, &value, flush); }
+	void SetUniform_i32(NeoName name, i32 value, bool flush) { SetUniform(name, VarType_i32, &value, flush); }
+	void SetUniform_mat4x4(NeoName name, const mat4x4& value, bool flush) { SetUniform(name, VarType_mat4x4, &value, flush); }
+
+	// find a uniform once, then set it through the handle each draw
+	// renderPass defaults to the active render pass - an invalid handle is returned if the material doesn't have the uniform in that pass
+	MaterialUniformHandle FindUniform(NeoName name, RenderPass* renderPass = nullptr);
+
+	void SetUniform_vec4(MaterialUniformHandle& handle, const vec4& value, bool flush) { SetUniform(handle, VarType_vec4, &value, flush); }
+	void SetUniform_ivec4(MaterialUniformHandle& handle, const ivec4& value, bool flush) { SetUniform(handle, VarType_ivec4, &value, flush); }
+	void SetUniform_f32(MaterialUniformHandle& handle, f32 value, bool flush) { SetUniform(handle, VarType_f32, &value, flush); }
+	void SetUniform_i32(MaterialUniformHandle& handle, i32 value, bool flush) { SetUniform(handle, VarType_i32, &value, flush); }
+	void SetUniform_mat4x4(MaterialUniformHandle& handle, const mat4x4& value, bool flush) { SetUniform(handle, VarType_mat4x4, &value, flush); }
+
+	// write several uniforms, flushing each ubo they touch just once at the end
+	// each value's data must match its uniform's type - there's no type to check it against here
+	void SetUniforms(std::span<const MaterialUniformValue> values);
 
 	void RecreatePlatformData();
 
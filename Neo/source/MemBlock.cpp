@@ -1,5 +1,7 @@
 #include "Neo.h"
 #include "MemBlock.h"
+#include "LZCodec.h"
+#include "MathUtils.h"
 #include "zlib.h"
 
 bool MemBlock::Resize(size_t size)
@@ -20,11 +22,27 @@ bool MemBlock::Expand(size_t size)
 
 	u8 *newMem = new u8[size];
 	memcpy(newMem, m_mem, m_size);
-	delete m_mem;
+	delete [] m_mem;
 	m_mem = newMem;
 	m_size = size;
 	return true;
 }
+bool MemBlock::Shrink(size_t size)
+{
+	if (size >= m_size)
+		return (size == m_size);
+
+	if (!m_external)
+	{
+		u8 *newMem = (size > 0) ? new u8[size] : nullptr;
+		if (size > 0)
+			memcpy(newMem, m_mem, size);
+		delete [] m_mem;
+		m_mem = newMem;
+	}
+	m_size = size;
+	return true;
+}
 void MemBlock::SetExternal(u8 *mem, size_t size)
 {
 	FreeMem();
@@ -36,7 +54,7 @@ bool MemBlock::FreeMem()
 {
 	if (!m_external)
 	{
-		delete m_mem;
+		delete [] m_mem;
 		m_mem = 0;
 		m_size = 0;
 		return true;
@@ -56,11 +74,108 @@ void MemBlock::AllocMem(size_t size)
 		m_size = size;
 	}
 }
-void MemBlock::DecompressTo(MemBlock &dest)
+// compressed blocks start with a tag of 'NEO' + codec, then the decompressed size
+// the codec byte has the top bits set so it can't be mistaken for the size that starts old style blocks
+struct MemBlockCompressedHeader
+{
+	u32 tag;
+	u32 decompressedSize;
+};
+#define MEMBLOCK_CODEC_TAG(codec) (0x004f454e | ((0xc0 | (u32)(codec)) << 24))
+#define MEMBLOCK_IS_CODEC_TAG(tag) (((tag) & 0xc0ffffff) == 0xc04f454e)
+#define MEMBLOCK_TAG_CODEC(tag) ((MemBlockCodecType)(((tag) >> 24) & 0x3f))
+
+class MemBlockCodec_StoreImpl : public MemBlockCodec
+{
+public:
+	virtual size_t CompressBound(size_t srcSize) override { return srcSize; }
+	virtual size_t Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override
+	{
+		if (destSize < srcSize)
+			return 0;
+		memcpy(dest, src, srcSize);
+		return srcSize;
+	}
+	virtual bool Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override
+	{
+		if (srcSize != destSize)
+			return false;
+		memcpy(dest, src, srcSize);
+		return true;
+	}
+};
+
+class MemBlockCodec_ZlibImpl : public MemBlockCodec
+{
+public:
+	virtual size_t CompressBound(size_t srcSize) override { return compressBound((uLong)srcSize); }
+	virtual size_t Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override
+	{
+		uLongf compressedSize = (uLongf)destSize;
+		if (compress2(dest, &compressedSize, src, (uLong)srcSize, Z_DEFAULT_COMPRESSION) != Z_OK)
+			return 0;
+		return compressedSize;
+	}
+	virtual bool Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override
+	{
+		uLongf decompressedSize = (uLongf)destSize;
+		return uncompress(dest, &decompressedSize, src, (uLong)srcSize) == Z_OK && decompressedSize == destSize;
+	}
+};
+
+class MemBlockCodec_LZImpl : public MemBlockCodec
+{
+public:
+	virtual size_t CompressBound(size_t srcSize) override { return LZ_CompressBound(srcSize); }
+	virtual size_t Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override { return LZ_Compress(src, srcSize, dest, destSize); }
+	virtual bool Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize) override { return LZ_Decompress(src, srcSize, dest, destSize); }
+};
+
+static MemBlockCodec_StoreImpl s_codecStore;
+static MemBlockCodec_ZlibImpl s_codecZlib;
+static MemBlockCodec_LZImpl s_codecLZ;
+static MemBlockCodec* s_codecs[MemBlockCodec_MAX] = { &s_codecStore, &s_codecZlib, &s_codecLZ };
+
+void MemBlock::RegisterCodec(MemBlockCodecType type, MemBlockCodec* codec)
+{
+	Assert(type > MemBlockCodec_Store && type < MemBlockCodec_MAX, STR("Invalid codec slot {}", (int)type));
+	s_codecs[type] = codec;
+}
+
+bool MemBlock::DecompressTo(MemBlock &dest)
 {
-	// compressed memory has the decompress size in the first 4 bytes
-	int decompressSize = *((u32*)m_mem);
-	dest.Resize(decompressSize);
+	if (m_size < sizeof(u32))
+	{
+		dest.Resize(0);
+		return false;
+	}
+
+	// blocks can sit at any alignment (ie. archive chunks), so copy the header out
+	MemBlockCompressedHeader header = {};
+	memcpy(&header, m_mem, Min(m_size, sizeof(header)));
+	if (m_size >= sizeof(MemBlockCompressedHeader) && MEMBLOCK_IS_CODEC_TAG(header.tag))
+	{
+		MemBlockCodecType type = MEMBLOCK_TAG_CODEC(header.tag);
+		MemBlockCodec* codec = s_codecs[type];
+		if (!dest.Resize(header.decompressedSize))
+			Error(STR("Unable to fit decompressed block in supplied memory! ({} bytes)", header.decompressedSize));
+		else if (!codec)
+			Error(STR("Unable to decompress block - no codec registered for type {}", (int)type));
+		else if (!codec->Decompress(m_mem + sizeof(MemBlockCompressedHeader), m_size - sizeof(MemBlockCompressedHeader), dest.Mem(), dest.Size()))
+			Error(STR("Corrupt compressed block - codec {}", (int)type));
+		else
+			return true;
+		return false;
+	}
+
+	// old style block - the decompress size is in the first 4 bytes, followed by raw zlib data
+	u32 decompressSize;
+	memcpy(&decompressSize, m_mem, sizeof(u32));
+	if (!dest.Resize(decompressSize))
+	{
+		Error(STR("Unable to fit decompressed block in supplied memory! ({} bytes)", decompressSize));
+		return false;
+	}
 
 	if (decompressSize == m_size-4)
 		memcpy(dest.Mem(), m_mem+4, m_size-4);
@@ -78,10 +193,15 @@ void MemBlock::DecompressTo(MemBlock &dest)
 		strm.next_in = (Bytef*)(m_mem + 4);
 		strm.avail_out = decompressSize;
 		strm.next_out = dest.Mem();
-		inflate(&strm, Z_NO_FLUSH);
-		Assert(strm.avail_out == 0, "Did not decompress to full buffer!");
+		int result = inflate(&strm, Z_NO_FLUSH);
 		inflateEnd(&strm);
+		if ((result != Z_OK && result != Z_STREAM_END) || strm.avail_out != 0)
+		{
+			Error("Corrupt compressed block - did not decompress to full buffer");
+			return false;
+		}
 	}
+	return true;
 }
 
 // copy to another block
@@ -92,7 +212,7 @@ void MemBlock::CopyTo(MemBlock &dest)
 }
 
 // compress a block
-void MemBlock::CompressTo(MemBlock &dest)
+void MemBlock::CompressTo(MemBlock &dest, MemBlockCodecType codecType)
 {
 	if (m_size == 0)
 	{
@@ -100,35 +220,223 @@ void MemBlock::CompressTo(MemBlock &dest)
 		return;
 	}
 
-	u32 outBufferSize = (u32)m_size + 256;
-	u8 *compressBuffer = new u8[outBufferSize];
+	MemBlockCodec* codec = s_codecs[codecType];
+	Assert(codec != nullptr, STR("No codec registered for type {}", (int)codecType));
+
+	// compress straight into the destination, then shrink it down to the compressed size
+	size_t headerSize = sizeof(MemBlockCompressedHeader);
+	size_t bound = Max(codec->CompressBound(m_size), m_size);
+	if (!dest.Resize(headerSize + bound))
+	{
+		Error(STR("Unable to fit compressed block in supplied memory! ({} bytes)", headerSize + bound));
+		return;
+	}
+	size_t compressedSize = codec->Compress(m_mem, m_size, dest.Mem() + headerSize, bound);
+	if (compressedSize == 0 || compressedSize >= m_size)
+	{
+		// didn't shrink, so just store it
+		codecType = MemBlockCodec_Store;
+		compressedSize = s_codecStore.Compress(m_mem, m_size, dest.Mem() + headerSize, bound);
+	}
+
+	// hand back the worst case slack - compressed blocks are often held for a while (ie. queued for writing)
+	dest.Shrink(headerSize + compressedSize);
+
+	auto header = (MemBlockCompressedHeader*)dest.Mem();
+	header->tag = MEMBLOCK_CODEC_TAG(codecType);
+	header->decompressedSize = (u32)m_size;
+}
+
+#define HASH64_PRIME1 0x9E3779B185EBCA87ull
+#define HASH64_PRIME2 0xC2B2AE3D27D4EB4Full
+#define HASH64_PRIME3 0x165667B19E3779F9ull
+#define HASH64_PRIME4 0x85EBCA77C2B2AE63ull
+#define HASH64_PRIME5 0x27D4EB2F165667C5ull
+
+static inline u64 Hash64_Rotl(u64 value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+static inline u64 Hash64_Round(u64 acc, u64 input)
+{
+	acc += input * HASH64_PRIME2;
+	return Hash64_Rotl(acc, 31) * HASH64_PRIME1;
+}
+
+static inline u64 Hash64_Merge(u64 acc, u64 lane)
+{
+	acc ^= Hash64_Round(0, lane);
+	return acc * HASH64_PRIME1 + HASH64_PRIME4;
+}
+
+u64 MemBlock::Hash64(u64 seed) const
+{
+	const u8* p = m_mem;
+	const u8* end = m_mem + m_size;
+	u64 hash;
 
-	// compress
-	z_stream strm;
-	strm.zalloc = Z_NULL;
-	strm.zfree = Z_NULL;
-	strm.opaque = Z_NULL;
-	deflateInit(&strm, Z_DEFAULT_COMPRESSION);
-	strm.avail_in = (u32)m_size;
-	strm.next_in = (Bytef*)m_mem;
-	strm.avail_out = outBufferSize;
-	strm.next_out = compressBuffer;
-	deflate(&strm, Z_FINISH);
-	u32 compressedSize = outBufferSize - strm.avail_out;
-	if (compressedSize < (u32)(m_size-4))
+	if (m_size >= 32)
 	{
-		dest.Resize(compressedSize + 4);
-		*((u32*)dest.Mem()) = (u32)m_size;
-		memcpy(dest.Mem() + 4, compressBuffer, compressedSize);
+		// four independent lanes over 32 byte stripes
+		u64 lane[4] = { seed + HASH64_PRIME1 + HASH64_PRIME2, seed + HASH64_PRIME2, seed, seed - HASH64_PRIME1 };
+		const u8* limit = end - 32;
+		do
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				u64 input;
+				memcpy(&input, p + i * 8, 8);
+				lane[i] = Hash64_Round(lane[i], input);
+			}
+			p += 32;
+		} while (p <= limit);
+
+		hash = Hash64_Rotl(lane[0], 1) + Hash64_Rotl(lane[1], 7) + Hash64_Rotl(lane[2], 12) + Hash64_Rotl(lane[3], 18);
+		for (int i = 0; i < 4; i++)
+			hash = Hash64_Merge(hash, lane[i]);
 	}
 	else
 	{
-		dest.Resize((u32)m_size + 4);
-		*((u32*)dest.Mem()) = (u32)m_size;
-		memcpy(dest.Mem() + 4, m_mem, (u32)m_size);
+		hash = seed + HASH64_PRIME5;
+	}
+	hash += (u64)m_size;
+
+	// remaining tail bytes
+	for (; p + 8 <= end; p += 8)
+	{
+		u64 input;
+		memcpy(&input, p, 8);
+		hash ^= Hash64_Round(0, input);
+		hash = Hash64_Rotl(hash, 27) * HASH64_PRIME1 + HASH64_PRIME4;
+	}
+	if (p + 4 <= end)
+	{
+		u32 input;
+		memcpy(&input, p, 4);
+		hash ^= (u64)input * HASH64_PRIME1;
+		hash = Hash64_Rotl(hash, 23) * HASH64_PRIME2 + HASH64_PRIME3;
+		p += 4;
+	}
+	for (; p < end; p++)
+	{
+		hash ^= (*p) * HASH64_PRIME5;
+		hash = Hash64_Rotl(hash, 11) * HASH64_PRIME1;
+	}
+
+	// final avalanche
+	hash ^= hash >> 33;
+	hash *= HASH64_PRIME2;
+	hash ^= hash >> 29;
+	hash *= HASH64_PRIME3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// crc32c - hardware crc32 instructions on x64 (sse4.2) and arm (crc extension), slicing by 8 tables otherwise
+#define CRC32C_POLY 0x82F63B78u
+
+struct Crc32cTables
+{
+	u32 table[8][256];
+
+	Crc32cTables()
+	{
+		for (u32 i = 0; i < 256; i++)
+		{
+			u32 crc = i;
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+			table[0][i] = crc;
+		}
+		for (u32 i = 0; i < 256; i++)
+		{
+			for (int slice = 1; slice < 8; slice++)
+				table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xff];
+		}
 	}
+};
+
+static u32 Crc32c_Software(u32 crc, const u8* p, size_t size)
+{
+	static const Crc32cTables s_tables;
+	auto& t = s_tables.table;
+	for (; size >= 8; p += 8, size -= 8)
+	{
+		u32 lo, hi;
+		memcpy(&lo, p, 4);
+		memcpy(&hi, p + 4, 4);
+		lo ^= crc;
+		crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+			t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+	}
+	for (; size > 0; p++, size--)
+		crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+	return crc;
+}
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CRC32C_TARGET
+#else
+#include <cpuid.h>
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif
+
+static bool Crc32c_HasHardware()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[2] & (1 << 20)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+#endif
+}
 
-	deflateEnd(&strm);
-	delete [] compressBuffer;
-	//DMLOG("Compress chunk %d -> %d (%d%%)",m_size,compressedSize+4,(compressedSize+4)*100/rawSize);
+CRC32C_TARGET static u32 Crc32c_Hardware(u32 crc, const u8* p, size_t size)
+{
+	u64 crc64 = crc;
+	for (; size >= 8; p += 8, size -= 8)
+	{
+		u64 value;
+		memcpy(&value, p, 8);
+		crc64 = _mm_crc32_u64(crc64, value);
+	}
+	crc = (u32)crc64;
+	for (; size > 0; p++, size--)
+		crc = _mm_crc32_u8(crc, *p);
+	return crc;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+
+static bool Crc32c_HasHardware() { return true; }
+
+static u32 Crc32c_Hardware(u32 crc, const u8* p, size_t size)
+{
+	for (; size >= 8; p += 8, size -= 8)
+	{
+		u64 value;
+		memcpy(&value, p, 8);
+		crc = __crc32cd(crc, value);
+	}
+	for (; size > 0; p++, size--)
+		crc = __crc32cb(crc, *p);
+	return crc;
+}
+#else
+static bool Crc32c_HasHardware() { return false; }
+static u32 Crc32c_Hardware(u32 crc, const u8* p, size_t size) { return Crc32c_Software(crc, p, size); }
+#endif
+
+u32 MemBlock::Crc32c(const u8* mem, size_t size, u32 crc)
+{
+	static const bool s_hardware = Crc32c_HasHardware();
+	crc = ~crc;
+	crc = s_hardware ? Crc32c_Hardware(crc, mem, size) : Crc32c_Software(crc, mem, size);
+	return ~crc;
 }
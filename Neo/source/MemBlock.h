@@ -1,5 +1,32 @@
 #pragma once
 
+// compression codecs used by MemBlock::CompressTo
+// compressed blocks start with a header naming their codec, so DecompressTo never needs to be told which was used
+enum MemBlockCodecType
+{
+	MemBlockCodec_Store,	// stored uncompressed (used automatically when compression doesn't help)
+	MemBlockCodec_Zlib,		// best ratio, slower to decompress
+	MemBlockCodec_LZ,		// fast decompress, lower ratio
+
+	MemBlockCodec_MAX = 64
+};
+
+// derive from this to plug in another codec with MemBlock::RegisterCodec
+class MemBlockCodec
+{
+public:
+	virtual ~MemBlockCodec() = default;
+
+	// worst case compressed size for a block of srcSize bytes
+	virtual size_t CompressBound(size_t srcSize) = 0;
+
+	// returns the compressed size, or 0 if it couldn't compress into dest
+	virtual size_t Compress(const u8* src, size_t srcSize, u8* dest, size_t destSize) = 0;
+
+	// destSize is the exact decompressed size
+	virtual bool Decompress(const u8* src, size_t srcSize, u8* dest, size_t destSize) = 0;
+};
+
 class MemBlock
 {
 public:
@@ -95,17 +122,33 @@ public:
 	// allocates a larger block - keeping the contains in tact
 	bool Expand(size_t size);
 
+	// reallocates to a smaller block, keeping the start of the contents - external blocks just get shorter
+	bool Shrink(size_t size);
+
 	// set this to be an external block of memory - will not attempt to free it in destructor and will not be able to resize or expand it larger
 	void SetExternal(u8 *mem, size_t size);
 
 	// decompress to another block
-	void DecompressTo(MemBlock &dest);
+	// handles any registered codec, plus the old headerless zlib format
+	// returns false if the block is corrupt - dest holds nothing useful then
+	bool DecompressTo(MemBlock &dest);
 
 	// copy to another block
 	void CopyTo(MemBlock &dest);
 
-	// compress a block if possible
-	void CompressTo(MemBlock &dest);
+	// compress a block if possible - falls back to storing it if the codec doesn't make it smaller
+	void CompressTo(MemBlock &dest, MemBlockCodecType codec = MemBlockCodec_Zlib);
+
+	// add a codec, or replace a built in one
+	static void RegisterCodec(MemBlockCodecType type, MemBlockCodec* codec);
+
+	// fast 64 bit hash of the contents (xxHash64) - good for content addressing, not for security
+	u64 Hash64(u64 seed = 0) const;
+
+	// crc32c (castagnoli) checksum - uses the cpu's crc32 instructions when it has them
+	// pass a previous result as crc to checksum data in pieces
+	u32 Crc32c(u32 crc = 0) const { return Crc32c(m_mem, m_size, crc); }
+	static u32 Crc32c(const u8* mem, size_t size, u32 crc = 0);
 
 	u8 *Mem() { return m_mem; }
 	u8 *MemEnd() { return m_mem + m_size; }
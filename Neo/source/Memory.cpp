@@ -120,6 +120,12 @@ void MemoryTracker::Dump()
                 out = std::format("-==== [{}]: {} allocs, {} bytes [{}/{}/{}/{}]====-\n", groupName[i], m_memoryGroupAllocCount[i], m_memoryGroupAllocated[i], blocks[0], blocks[1], blocks[2], blocks[3]);
                 fm.StreamWrite(logFile, (u8*)out.c_str(), (u32)out.size());
 
+                if (m_residencyReleased[i] > 0)
+                {
+                    out = std::format("  residency: {} bytes released after upload, {} bytes restored\n", m_residencyReleased[i].load(), m_residencyRestored[i].load());
+                    fm.StreamWrite(logFile, (u8*)out.c_str(), (u32)out.size());
+                }
+
                 for (auto it : m_blocks)
                 {
                     auto b = it.second;
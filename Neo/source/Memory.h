@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #define NEO_MEMORY_TRACKING 1
 #define NEO_STACK_TRACING 0
 
@@ -89,6 +91,10 @@ class MemoryTracker
     };
     hashtable<void *, TrackedBlock*> m_blocks;
 
+    // cpu side asset data freed once uploaded (see AssetResidency), and loaded back in again
+    std::atomic<u64> m_residencyReleased[(int)MemoryGroup_MAX] = {};
+    std::atomic<u64> m_residencyRestored[(int)MemoryGroup_MAX] = {};
+
 public:
     MemoryTracker();
     ~MemoryTracker();
@@ -98,6 +104,9 @@ public:
     void PopGroup() { m_activeGroup.pop_back(); }
     bool EnableTracking(bool enable);
     void Dump();
+
+    void RecordResidencyRelease(MemoryGroup group, u64 bytes) { m_residencyReleased[(int)group] += bytes; }
+    void RecordResidencyRestore(MemoryGroup group, u64 bytes) { m_residencyRestored[(int)group] += bytes; }
 };
 extern MemoryTracker gMemoryTracker;
 
@@ -150,6 +150,7 @@ template<typename D> using set = std::set<D>;
 template<typename D> using hashset = std::unordered_set<D>;
 template<typename T> using fifo = std::deque<T>;
 using string = std::string;
+using string_view = std::string_view;
 using stringlist = std::vector<string>;
 
 // this used by any callback system that allows adding & removing callbacks
@@ -169,6 +170,7 @@ inline void Error(const string& msg) {}
 #endif
 
 #include "Reflection.h"
+#include "NeoName.h"
 #include "Memory.h"
 #include "Module.h"
 #include "CmdLineVar.h"
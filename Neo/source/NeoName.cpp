@@ -0,0 +1,57 @@
+#include "Neo.h"
+#include "NeoName.h"
+
+// power of 2 - case variants of a name always share a bucket, since the hash ignores case
+#define NEONAME_BUCKET_COUNT (16 * 1024)
+
+// zero initialised before any static constructors run, so names can be interned from anywhere
+static std::atomic<const NeoNameEntry *> s_buckets[NEONAME_BUCKET_COUNT];
+
+const string NeoName::s_empty;
+
+static bool NeoNameEqualNoCase(string_view a, string_view b)
+{
+	if (a.size() != b.size())
+		return false;
+	auto lower = [](char ch) { return (ch >= 'A' && ch <= 'Z') ? (char)(ch + ('a' - 'A')) : ch; };
+	for (size_t i = 0; i < a.size(); i++)
+		if (lower(a[i]) != lower(b[i]))
+			return false;
+	return true;
+}
+
+const NeoNameEntry *NeoName::Intern(string_view str, u64 hash)
+{
+	if (str.empty())
+		return nullptr;
+
+	auto &bucket = s_buckets[hash & (NEONAME_BUCKET_COUNT - 1)];
+	const NeoNameEntry *head = bucket.load(std::memory_order_acquire);
+	const NeoNameEntry *searched = nullptr;
+	const NeoNameEntry *noCase = nullptr;
+	NeoNameEntry *entry = nullptr;
+	while (true)
+	{
+		// entries are only ever pushed on the front, so after a failed swap only the new ones need checking
+		for (auto it = head; it != searched; it = it->next)
+		{
+			if (it->hash != hash)
+				continue;
+			if (it->str == str)
+			{
+				delete entry;
+				return it;
+			}
+			if (!noCase && NeoNameEqualNoCase(it->str, str))
+				noCase = it->noCase;
+		}
+
+		if (!entry)
+			entry = new NeoNameEntry{ hash, nullptr, nullptr, string(str) };
+		entry->next = head;
+		entry->noCase = noCase ? noCase : entry;
+		searched = head;
+		if (bucket.compare_exchange_weak(head, entry, std::memory_order_release, std::memory_order_acquire))
+			return entry;
+	}
+}
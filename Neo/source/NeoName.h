@@ -0,0 +1,121 @@
+#pragma once
+
+/**************************************************************************
+NeoName  -  interned names
+
+every distinct string is stored once in a global table, and a NeoName is just
+a pointer to its entry - copying is free, equality is a pointer compare and
+the 64 bit hash is worked out once, when the string is first interned.
+
+the hash ignores case and matches StringHash64, so names can key the same
+tables as before.  the name itself keeps its case - == is case sensitive,
+EqualNoCase isn't, and both are O(1).
+
+interning takes no lock - a new entry is pushed onto its bucket with a
+compare & swap.  entries are never freed, so only intern names that come
+from a bounded set (assets, files, shader symbols...).  lookups by a name
+that may not exist (ie. file probes) should take a NeoNameKey instead - it
+has the same hash but is never interned.
+
+hot code should use NEONAME("UBO_Model") - the literal is hashed by the
+compiler and interned on first use only.
+
+***************************************************************************/
+
+#include <atomic>
+
+// same as StringHash64 - usable at compile time
+constexpr u64 NeoNameHash(string_view str)
+{
+	u64 prime = 16777619;
+	u64 hash = 2166136261;
+	for (char ch : str)
+	{
+		int lower = (ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+		hash ^= (lower & 15);
+		hash *= prime;
+		hash ^= (lower >> 4);
+		hash *= prime;
+	}
+	return hash;
+}
+
+struct NeoNameEntry
+{
+	u64 hash;
+	const NeoNameEntry *next;		// next in the bucket
+	const NeoNameEntry *noCase;		// first interned spelling that matches this one ignoring case
+	string str;
+};
+
+// a string literal hashed at compile time
+struct NeoNameLiteral
+{
+	template <size_t N>
+	consteval NeoNameLiteral(const char (&lit)[N]) : str(lit, N - 1), hash(NeoNameHash(string_view(lit, N - 1))) {}
+
+	string_view str;
+	u64 hash;
+};
+
+class NeoName
+{
+public:
+	NeoName() {}
+	NeoName(string_view str) : m_entry(Intern(str, NeoNameHash(str))) {}
+	NeoName(const char *str) : NeoName(string_view(str)) {}
+	NeoName(const string &str) : NeoName(string_view(str)) {}
+	explicit NeoName(const NeoNameLiteral &lit) : m_entry(Intern(lit.str, lit.hash)) {}
+
+	u64 Hash() const { return m_entry ? m_entry->hash : NeoNameHash(string_view()); }
+	const string &String() const { return m_entry ? m_entry->str : s_empty; }
+	const char *c_str() const { return String().c_str(); }
+	string_view View() const { return String(); }
+	bool IsEmpty() const { return m_entry == nullptr; }
+
+	bool operator==(const NeoName &o) const { return m_entry == o.m_entry; }
+	bool EqualNoCase(const NeoName &o) const { return (m_entry && o.m_entry) ? m_entry->noCase == o.m_entry->noCase : m_entry == o.m_entry; }
+
+protected:
+	// the empty string is the null name
+	static const NeoNameEntry *Intern(string_view str, u64 hash);
+	static const string s_empty;
+
+	const NeoNameEntry *m_entry = nullptr;
+};
+
+// interns a literal once per call site
+#define NEONAME(lit) ([]() -> NeoName { static const NeoName s_name(NeoNameLiteral(lit)); return s_name; }())
+
+// a name to look up by - hashed once like a NeoName, but never interned, so a lookup that misses leaves nothing behind
+// it refers to the caller's string, so only pass it down the call, never keep it
+class NeoNameKey
+{
+public:
+	NeoNameKey(const string &str) : m_str(str), m_hash(NeoNameHash(str)) {}
+	NeoNameKey(const NeoName &name) : m_str(name.String()), m_hash(name.Hash()) {}
+
+	u64 Hash() const { return m_hash; }
+	const string &String() const { return m_str; }
+	const char *c_str() const { return m_str.c_str(); }
+	string_view View() const { return m_str; }
+
+protected:
+	const string &m_str;
+	u64 m_hash;
+};
+
+template<> struct std::hash<NeoName>
+{
+	size_t operator()(const NeoName &name) const { return (size_t)name.Hash(); }
+};
+
+template<> struct std::formatter<NeoName> : std::formatter<string_view>
+{
+	auto format(const NeoName &name, std::format_context &ctx) const { return std::formatter<string_view>::format(name.View(), ctx); }
+};
+
+template<> struct std::formatter<NeoNameKey> : std::formatter<string_view>
+{
+	auto format(const NeoNameKey &name, std::format_context &ctx) const { return std::formatter<string_view>::format(name.View(), ctx); }
+};
@@ -3,35 +3,19 @@
 
 DECLARE_MODULE(Reflection, NeoModuleInitPri_Reflect, NeoModulePri_None)
 
-#define MAX_ENUMS 256
-#define MAX_STRUCTS 256
-
-ReflectEnumInfo* s_enums[MAX_ENUMS];
-int s_enums_count = 0;
-
-ReflectStructInfo* s_structs[MAX_STRUCTS];
-int s_structs_count = 0;
-
-void NeoRegisterReflectionEnum(ReflectEnumInfo * info)
+template <class T>
+static const T* FindByName(std::span<const T* const> items, string_view name)
 {
-	s_enums[s_enums_count++] = info;
+	auto it = std::lower_bound(items.begin(), items.end(), name, [](const T* a, string_view b) { return a->name < b; });
+	return (it != items.end() && (*it)->name == name) ? *it : nullptr;
 }
 
-void NeoRegisterReflectionStruct(ReflectStructInfo* info)
+const ReflectEnumInfo* ReflectTables::FindEnum(string_view name) const
 {
-	s_structs[s_structs_count++] = info;
+	return FindByName(enums, name);
 }
 
-void Reflection::Startup()
+const ReflectStructInfo* ReflectTables::FindStruct(string_view name) const
 {
-	for (int i = 0; i < s_enums_count; i++)
-	{
-		m_reflectEnums[s_enums[i]->name] = s_enums[i];
-	}
-	for (int i = 0; i < s_structs_count; i++)
-	{
-		m_reflectStructs[s_structs[i]->name] = s_structs[i];
-	}
+	return FindByName(structs, name);
 }
-
-
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Module.h"
+#include <span>
 
 //<REFLECT>
 enum VarType
@@ -29,32 +30,78 @@ enum VarType
 
 struct ReflectStructMemberInfo
 {
-	string name;
+	string_view name;
 	VarType type;
 	u32 size;
 	u32 offset;
-	std::function<void(void*)> func;
+	void (*func)(void*) = nullptr;
 };
 struct ReflectStructInfo
 {
-	string name;
+	string_view name;
 	u32 size;
-	vector<ReflectStructMemberInfo> members;
+	std::span<const ReflectStructMemberInfo> members;
+};
+
+struct ReflectEnumValue
+{
+	string_view name;
+	int value;
 };
 struct ReflectEnumInfo
 {
-	string name;
-	hashtable<string, int> map_stringToInt;
-	hashtable<int, string> map_intToString;
+	string_view name;
+	std::span<const ReflectEnumValue> byName;		// sorted by name
+	std::span<const ReflectEnumValue> byValue;		// sorted by value
+
+	constexpr bool StringToInt(string_view valueName, int& value) const
+	{
+		auto it = std::lower_bound(byName.begin(), byName.end(), valueName, [](const ReflectEnumValue& a, string_view b) { return a.name < b; });
+		if (it == byName.end() || it->name != valueName)
+			return false;
+		value = it->value;
+		return true;
+	}
+
+	// first name with this value, or blank if there isn't one
+	constexpr string_view IntToString(int value) const
+	{
+		auto it = std::lower_bound(byValue.begin(), byValue.end(), value, [](const ReflectEnumValue& a, int b) { return a.value < b; });
+		return (it != byValue.end() && it->value == value) ? it->name : string_view();
+	}
+};
+
+// the generated tables are sorted by name and built at compile time, so there is nothing to set up at startup
+template <size_t N>
+constexpr array<ReflectEnumValue, N> ReflectSortByValue(array<ReflectEnumValue, N> values)
+{
+	// insertion sort keeps the order of names that share a value
+	for (size_t i = 1; i < N; i++)
+	{
+		ReflectEnumValue value = values[i];
+		size_t j = i;
+		for (; j > 0 && values[j - 1].value > value.value; j--)
+			values[j] = values[j - 1];
+		values[j] = value;
+	}
+	return values;
+}
+
+struct ReflectTables
+{
+	std::span<const ReflectEnumInfo* const> enums;
+	std::span<const ReflectStructInfo* const> structs;
+
+	const ReflectEnumInfo* FindEnum(string_view name) const;
+	const ReflectStructInfo* FindStruct(string_view name) const;
 };
 
 #include "../generated/reflect.h"
 
 class Reflection : public Module<Reflection>
 {
-	hashtable<string, ReflectStructInfo*> m_reflectStructs;
-	hashtable<string, ReflectEnumInfo*> m_reflectEnums;
-
 public:
-	virtual void Startup();
+	// lookups by name across the engine's reflected types
+	const ReflectEnumInfo* FindEnum(string_view name) const { return NeoReflectTables.FindEnum(name); }
+	const ReflectStructInfo* FindStruct(string_view name) const { return NeoReflectTables.FindStruct(name); }
 };
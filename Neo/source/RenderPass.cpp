@@ -1,7 +1,7 @@
 #include "Neo.h"
 #include "RenderPass.h"
 #include "RenderThread.h"
-#include "SHAD.h"
+#include "SHADBinary.h"
 #include "ResourceLoadedManager.h"
 #include "View.h"
 
@@ -36,7 +36,7 @@ void RenderPass::OnAssetDeliver(AssetData* data)
 
 		// we need to wait for our dependant resources, like Shaders and Textures,  to load first before creating our platform data (which are pipeline states)
 		// note that if they are already loaded, this will just trigger off the callback immediately
-		ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]() { m_platformData = RenderPassPlatformData_Create(m_assetData); OnLoadComplete(); });
+		ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]() { m_platformData = RenderPassPlatformData_Create(m_assetData); PublishPlatformData(m_platformData); OnLoadComplete(); });
 	}
 	else
 	{
@@ -61,6 +61,7 @@ template <> ResourceFactory<RenderPass>::ResourceFactory()
 	auto ati = new AssetTypeInfo();
 	ati->name = RenderPass::AssetType;
 	ati->assetExt = ".neorp";
+	ati->version = RENDERPASS_VERSION;
 	ati->assetCreator = []() -> AssetData* { return new RenderPassAssetData; };
 	ati->sourceExt.push_back({ { ".renderpass" }, true });		// on of these src image files
 	AssetManager::Instance().RegisterAssetType(ati);
@@ -68,7 +69,7 @@ template <> ResourceFactory<RenderPass>::ResourceFactory()
 
 bool RenderPassAssetData::SrcFilesToAsset(vector<MemBlock>& srcFiles, AssetCreateParams* params)
 {
-	auto shad = new SHADReader("renderpass", (const char*)srcFiles[0].Mem(), (int)srcFiles[0].Size());
+	auto shad = SHADBinary::FromSource("renderpass", srcFiles[0]);
 	auto rootChildren = shad->root->GetChildren();
 	for (auto fieldNode : rootChildren)
 	{
@@ -256,27 +257,23 @@ void RenderPass::ExecuteTasks()
 
 void RenderPassFactory::DestroyPlatformData()
 {
-	for (auto [hash, renderpass] : m_resources)
-	{
-		renderpass->DestroyPlatformData();
-	}
+	ForEach([](RenderPass* renderpass) { renderpass->DestroyPlatformData(); });
 }
 
 void RenderPassFactory::CreatePlatformData()
 {
-	for (auto [hash, renderpass] : m_resources)
-	{
-		renderpass->CreatePlatformData();
-	}
+	ForEach([](RenderPass* renderpass) { renderpass->CreatePlatformData(); });
 }
 
 void RenderPass::DestroyPlatformData()
 {
 	RenderPassPlatformData_Destroy(m_platformData);
 	m_platformData = nullptr;
+	PublishPlatformData(nullptr);
 }
 
 void RenderPass::CreatePlatformData()
 {
 	m_platformData = RenderPassPlatformData_Create(m_assetData);
+	PublishPlatformData(m_platformData);
 }
@@ -1,7 +1,7 @@
 #include "Neo.h"
 #include "RenderScene.h"
 #include "RenderThread.h"
-#include "SHAD.h"
+#include "SHADBinary.h"
 #include "ResourceLoadedManager.h"
 
 #define RENDERSCENE_VERSION 1
@@ -44,6 +44,7 @@ template <> ResourceFactory<RenderScene>::ResourceFactory()
 	auto ati = new AssetTypeInfo();
 	ati->name = RenderScene::AssetType;
 	ati->assetExt = ".neorscn";
+	ati->version = RENDERSCENE_VERSION;
 	ati->assetCreator = []() -> AssetData* { return new RenderSceneAssetData; };
 	ati->sourceExt.push_back({ { ".renderscene" }, true });		// on of these src image files
 	AssetManager::Instance().RegisterAssetType(ati);
@@ -51,7 +52,7 @@ template <> ResourceFactory<RenderScene>::ResourceFactory()
 
 bool RenderSceneAssetData::SrcFilesToAsset(vector<MemBlock>& srcFiles, AssetCreateParams* params)
 {
-	auto shad = new SHADReader("renderscene", (const char*)srcFiles[0].Mem(), (int)srcFiles[0].Size());
+	auto shad = SHADBinary::FromSource("renderscene", srcFiles[0]);
 	auto rootChildren = shad->root->GetChildren();
 	for (auto fieldNode : rootChildren)
 	{
@@ -5,6 +5,8 @@
 
 DECLARE_MODULE(RenderThread, NeoModuleInitPri_RenderThread, NeoModulePri_None);
 
+CmdLineVar<string> CLV_CreateBudget("createbudget", "milliseconds of each render frame to spend creating loaded resources", "2");
+
 /*
 
 ========== RENDER THREAD ================== =
@@ -19,6 +21,7 @@ GRAPHICS = > EndFrame
 
 RenderThread::RenderThread() : m_gilTaskThread(ThreadGUID_GILTasks, "GILThread"), Thread(ThreadGUID_Render, "Render")
 {
+	m_createBudget = std::atof(CLV_CreateBudget.Value().c_str()) / 1000.0;
 }
 
 RenderThread::~RenderThread()
@@ -46,7 +49,9 @@ int RenderThread::Go()
 	ShaderManager::Instance().CreatePlatformData();
 	AssetManager::Instance().StartWork();
 
+	// no frame to hold up yet, so create everything that's ready
 	m_preDrawTasks.ExecuteAndClear();
+	m_createTasks.ExecuteAll();
 	m_startupTasksComplete.Signal();
 
 	// main draw loop - starts after the first Update() is finished
@@ -60,6 +65,9 @@ int RenderThread::Go()
 		// clear out any queued pre draw tasks before we wait
 		m_preDrawTasks.ExecuteAndClear();
 
+		// then create loaded resources until the budget is spent, so a burst of loads is spread over several frames
+		m_createTasks.Execute(m_createBudget);
+
 		// wait for draw fences to come in
 		gil.FrameWait();
 
@@ -28,6 +28,8 @@ class RenderThread : public Module<RenderThread>, public Thread
 	Semaphore m_startupTasksComplete;
 
 	TaskList m_preDrawTasks;
+	BudgetedTaskList m_createTasks;
+	double m_createBudget;
 	TaskList m_beginFrameTasks;
 	TaskList m_endFrameTasks;
 
@@ -52,9 +54,15 @@ public:
 
 	// tasks that will execute before the main draw loop (after all previous frame work is complete)
 	// note that any pre draw tasks added during module startup will execute before the first module update
+	// these all run every frame no matter how long they take, so keep them to work the frame can't draw without
 	int AddPreDrawTask(const GenericCallback& task) { return m_preDrawTasks.Add(task, 0); }
 	void RemovePreDrawTask(int handle) { m_preDrawTasks.Remove(handle); }
 
+	// platform creation of loaded resources - runs after the pre draw tasks, highest priority first (see AssetPriority)
+	// each frame only spends the creation budget on these, the rest carry over to later frames
+	int AddCreateTask(const GenericCallback& task, int priority) { return m_createTasks.Add(task, priority); }
+	void RemoveCreateTask(int handle) { m_createTasks.Remove(handle); }
+
 	// add a task that will run immediate at start of frame, before any render passes are set
 	int AddBeginFrameTask(const GenericCallback& task) { return m_beginFrameTasks.Add(task, 0); }
 	void RemoveBeginFrameTask(int handle) { m_beginFrameTasks.Remove(handle); }
@@ -1,11 +1,80 @@
 #include "Neo.h"
 #include "Resource.h"
 #include "ResourceLoadedManager.h"
+#include "RenderThread.h"
+
+// platform data may be published before the factory has attached the hot data, so both go through this lock
+static Mutex s_hotDataLock;
+
+// creation tasks can be queued from loader threads while the main thread destroys the resource
+static Mutex s_createTaskLock;
 
 void Resource::OnLoadComplete()
 {
 	ResourceLoadedManager::Instance().SignalResourceLoaded(this);
+	{
+		ScopedMutexLock lock(s_hotDataLock);
+		if (m_hotData)
+			m_hotData->loaded = true;
+	}
 
 	double duration = NeoTimeNow - m_creationStartTime;
 	LOG(Asset, STR("Resource {} CreationTime {}ms", m_name, (int)(duration*1000)));
 }
+
+void Resource::PublishPlatformData(void* platformData)
+{
+	ScopedMutexLock lock(s_hotDataLock);
+	m_publishedPlatformData = platformData;
+	if (m_hotData)
+		m_hotData->platformData = platformData;
+}
+
+void Resource::AttachHotData(ResourceHandle handle, ResourceHotData* hotData)
+{
+	ScopedMutexLock lock(s_hotDataLock);
+	m_handle = handle;
+	m_hotData = hotData;
+	m_hotData->platformData = m_publishedPlatformData;
+	m_hotData->loaded = IsLoaded();
+}
+
+void Resource::AddCreateTask(const GenericCallback& task)
+{
+	ScopedMutexLock lock(s_createTaskLock);
+	if (m_createCancelled)
+		return;
+
+	// only one task is ever queued - a newer one (ie. a second reload) supersedes one that's still waiting,
+	// since every creation task rebuilds from the resource's latest asset data
+	if (m_createTask >= 0)
+		RenderThread::Instance().RemoveCreateTask(m_createTask);
+
+	u32 serial = ++m_createSerial;
+	m_createTask = RenderThread::Instance().AddCreateTask([this, serial, task]()
+	{
+		{
+			// a task added after this one was popped owns the handle now
+			ScopedMutexLock lock(s_createTaskLock);
+			if (m_createSerial == serial)
+				m_createTask = -1;
+		}
+		task();
+	}, m_loadPriority);
+}
+
+void Resource::ReleaseDependants()
+{
+	ResourceLoadedManager::Instance().SignalResourceDestroyed(this);
+}
+
+void Resource::CancelCreateTask()
+{
+	ScopedMutexLock lock(s_createTaskLock);
+	m_createCancelled = true;
+	if (m_createTask >= 0)
+	{
+		RenderThread::Instance().RemoveCreateTask(m_createTask);
+		m_createTask = -1;
+	}
+}
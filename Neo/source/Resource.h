@@ -1,20 +1,37 @@
 #pragma once
 
 #include "TimeManager.h"
+#include "AssetManager.h"
+#include "ResourceHandle.h"
 
 class Resource
 {
 public:
-	void Init(const string& name) {	m_name = name; m_creationStartTime = NeoTimeNow; }
+	void Init(NeoName name) {	m_name = name; m_creationStartTime = NeoTimeNow; }
 	virtual ~Resource() {}
 	virtual const string& GetType() const = 0;
 
 	int IncRef() { return ++m_refCount; }
 	int DecRef() { return --m_refCount; }
-	int GetRef() { return m_refCount; }
+	int GetRef() { return m_refCount.load(); }
 
-	const string& GetName() const { return m_name; }
-	bool IsLoaded() { return m_dataLoaded; }
+	// take a reference only if the resource is still alive - fails once the last reference has gone
+	bool TryIncRef()
+	{
+		int count = m_refCount.load();
+		while (count > 0)
+		{
+			if (m_refCount.compare_exchange_weak(count, count + 1))
+				return true;
+		}
+		return false;
+	}
+
+	const string& GetName() const { return m_name.String(); }
+	NeoName GetNameId() const { return m_name; }
+	ResourceHandle GetHandle() const { return m_handle; }
+	int GetLoadPriority() const { return m_loadPriority; }
+	bool IsLoaded() { return m_dataLoaded.load(); }
 	void MarkIsLoaded() { m_dataLoaded = true; }
 
 	// some loaded assets can be marked as FailedToLoad - which means you need to use a default version of the resource, or abort and fix the problem
@@ -22,14 +39,40 @@ public:
 
 protected:
 	void OnLoadComplete();
+	// rebuild the platform data from the current asset data (ie. after the gpu copy is lost)
+	// this doesn't pick up source changes - released bulk data is restored in the background first
 	virtual void Reload() = 0;
 
-	int m_refCount = 1;
+	// copy the platform data pointer into the handle table's hot data - call whenever m_platformData changes
+	void PublishPlatformData(void* platformData);
+
+	// called by the factory once the resource has a handle
+	void AttachHotData(ResourceHandle handle, ResourceHotData* hotData);
+
+	// queue platform creation on the render thread's budgeted create list
+	// the task may wait several frames, so the factory cancels it if the resource is destroyed first
+	void AddCreateTask(const GenericCallback& task);
+	void CancelCreateTask();
+
+	// called by the factory just before the resource is deleted
+	void ReleaseDependants();
+
+	std::atomic<int> m_refCount = 1;
 	string m_type;
-	string m_name;
-	bool m_dataLoaded = false;
+	NeoName m_name;
+	std::atomic<bool> m_dataLoaded = false;
 	bool m_failedToLoad = false;
+	u64 m_assetRequest = 0;		// asset request that delivers this resource's data - cancelled if the resource is destroyed first
+	int m_loadPriority = AssetPriority_Normal;	// orders the asset request and the render thread creation task
+	int m_createTask = -1;						// queued render thread creation task - there's never more than one
+	u32 m_createSerial = 0;						// bumped per creation task, so a running task only clears its own handle
+	bool m_createCancelled = false;				// destroyed - don't queue any more creation tasks
+	std::atomic<struct ResourceDependant*> m_dependants = nullptr;	// dependancy blocks waiting on this resource to load
+	ResourceHandle m_handle = 0;
+	ResourceHotData* m_hotData = nullptr;
+	void* m_publishedPlatformData = nullptr;
 	friend class ResourceLoadedManager;
+	template <class T> friend class ResourceFactory;
 
 	double m_creationStartTime = 0.0;
 };
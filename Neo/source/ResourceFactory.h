@@ -3,58 +3,169 @@
 #include "Resource.h"
 #include "StringUtils.h"
 #include <functional>
+#include <shared_mutex>
+#include <condition_variable>
 #include "AssetManager.h"
 
 template <class T>
 class ResourceFactory
 {
 protected:
-	hashtable<u64, T*> m_resources;
-	Mutex m_lock;
+	// resources are spread over shards by name hash, so threads creating different resources rarely share a lock
+	// finding a resource only takes a shared lock - the exclusive lock is just for adding & removing
+	static const int ShardCount = 16;
+	struct Entry
+	{
+		T* resource = nullptr;
+		bool creating = true;		// the creator is running - anyone else wanting this resource waits for it
+	};
+	struct Shard
+	{
+		std::shared_mutex lock;
+		std::condition_variable_any created;
+		hashtable<u64, Entry> resources;
+	};
+	Shard m_shards[ShardCount];
+
+	// generational handles for every created resource
+	ResourceHandleTable<T> m_handles;
+
+	Shard& ShardFor(u64 hash) { return m_shards[hash % ShardCount]; }
 
 public:
 	ResourceFactory();
-	T* Create(const string& name, std::function<T*()> creator)
+	T* Create(NeoName name, std::function<T*()> creator)
 	{
-		u64 hash = StringHash64(name);
-		m_lock.Lock();
-		auto it = m_resources.find(hash);
-		if (it == m_resources.end())
+		u64 hash = name.Hash();
+		Shard& shard = ShardFor(hash);
+
+		// fast path - already created & still alive
 		{
-			m_lock.Release();
-			T* resource = creator();
-			m_lock.Lock();
-			m_resources.insert(std::pair<u64, T*>(hash, resource));
-			m_lock.Release();
+			std::shared_lock lock(shard.lock);
+			auto it = shard.resources.find(hash);
+			if (it != shard.resources.end() && !it->second.creating && it->second.resource->TryIncRef())
+				return it->second.resource;
+		}
 
-			return resource;
+		std::unique_lock lock(shard.lock);
+		while (true)
+		{
+			auto it = shard.resources.find(hash);
+			if (it == shard.resources.end())
+				break;
+
+			// single flight - another thread is creating it, so wait and share theirs
+			if (it->second.creating)
+			{
+				shard.created.wait(lock);
+				continue;
+			}
+			if (it->second.resource->TryIncRef())
+				return it->second.resource;
+
+			// the last reference has just gone and it's about to be destroyed - replace it with a new one
+			break;
 		}
-		it->second->IncRef();
-		auto retval = it->second;
-		m_lock.Release();
-		return retval;
+
+		// run the creator outside the lock, since it may create other resources
+		shard.resources[hash] = Entry();
+		lock.unlock();
+		T* resource = creator();
+		ResourceHotData* hotData;
+		resource->AttachHotData(m_handles.Add(resource, hotData), hotData);
+		lock.lock();
+		shard.resources[hash] = Entry{ resource, false };
+		lock.unlock();
+		shard.created.notify_all();
+		return resource;
 	}
-	T* Create(const string& name)
+
+	// find a resource from its handle - nullptr if it has been destroyed
+	// this doesn't take a reference, so only use it for resources that are held elsewhere
+	T* Resolve(ResourceHandle handle) const { return m_handles.Resolve(handle); }
+
+	// platform data & loaded flag for a handle, without touching the resource itself - nullptr if it has been destroyed
+	const ResourceHotData* GetHotData(ResourceHandle handle) const { return m_handles.GetHotData(handle); }
+
+	// typed platform data for a handle - nullptr if it has been destroyed or isn't created yet
+	template <class U = T>
+	auto GetPlatformData(ResourceHandle handle) const -> decltype(std::declval<U&>().GetPlatformData())
 	{
-		Assert(!name.empty(), "Empty asset name!");
+		auto hotData = m_handles.GetHotData(handle);
+		return hotData ? static_cast<decltype(std::declval<U&>().GetPlatformData())>(hotData->platformData.load()) : nullptr;
+	}
 
-		auto creator = [name]()->T*
+	// call a function for every created resource
+	// each one is held by a reference while fn runs, so a resource whose last reference is being dropped is skipped rather than used after it's freed
+	void ForEach(const std::function<void(T*)>& fn)
+	{
+		for (auto& shard : m_shards)
+		{
+			// fn runs outside the lock, since releasing our reference may need to erase from this shard
+			vector<T*> resources;
+			{
+				std::shared_lock lock(shard.lock);
+				resources.reserve(shard.resources.size());
+				for (auto& [hash, entry] : shard.resources)
+				{
+					if (!entry.creating && entry.resource->TryIncRef())
+						resources.push_back(entry.resource);
+				}
+			}
+			for (auto resource : resources)
+			{
+				fn(resource);
+				Destroy(resource);
+			}
+		}
+	}
+
+	T* Create(NeoName name, int priority = AssetPriority_Normal)
+	{
+		Assert(!name.IsEmpty(), "Empty asset name!");
+
+		auto creator = [name, priority]()->T*
 		{
 			auto resource = new T;
 			resource->Init(name);
-			AssetManager::Instance().DeliverAssetDataAsync(resource->GetType(), name, nullptr, [resource](AssetData* data) { resource->OnAssetDeliver(data); });
+			resource->m_loadPriority = priority;
+			resource->m_assetRequest = AssetManager::Instance().DeliverAssetDataAsync(resource->GetType(), name.String(), nullptr, [resource](AssetData* data) { resource->OnAssetDeliver(data); }, priority);
 			return resource;
 		};
 		return Create(name, creator);
 	}
+
+	// change the load priority of a resource that is still waiting for its asset data
+	void SetLoadPriority(T* resource, int priority)
+	{
+		if (resource && !resource->IsLoaded())
+		{
+			resource->m_loadPriority = priority;
+			if (resource->m_assetRequest)
+				AssetManager::Instance().SetRequestPriority(resource->m_assetRequest, priority);
+		}
+	}
+
 	void Destroy(T* resource)
 	{
 		if (resource && resource->DecRef() == 0)
 		{
-			u64 hash = StringHash64(resource->GetName());
-			m_lock.Lock();
-			m_resources.erase(hash);
-			m_lock.Release();
+			// it may already have been replaced by a new resource of the same name
+			u64 hash = resource->GetNameId().Hash();
+			Shard& shard = ShardFor(hash);
+			{
+				std::unique_lock lock(shard.lock);
+				auto it = shard.resources.find(hash);
+				if (it != shard.resources.end() && it->second.resource == resource)
+					shard.resources.erase(it);
+			}
+			m_handles.Remove(resource->GetHandle());
+
+			// nobody wants it anymore, so don't finish loading it
+			if (resource->m_assetRequest)
+				AssetManager::Instance().CancelRequest(resource->m_assetRequest);
+			resource->CancelCreateTask();
+			resource->ReleaseDependants();
 			delete resource;
 		}
 	}
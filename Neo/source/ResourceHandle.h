@@ -0,0 +1,139 @@
+#pragma once
+
+/**************************************************************************
+ResourceHandle  -  64 bit generational handles to resources
+
+every resource gets a handle when its factory creates it.  the handle indexes
+a slot in dense per type arrays, with the data the draw loop wants (platform
+data, loaded flag) kept apart from the resource object itself, so walking
+many resources touches far fewer cache lines than chasing resource pointers.
+
+the top 44 bits of a handle are a generation that changes each time a slot
+is reused, so a handle to a destroyed resource is detected rather than
+pointing at whatever took its place.  a slot would have to be reused 2^44
+times before a stale handle could match again.
+a handle doesn't hold a reference - keep a ResourceRef for that.
+
+***************************************************************************/
+
+#include "Thread.h"
+
+typedef u64 ResourceHandle;		// 0 is never a valid handle
+
+// per slot data for the draw loop - written when a resource loads or recreates its platform data
+struct ResourceHotData
+{
+	std::atomic<ResourceHandle> handle = 0;		// handle of the resource in this slot - 0 if the slot is free
+	std::atomic<void*> platformData = nullptr;
+	std::atomic<bool> loaded = false;
+};
+
+template <class T>
+class ResourceHandleTable
+{
+	// slots live in fixed size pages that are never moved, so lookups don't need a lock
+	static const u32 IndexBits = 20;
+	static const u32 PageBits = 10;
+	static const u32 PageSize = 1 << PageBits;
+	static const u32 MaxPages = 1 << (IndexBits - PageBits);
+	static const u32 IndexMask = (1 << IndexBits) - 1;
+	static const u64 GenerationMask = (1ull << (64 - IndexBits)) - 1;
+
+	struct Page
+	{
+		ResourceHotData hot[PageSize];
+		std::atomic<T*> resources[PageSize] = {};
+		u64 generations[PageSize] = {};
+	};
+	std::atomic<Page*> m_pages[MaxPages] = {};
+
+	Mutex m_lock;
+	u32 m_usedSlots = 0;
+	vector<u32> m_freeSlots;
+
+	Page* FindPage(ResourceHandle handle) const { return (handle != 0) ? m_pages[(handle & IndexMask) >> PageBits].load() : nullptr; }
+	static u32 SlotInPage(ResourceHandle handle) { return (u32)(handle & (PageSize - 1)); }
+
+public:
+	~ResourceHandleTable()
+	{
+		for (auto& page : m_pages)
+			delete page.load();
+	}
+
+	// give a resource a slot - returns its handle and its hot data
+	ResourceHandle Add(T* resource, ResourceHotData*& hotData)
+	{
+		ScopedMutexLock lock(m_lock);
+		u32 index;
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			Assert(m_usedSlots <= IndexMask, "Out of resource handles!");
+			index = m_usedSlots++;
+			if (!m_pages[index >> PageBits].load())
+				m_pages[index >> PageBits] = new Page;
+		}
+
+		// generation 0 is skipped so a handle is never 0
+		Page* page = m_pages[index >> PageBits].load();
+		u32 slot = index & (PageSize - 1);
+		u64 generation = (page->generations[slot] + 1) & GenerationMask;
+		if (generation == 0)
+			generation = 1;
+		page->generations[slot] = generation;
+
+		ResourceHandle handle = (generation << IndexBits) | index;
+		page->resources[slot] = resource;
+		page->hot[slot].platformData = nullptr;
+		page->hot[slot].loaded = false;
+		page->hot[slot].handle = handle;
+		hotData = &page->hot[slot];
+		return handle;
+	}
+
+	// free the slot - any copies of the handle become stale
+	void Remove(ResourceHandle handle)
+	{
+		ScopedMutexLock lock(m_lock);
+		Page* page = FindPage(handle);
+		if (!page || page->hot[SlotInPage(handle)].handle != handle)
+			return;
+
+		u32 slot = SlotInPage(handle);
+		page->hot[slot].handle = 0;
+		page->hot[slot].platformData = nullptr;
+		page->hot[slot].loaded = false;
+		page->resources[slot] = nullptr;
+		m_freeSlots.push_back((u32)(handle & IndexMask));
+	}
+
+	// hot data for a handle, or nullptr if the handle is stale
+	const ResourceHotData* GetHotData(ResourceHandle handle) const
+	{
+		Page* page = FindPage(handle);
+		if (!page)
+			return nullptr;
+		const ResourceHotData& hot = page->hot[SlotInPage(handle)];
+		return (hot.handle == handle) ? &hot : nullptr;
+	}
+
+	// resource for a handle, or nullptr if the handle is stale
+	T* Resolve(ResourceHandle handle) const
+	{
+		Page* page = FindPage(handle);
+		if (!page)
+			return nullptr;
+
+		// check the handle both sides of the read, in case the slot is reused in between
+		u32 slot = SlotInPage(handle);
+		if (page->hot[slot].handle != handle)
+			return nullptr;
+		T* resource = page->resources[slot].load();
+		return (page->hot[slot].handle == handle) ? resource : nullptr;
+	}
+};
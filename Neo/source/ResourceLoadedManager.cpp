@@ -4,76 +4,89 @@
 
 DECLARE_MODULE(ResourceLoadedManager, NeoModuleInitPri_ResourceLoadedManager, NeoModulePri_None);
 
+ResourceDependant ResourceLoadedManager::s_loadedMarker = { nullptr, nullptr };
+
 void ResourceLoadedManager::SignalResourceLoaded(Resource* resource)
 {
-	// find any callbacks to this resource
-	ScopedMutexLock lock(m_mutex);
-
 	LOG(Asset, STR("<< COMPLETED: {} [{}]",resource->GetName(), resource->GetType()));
 
-	// we need to do this here, so it is mutex locked
+	// mark loaded before closing the list, so anyone who finds the list closed also sees the resource as loaded
 	resource->MarkIsLoaded();
+	ResolveDependants(resource);
+}
+
+void ResourceLoadedManager::SignalResourceDestroyed(Resource* resource)
+{
+	// a dependant can't be left waiting for a load that will never happen - it goes ahead without this resource
+	if (resource->m_dependants.load() != &s_loadedMarker)
+		LOG(Asset, STR("<< DESTROYED before loading: {} [{}]", resource->GetName(), resource->GetType()));
+	ResolveDependants(resource);
+}
+
+void ResourceLoadedManager::ResolveDependants(Resource* resource)
+{
+	// close the list and take everything that was waiting on this resource
+	auto link = resource->m_dependants.exchange(&s_loadedMarker);
+	if (link == &s_loadedMarker)
+		return;
 
-	auto it = m_dependancyLists.begin();
-	while (it != m_dependancyLists.end())
+	while (link)
 	{
-		auto depInfo = *it;
-		// check all the resources in this dependancy that match this resources
-		for (auto dep : depInfo->dependancies)
+		auto next = link->next;
+		ResolveDependancy(link->info);
+		delete link;
+		link = next;
+	}
+}
+
+bool ResourceLoadedManager::AddDependant(Resource* dependancy, DependancyInfo* info)
+{
+	auto link = new ResourceDependant{ info, nullptr };
+	auto head = dependancy->m_dependants.load();
+	do
+	{
+		if (head == &s_loadedMarker)
 		{
-			if (dep == resource)
-			{
-				depInfo->completed++;
-			}
+			delete link;
+			return false;
 		}
+		link->next = head;
+	} while (!dependancy->m_dependants.compare_exchange_weak(head, link));
+	return true;
+}
 
-		LOG(Asset, STR("  deps: {}[{}] {}/{}", depInfo->resource->GetName(), depInfo->resource->GetType(), depInfo->completed, depInfo->dependancies.size()));
+void ResourceLoadedManager::ResolveDependancy(DependancyInfo* info)
+{
+	// another thread may take the count to zero and free the block as soon as we decrement it
+	auto resource = info->resource;
+	int remaining = --info->remaining;
+	LOG(Asset, STR("  deps: {}[{}] {} remaining", resource->GetName(), resource->GetType(), remaining));
 
-		// if our total completed matches are resources count, then we are done
-		if (depInfo->completed == depInfo->dependancies.size())
-		{
-			// fire off the graphics task for creating the resource platform dependant data
-			RenderThread::Instance().AddPreDrawTask(depInfo->task);
-			delete depInfo;
-			it = m_dependancyLists.erase(it);
-		}
-		else
-		{
-			it++;
-		}
+	// the last dependancy is in, fire off the graphics task for creating the resource platform dependant data
+	if (remaining == 0)
+	{
+		resource->AddCreateTask(info->task);
+		delete info;
 	}
 }
 
 void ResourceLoadedManager::AddDependancyList(Resource *resource, vector<Resource*>& list, GenericCallback cb)
 {
 	// create a new dependancy block
-	ScopedMutexLock lock(m_mutex);
+	// the extra count stops the block completing while it's still being added to the lists
+	auto depInfo = new DependancyInfo;
+	depInfo->resource = resource;
+	depInfo->task = cb;
+	depInfo->remaining = (int)list.size() + 1;
 
-	// first check if we have any to wait on, before bothering with creating a dependancy block
-	int completed = 0;
 	for (auto res : list)
 	{
-		if (res->IsLoaded())
-			completed++;
+		// already loaded, so there's nothing to wait on
+		if (!AddDependant(res, depInfo))
+			depInfo->remaining--;
 	}
+	list.clear();
 
-	if (completed < list.size())
-	{
-		// ok, we have some resources to wait on...
-		auto depInfo = new DependancyInfo;
-		depInfo->resource = resource;
-		depInfo->dependancies = std::move(list);
-		depInfo->completed = completed;
-		depInfo->task = cb;
-		m_dependancyLists.push_back(depInfo);
-	}
-	else
-	{
-		// all dependants have already loaded, so we can just fire off the task now
-		RenderThread::Instance().AddPreDrawTask(cb);
-	}
+	// drop the set up count - if all dependants have already loaded, this fires off the task now
+	ResolveDependancy(depInfo);
 }
-
-
-
-
@@ -7,28 +7,41 @@
 #include <functional>
 
 // simple module that allows for thread safe callbacks when resources are finished loading
-// for now we are using a bit of brute force in that we only have one directional links
-// - that is, each time a resource is loaded, we need to search all dependancy lists for anything that is waiting on this
-// if we get performance issues, we could tack a list onto every resource of resources that are dependant on that resource
-// -- this would be more complex and eat more memory, so I'll only do that if the current method becomes a performance issue
-// none of this is happening on any critical thread, so not expecting this to be a performance bottleneck
+// each resource keeps a list of the dependancy blocks waiting on it, and each block counts down the dependancies it still needs
+// - so a resource finishing only touches its own dependants, and nothing takes a lock
+// the list is a lock free stack that is swapped for a 'loaded' marker when the resource completes, after which nothing else can be added
+
+// a resource waiting on a list of dependancies before its task can run
+struct ResourceDependancyInfo
+{
+	Resource* resource;
+	GenericCallback task;
+	std::atomic<int> remaining;		// dependancies not loaded yet, +1 while the block is still being set up
+};
+
+// one link for each dependancy a block waits on - pushed onto that dependancy's list
+struct ResourceDependant
+{
+	ResourceDependancyInfo* info;
+	ResourceDependant* next;
+};
 
 class ResourceLoadedManager : public Module<ResourceLoadedManager>
 {
-	struct DependancyInfo
-	{
-		Resource* resource;
-		GenericCallback task;
-		vector<Resource*> dependancies;
-		int completed = 0;
-	};
-	vector<DependancyInfo*> m_dependancyLists;
-
-	// this mutex locks any resources so they can only complete once at a time, and can't complete if this module is currently looking at a dependancy list
-	Mutex m_mutex;
+	typedef ResourceDependancyInfo DependancyInfo;
+
+	// head of a resource's dependant list once it has loaded
+	static ResourceDependant s_loadedMarker;
+
+	// returns false if the dependancy has already loaded
+	bool AddDependant(Resource* dependancy, DependancyInfo* info);
+	void ResolveDependancy(DependancyInfo* info);
+	void ResolveDependants(Resource* resource);
 
 public:
 	void SignalResourceLoaded(Resource* resource);
+
+	// the resource is being destroyed before it loaded - anything waiting on it is released, so it doesn't wait forever
+	void SignalResourceDestroyed(Resource* resource);
 	void AddDependancyList(Resource* resource, vector<Resource*>& list, GenericCallback cb);
 };
-
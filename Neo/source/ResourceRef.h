@@ -24,6 +24,9 @@ public:
 	T* operator ->() const        { return const_cast<T*>(m_ptr); }
 	operator T *() const          { return const_cast<T*>(m_ptr); }
 
+	// generational handle of the resource - stays detectably stale once the resource is destroyed
+	ResourceHandle Handle() const { return m_ptr ? m_ptr->GetHandle() : 0; }
+
 	bool operator==(T *o) const   { return m_ptr == o; }
 	bool operator!=(T *o) const   { return m_ptr != o; }
 
@@ -66,12 +69,26 @@ public:
 		Destroy();
 	}
 
-	void Create(const string &name)
+	void Create(NeoName name)
 	{
 		Destroy();
 		m_ptr = F::Instance().Create(name);
 	}
 
+	// create with a load priority (see AssetPriority) - higher priorities arrive first
+	void Create(NeoName name, int priority)
+	{
+		Destroy();
+		m_ptr = F::Instance().Create(name, priority);
+	}
+
+	// re-prioritize the load as the resource becomes more or less important (ie. comes into view)
+	void SetLoadPriority(int priority)
+	{
+		if (m_ptr)
+			F::Instance().SetLoadPriority(m_ptr, priority);
+	}
+
 protected:
 	// on Destroy we just reduce ref count, factory will destroy the
 	void Destroy()
@@ -2,668 +2,635 @@
 #include "SHAD.h"
 #include "StringUtils.h"
 
-SHAD::SHAD(const string &path, int _tabsize) :  root(0), tabsize(_tabsize)
-{
-	LoadResource(path,2);
-}
+#include <bit>
+#include <charconv>
 
-SHAD::SHAD(int _tabsize) : tabsize(_tabsize)
-{
-	root = new SHAD_Node;
-}
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SHAD_SSE2
+#endif
 
-SHAD::SHAD(const char *pMem, int memsize, int tabsize)
-{
-	Parse(pMem, memsize, tabsize);
-}
+#define SHAD_ARENA_BLOCK_SIZE (64 * 1024)
 
-SHAD::~SHAD()
-{
-	if (root)
-	{
-		root->DeleteChildren();
-		delete root;
-	}
-}
+//===========================================================================
+// tokenizer
 
-bool SHAD::Write(const string &path, const string &titleComment)
+// first character in [p, end) that can end or change a token, or end
+// anything else is copied straight through, so a whole token is found in one scan
+static inline bool SHAD_IsSpecial(char ch, char delimiter)
 {
-	FileManager &fm = FileManager::Instance();
-	FileHandle fh;
-	if (fm.StreamWriteBegin(fh, path))
-	{
-		if (!titleComment.empty())
-			fm.StreamWrite(fh, STR("#{}\n",titleComment));
-
-		int indent = 0;
-		if (root)
-		{
-			for (int i=0; i<root->GetChildCount(); i++)
-			{
-				root->GetChild(i)->Write(fh, indent);
-			}
-		}
-		fm.StreamWriteEnd(fh);
-		return true;
-	}
-	return false;
+	return ch == 13 || ch == 10 || ch == '#' || ch == '{' || ch == '"' || ch == '&' || ch == delimiter;
 }
 
-void SHAD_Node::Write(FileHandle fh, int indent) const
+static const char* SHAD_FindSpecial(const char* p, const char* end, char delimiter)
 {
-	FileManager &fm = FileManager::Instance();
-	for (int i=0; i<indent; i++)
-		fm.StreamWrite(fh, "\t");
-
-	if (StringContainsAny(name, ":#,"))
-		fm.StreamWrite(fh, STR("\"{}\"", name));
-	else
-		fm.StreamWrite(fh, name);
-
-	if (values.size() > 0)
+#if defined(SHAD_SSE2)
+	const __m128i cr = _mm_set1_epi8(13);
+	const __m128i lf = _mm_set1_epi8(10);
+	const __m128i hash = _mm_set1_epi8('#');
+	const __m128i brace = _mm_set1_epi8('{');
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i amp = _mm_set1_epi8('&');
+	const __m128i delim = _mm_set1_epi8(delimiter);
+	for (; end - p >= 16; p += 16)
 	{
-		fm.StreamWrite(fh, ": ");
-		for (u32 i=0; i<values.size()-1; i++)
-		{
-			if (StringContainsAny(values[i], ":#,"))
-				fm.StreamWrite(fh, STR("\"{}\",", values[i]));
-			else
-				fm.StreamWrite(fh, STR("{},", values[i]));
-		}
-
-		if (StringContainsAny(values[values.size() - 1],":#,"))
-			fm.StreamWrite(fh, STR("\"{}\"", values[values.size() - 1]));
-		else
-			fm.StreamWrite(fh, STR("{}", values[values.size() - 1]));
+		__m128i chars = _mm_loadu_si128((const __m128i*)p);
+		__m128i hits = _mm_or_si128(_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, cr), _mm_cmpeq_epi8(chars, lf)), _mm_or_si128(_mm_cmpeq_epi8(chars, hash), _mm_cmpeq_epi8(chars, brace))),
+			_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, amp)), _mm_cmpeq_epi8(chars, delim)));
+		int mask = _mm_movemask_epi8(hits);
+		if (mask != 0)
+			return p + std::countr_zero((u32)mask);
 	}
-	fm.StreamWrite(fh, "\r\n");
-
-	for (u32 i=0; i<children.size(); i++)
-	{
-		children[i]->Write(fh, indent+1);
-	}
-
-	if (isHeading)
-		fm.StreamWrite(fh, "\r\n");
+#endif
+	while (p < end && !SHAD_IsSpecial(*p, delimiter))
+		p++;
+	return p;
 }
 
-void SHAD::LoadResource(const string &path, int tabsize)
+static inline bool SHAD_IsSpace(char ch)
 {
-	MemBlock filemem;
-	if (FileManager::Instance().Read(path, filemem))
-	{
-		//DMLOG("Parse SHAD File: %s, size: %d",path.CStr(),size);
-		Parse((char *)filemem.Mem(), (int)filemem.Size(), tabsize);
-	}
+	return ch == ' ' || ch == '\t';
 }
 
-const char *FastTokenizer::TokenizeString(const char * &pIn, char * &pOut, const char *pOutEnd, const char *pEnd, char endDelimiter)
+// read a token up to the delimiter, end of line, comment or open bracket
+// plain tokens are views into the source, tokens with quotes or escapes are unpacked into the arena
+bool SHAD::TokenizeString(const char * &pIn, char endDelimiter, string_view &token, bool &hitToken)
 {
-	const char *pString = pOut;
-	const char *pLastAdded = pOut;
+	const char *pEnd = m_parseMem + m_parseSize;
+	bool validString = false;
+	hitToken = false;
 
-	bool inQuotes=false;
-	while (pIn < pEnd && *pIn != 13 && (inQuotes || (*pIn != endDelimiter && *pIn != '#')))
+	while (pIn < pEnd && SHAD_IsSpace(*pIn))
+		pIn++;
+
+	const char *pStart = pIn;
+	pIn = SHAD_FindSpecial(pIn, pEnd, endDelimiter);
+	if (pIn < pEnd && (*pIn == '"' || *pIn == '&'))
 	{
-		if (*pIn == '"')
-		{
-			inQuotes = !inQuotes;
-			pIn++;
-		}
-		else if (!inQuotes && *pIn == '&')
+		// slow path - unpack the token into the scratch buffer
+		m_scratch.assign(pStart, pIn);
+		size_t lastAdded = 0;
+		bool inQuotes = false;
+		while (pIn < pEnd && (*pIn != 13 && *pIn != 10) && (inQuotes || (*pIn != endDelimiter && *pIn != '#' && *pIn != '{')))
 		{
-			if (strncmp(pIn, "&quot;", 6) == 0)
+			if (*pIn == '"')
 			{
-				*pOut++ = '"';
-				pIn += 6;
-			}
-			else if (strncmp(pIn, "&cr;", 4) == 0)
-			{
-				*pOut++ = '\n';
-				pIn += 4;
+				inQuotes = !inQuotes;
+				pIn++;
+				validString = true;
 			}
-			else if (strncmp(pIn, "&amp;", 4) == 0)
+			else if (!inQuotes && *pIn == '&')
 			{
-				*pOut++ = '&';
-				pIn += 4;
+				if (strncmp(pIn, "&quot;", 6) == 0)
+				{
+					m_scratch += '"';
+					pIn += 6;
+				}
+				else if (strncmp(pIn, "&cr;", 4) == 0)
+				{
+					m_scratch += '\n';
+					pIn += 4;
+				}
+				else if (strncmp(pIn, "&amp;", 5) == 0)
+				{
+					m_scratch += '&';
+					pIn += 5;
+				}
+				else
+				{
+					m_scratch += *pIn++;
+				}
 			}
 			else
 			{
-				*pOut++ = *pIn++;
+				m_scratch += *pIn++;
+				if (inQuotes)
+					lastAdded = m_scratch.size();
 			}
 		}
-		else
-		{
-			*pOut++ = *pIn++;
-			if (inQuotes)
-				pLastAdded = pOut;
-		}
-		Assert(pOut<pOutEnd, "SHAD file block size too big!");
-	}
 
-	// strip off dead space...
-	char *pStringEnd = pOut;
-	while (pStringEnd > pLastAdded && (pStringEnd[-1] == ' ' || pStringEnd[-1] == '\t' || pStringEnd[-1] == 13 || pStringEnd[-1] == 10))
-		pStringEnd--;
-	*pStringEnd++ = 0;
-	pOut = pStringEnd;
+		// strip off dead space, but not from inside quotes
+		size_t length = m_scratch.size();
+		while (length > lastAdded && SHAD_IsSpace(m_scratch[length - 1]))
+			length--;
+		token = AllocString(string_view(m_scratch.data(), length));
+	}
+	else
+	{
+		const char *pTokenEnd = pIn;
+		while (pTokenEnd > pStart && SHAD_IsSpace(pTokenEnd[-1]))
+			pTokenEnd--;
+		token = string_view(pStart, pTokenEnd - pStart);
+	}
 
 	// skip delimiter
-	if (*pIn == endDelimiter)
+	if (pIn < pEnd && *pIn == endDelimiter)
+	{
+		validString = true;
+		hitToken = true;
 		pIn++;
+	}
 
 	// skip dead space
-	while (pIn<pEnd && (*pIn == ' ' || *pIn == '\t'))
+	while (pIn < pEnd && SHAD_IsSpace(*pIn))
 		pIn++;
 
-	return pString;
-}
-
-FastTokenizer::~FastTokenizer()
-{
-	delete pStringData;
-	for (unsigned int i = 0; i < lines.size(); i++)
-		lines[i].tokens.clear();
+	return !token.empty() || validString;
 }
 
-FastTokenizer::FastTokenizer(const char *pData, u32 size)
+bool SHAD::ParseName(string_view &name, int &indent)
 {
-	pStringData = new char[size];
-	char *pOut = pStringData;
-	char *pOutEnd = pStringData+size;
+	const char *pIn = m_parseMem + m_parsed;
+	const char *pEnd = m_parseMem + m_parseSize;
 
-	const char *pIn = pData;
-	const char *pEnd = pData+size;
-	while (pIn<pEnd && *pIn)
+	// skip previous eol
+	while (pIn < pEnd && (*pIn == 13 || *pIn == 10))
 	{
-		// parse line
-		FastTokenizer_LineData ld;
-		ld.indent = 0;
+		if (*pIn == 10)
+			m_currentLine++;
+		pIn++;
+	}
 
-		// count the indents
-		while (pIn < pEnd && (*pIn == ' ' || *pIn == '\t'))
-		{
-			ld.indent++;
-			pIn++;
-		}
+	// count the indents
+	indent = 0;
+	while (pIn < pEnd && SHAD_IsSpace(*pIn))
+	{
+		indent++;
+		pIn++;
+	}
 
-		// comment? just skip the line
-		if (*pIn == '#')
-		{
-			while (pIn < pEnd && (*pIn != 13 && *pIn != 10))
-				pIn++;
-			while (pIn < pEnd && (*pIn == 13 || *pIn == 10))
-				pIn++;
-			continue;
-		}
+	if (pIn >= pEnd)
+	{
+		m_parsed = (int)(pIn - m_parseMem);
+		return false;
+	}
 
-		// ok, this is the first char of the first token...  ends with # or : or EOL
-		ld.AddToken(TokenizeString(pIn, pOut, pOutEnd, pEnd, ':'));
+	// comment? just skip the line. report that there was no name found...
+	if (*pIn == '#' || *pIn == ';')
+	{
+		while (pIn < pEnd && (*pIn != 13 && *pIn != 10))
+			pIn++;
+		m_parsed = (int)(pIn - m_parseMem);
+		return false;
+	}
 
-		// are there more?
-		while (pIn<pEnd && (*pIn != 13 && *pIn != 10) && *pIn != '#')
-			ld.AddToken(TokenizeString(pIn, pOut, pOutEnd, pEnd, ','));
+	// end of bracket section?
+	if (*pIn == '}')
+	{
+		m_bracketIndent--;
+		pIn++;
+		m_parsed = (int)(pIn - m_parseMem);
+		return false;
+	}
 
-		// skip comment
-		if (*pIn == '#')
-		{
-			while (pIn<pEnd && (*pIn != 13 && *pIn != 10))
-				pIn++;
-		}
+	bool hitColon;
+	bool success = TokenizeString(pIn, ':', name, hitColon);
 
-		// skip EOL
-		while (pIn<pEnd && (*pIn == 13 || *pIn == 10))
+	// no name - skip the rest of the line
+	if (!success)
+	{
+		while (pIn < pEnd && (*pIn != 13 && *pIn != 10))
 			pIn++;
-
-		// thats it. we got the line and all its stringy goodness
-		lines.push_back(ld);
 	}
+	m_parsed = (int)(pIn - m_parseMem);
+	return success;
 }
 
-void SHAD::CreateNodeFromTokenizer( SHAD_Node &parentNode, FastTokenizer &ft, int &lineIdx)
+bool SHAD::ParseValue(string_view &value)
 {
-	FastTokenizer_LineData &line = ft.lines[lineIdx];
-	int indent = line.indent;
-
-	SHAD_Node *pNode = new SHAD_Node();
-	pNode->SetParent(&parentNode);
-	pNode->SetIndent(indent);
-	pNode->SetName(line.Token(0));
-	for (int i=1; i<line.GetCount(); i++)
-		pNode->AddString(line.Token(i));
-	lineIdx++;
-
-	while (lineIdx < (int)ft.lines.size() && ft.lines[lineIdx].indent > indent)
-		CreateNodeFromTokenizer(*pNode, ft, lineIdx);
+	const char *pIn = m_parseMem + m_parsed;
+	const char *pEnd = m_parseMem + m_parseSize;
+
+	bool hitComma;
+	bool success = TokenizeString(pIn, ',', value, hitComma);
+
+	// if line ends in ',' we assume next line continues the values...
+	// so just skip all white space and EOL now...
+	if (hitComma)
+	{
+		while (pIn < pEnd && (*pIn == 13 || *pIn == 10 || SHAD_IsSpace(*pIn)))
+		{
+			if (*pIn == 10)
+				m_currentLine++;
+			pIn++;
+		}
+	}
+
+	m_parsed = (int)(pIn - m_parseMem);
+	return success;
 }
 
-void SHAD::Parse( const char *data, int size, int _tabsize )
+bool SHAD::ReadLine(ParsedLine &line)
 {
-	tabsize = _tabsize;
-	//const char* delimiters = "\n";
+	while (m_parsed < m_parseSize)
+	{
+		// grab a name
+		int indent;
+		string_view name;
+		if (!ParseName(name, indent))
+			continue;
 
-	FastTokenizer ft(data,size);
+		if (indent != 0 && m_bracketIndent == 0)
+		{
+			if (m_tabSize == -1)
+				m_tabSize = indent;
+			if ((indent % m_tabSize) != 0 && m_errorsLogged<10)
+			{
+				LOG(SHAD, STR("{}({}): has bad indent of {} (should be multiple of first indent: {})!", m_filename, m_currentLine, indent, m_tabSize));
+				m_errorsLogged++;
+			}
+		}
 
-	int lineIdx = 0;
-	int indent = -1;
+		line.name = name;
+		line.line = m_currentLine;
+		line.indent = (m_bracketIndent != 0) ? m_bracketIndent : indent;
+		line.firstValue = (u32)m_values.size();
 
-	root = new SHAD_Node();
-	root->SetIndent(indent);
-	root->SetName("root");
+		string_view value;
+		while (ParseValue(value))
+			m_values.push_back(value);
+		line.valueCount = (u32)m_values.size() - line.firstValue;
 
-	while (lineIdx < (int)ft.lines.size())
-		CreateNodeFromTokenizer(*root, ft, lineIdx);
+		if (m_parsed < m_parseSize && m_parseMem[m_parsed] == '{')
+		{
+			line.indent = m_bracketIndent;
+			m_bracketIndent++;
+			m_parsed++;
+		}
+		return true;
+	}
+	return false;
 }
 
+//===========================================================================
+// document
 
-void SHAD_Node::DeleteChildren()
+SHAD::SHAD()
 {
-	for (unsigned int i=0; i<children.size(); i++) 
-	{ 
-		children[i]->DeleteChildren(); 
-		delete children[i]; 
-	}
-	children.clear(); 
+	root = AllocNodes(1);
+	InitNode(root, nullptr);
+	root->m_name = "root";
+	root->m_indent = -1;
 }
 
-
-
-//===========================================================================
-//===========================================================================
-
-SHADReader::SHADReader(const string &path)
+SHAD::SHAD(const string &path)
 {
-    m_tokenizeBuffer = 0;
-    root = 0;
-	m_filename=path;
-	m_heapMem=0;
-	MemBlock filemem;
-	if (FileManager::Instance().Read(path, filemem) != 0)
-	{
-        m_tokenizeBuffer = new char[256 * 1024];
-		Parse((char *)filemem.Mem(), (int)filemem.Size());
-        delete[] m_tokenizeBuffer;
-        m_tokenizeBuffer = 0;
-	}
+	m_filename = path;
+	if (FileManager::Instance().Read(path, m_fileMem))
+		Parse((const char *)m_fileMem.Mem(), (int)m_fileMem.Size());
+	else
+		Parse(nullptr, 0);
 }
 
-SHADReader::SHADReader(const string &name, const char *pMem, int memSize)
+SHAD::SHAD(const string &name, const char *pMem, int memSize)
 {
-	m_ownMemory = false;
-	m_filename=name;
-	m_heapMem=0;
-	m_tokenizeBuffer = new char[256 * 1024];
+	m_filename = name;
 	Parse(pMem, memSize);
 }
 
-SHADReader::~SHADReader()
+SHAD::~SHAD()
 {
-	if (m_ownMemory)
-		delete[] m_heapMem;
-	delete[] m_tokenizeBuffer;
+	for (auto block : m_arenaBlocks)
+		delete[] block;
 }
 
-u8 *SHADReader::FastAlloc(int size)
+u8 *SHAD::Alloc(size_t size, size_t align)
 {
-	// we can't grow because everything is pointing inside our memory... so assert...
-	// if it becomes a problem getting the size right, we should us offsets in the nodes instead of pointers...
-	Assert(m_heapUsage+size <= m_heapSize, STR("SHAD Reader out of memory: FileMem {}, BufferSize {}  (Nodes {}, Values {})",m_fileSize,m_heapSize,m_nodeCount,m_valueCount));
+	size_t padding = (align - ((uintptr_t)m_arenaPos & (align - 1))) & (align - 1);
+	if (!m_arenaPos || padding + size > m_arenaRemaining)
+	{
+		size_t blockSize = Max(size + align, (size_t)SHAD_ARENA_BLOCK_SIZE);
+		u8 *block = new u8[blockSize];
+		m_arenaBlocks.push_back(block);
+		m_arenaPos = block;
+		m_arenaRemaining = blockSize;
+		padding = (align - ((uintptr_t)m_arenaPos & (align - 1))) & (align - 1);
+	}
 
-	u8 *allocedMem = m_heapMem + m_heapUsage;
-	m_heapUsage = (m_heapUsage+size+3)&(~3);
-	return allocedMem;
+	u8 *mem = m_arenaPos + padding;
+	m_arenaPos += padding + size;
+	m_arenaRemaining -= padding + size;
+	return mem;
 }
 
-SHADReader_Node *SHADReader::AllocNode()
+string_view SHAD::AllocString(string_view str)
 {
-	SHADReader_Node *node = (SHADReader_Node *)FastAlloc(sizeof(SHADReader_Node));
-	node->parent = 0;
-	node->name = 0;
-	node->childCount = 0;
-	node->children = 0;
-	node->next = 0;
-	node->valueCount = 0;
-	node->values = 0;
-	m_nodeCount++;
-	return node;
+	if (str.empty())
+		return string_view();
+	char *mem = (char *)Alloc(str.size(), 1);
+	memcpy(mem, str.data(), str.size());
+	return string_view(mem, str.size());
 }
 
-u8 *SHADReader::DupMem(u8 *source, int size)
+SHAD_Node *SHAD::AllocNodes(u32 count)
 {
-	u8 *mem = FastAlloc(size);
-	memcpy(mem, source, size);
-	return mem;
+	return (SHAD_Node *)Alloc(sizeof(SHAD_Node) * count, alignof(SHAD_Node));
 }
 
+void SHAD::InitNode(SHAD_Node *node, SHAD_Node *parent)
+{
+	node->m_doc = this;
+	node->m_parent = parent;
+	node->m_name = string_view();
+	node->m_values = nullptr;
+	node->m_children = nullptr;
+	node->m_childHash = nullptr;
+	node->m_valueCount = 0;
+	node->m_valueCapacity = 0;
+	node->m_childCount = 0;
+	node->m_childCapacity = 0;
+	node->m_childHashSize = 0;
+	node->m_indent = parent ? parent->m_indent + 1 : -1;
+	node->m_isHeading = false;
+}
 
-void SHADReader::Parse( const char *data, int size )
+void SHAD::Parse(const char *data, int size)
 {
-	m_bracketIndent = 0;
-	m_currentLine = 1;
-	m_errorsLogged = 0;
+	m_parseMem = data;
+	m_parseSize = size;
+	m_parsed = 0;
 
-	if (m_heapMem)
-		delete[] m_heapMem;
+	// a rough guess at the line count, to save regrowing the lists
+	m_lines.reserve(size / 32 + 16);
+	m_values.reserve(size / 16 + 16);
 
-	// SHAD file shouldn't take more than twice the source file memory plus some overhead for small files...
-	m_heapSize = size*6+10000;
-	m_heapUsage = 0;
-	m_heapMem = new u8[m_heapSize];
+	ParsedLine line;
+	while (ReadLine(line))
+		m_lines.push_back(line);
 
-	// we don't know the tabsize yet...
-	m_tabSize = -1;
+	// all the values go in one table, each node points at its run
+	if (!m_values.empty())
+	{
+		m_valueTable = (string_view *)Alloc(sizeof(string_view) * m_values.size(), alignof(string_view));
+		std::copy(m_values.begin(), m_values.end(), m_valueTable);
+	}
 
-	m_nodeCount = 0;
-	m_valueCount = 0;
+	root = AllocNodes(1);
+	InitNode(root, nullptr);
+	root->m_name = "root";
 
-	root = AllocNode();
-	root->indent = -1;
-	m_fileMem = data;
-	m_fileSize = size;
-	m_fileParsed = 0;
+	size_t lineIdx = 0;
+	BuildChildren(root, lineIdx);
 
-	SHADReader_Node *firstChild = ReadNode();
-	if (firstChild)
-		ParseNode(root,firstChild);
+	// only the arena is kept
+	m_lines = vector<ParsedLine>();
+	m_values = vector<string_view>();
+	m_scratch = string();
 }
 
-SHADReader_Node *SHADReader::ReadNode()
+// children of a node are the following lines with a greater indent, so count them first and then fill in one contiguous array
+void SHAD::BuildChildren(SHAD_Node *parent, size_t &lineIdx)
 {
-	while (m_fileParsed < m_fileSize)
+	size_t start = lineIdx;
+	if (start >= m_lines.size() || m_lines[start].indent <= parent->m_indent)
+		return;
+
+	int childIndent = m_lines[start].indent;
+	size_t end = start;
+	u32 count = 0;
+	while (end < m_lines.size() && m_lines[end].indent > parent->m_indent)
 	{
-		// grab a name
-		int indent;
-		const char *name;
-		if (!ParseName(name, indent))
-			continue;
-
-		if (indent != 0 && m_bracketIndent == 0)
+		if (m_lines[end].indent == childIndent)
 		{
-			if (m_tabSize == -1)
-				m_tabSize = indent;
-			if ((indent % m_tabSize) != 0 && m_errorsLogged<10)
-			{
-				LOG(SHAD, STR("{}({}): has bad indent of {} (should be multiple of first indent: {})!", m_filename, m_currentLine, indent, m_tabSize));
-				m_errorsLogged++;
-			}
-		}
-
-		SHADReader_Node *node = AllocNode();
-		node->name = name;
-		node->indent = (m_bracketIndent != 0) ? m_bracketIndent : indent;
-
-		vector<const char *> valuelist;
-
-		// get the values - we support up to 1024 values...
-		int valueCount = 0;
-		const char *currValue;
-		while (ParseValue(currValue))
-		{
-			valuelist.push_back(currValue);
-			valueCount++;
-		}
-
-		// copy the values in
-		if (valueCount > 0)
-		{
-			node->valueCount = valueCount;
-			node->values = (const char **)DupMem((u8*)&valuelist[0], valueCount*sizeof(const char *));
-			m_valueCount += valueCount;
+			count++;
 		}
-
-		if (m_fileMem[m_fileParsed] == '{')
+		else if (m_lines[end].indent < childIndent)
 		{
-			node->indent = m_bracketIndent;
-			m_bracketIndent++;
-			m_fileParsed++;
+			LOG(SHAD, STR("{}({}) Aborting parse: Unexpected node indent {}", m_filename, m_lines[end].line, m_lines[end].indent));
+			m_parseAborted = true;
+			break;
 		}
+		end++;
+	}
 
-		//DMLOG("ReadNode: %s(%d), values %d (%s)",node->name,node->indent,node->valueCount,node->valueCount>0?node->values[0]:"");
-		return node;
+	parent->m_children = AllocNodes(count);
+	parent->m_childCapacity = count;
+	size_t idx = start;
+	while (idx < end && !m_parseAborted)
+	{
+		ParsedLine &line = m_lines[idx++];
+		SHAD_Node *node = &parent->m_children[parent->m_childCount++];
+		InitNode(node, parent);
+		node->m_name = line.name;
+		node->m_indent = line.indent;
+		node->m_values = m_valueTable + line.firstValue;
+		node->m_valueCount = node->m_valueCapacity = line.valueCount;
+
+		BuildChildren(node, idx);
 	}
-	return 0;
+	lineIdx = end;
+
+	if (parent->m_childCount >= SHAD_CHILD_HASH_MIN)
+		parent->BuildChildHash();
 }
 
-SHADReader_Node *SHADReader::ParseNode(SHADReader_Node *parent, SHADReader_Node *firstChild)
+bool SHAD::Write(const string &path, const string &titleComment)
 {
-	//  scLog("ParseNode parent %s(%d),  child %s(%d)",parent->name?parent->name:"root",parent->indent,firstChild->name,firstChild->indent);
-
-	SHADReader_Node *node = firstChild;
-	SHADReader_Node *endChild = firstChild;
-	while (node && node->indent > parent->indent)
+	FileManager &fm = FileManager::Instance();
+	FileHandle fh;
+	if (fm.StreamWriteBegin(fh, path))
 	{
-		if (node->indent == firstChild->indent)
-		{
-			// sibling...
-			node->parent = parent;
-			parent->childCount++;
-			endChild->next = node;
-			endChild = node;
-
-			//      scLog("%s(%d) is a sibling. Parent '%s' has %d children",node->name,node->indent,parent->name?parent->name:"root",parent->childCount);
-
-			node = ReadNode();
-		}
-		else if (node->indent > endChild->indent)
-		{
-			//scLog("%s(%d) is a child... recursing...",node->name,node->indent);
+		if (!titleComment.empty())
+			fm.StreamWrite(fh, STR("#{}\n",titleComment));
 
-			// child of the endChild node
-			node = ParseNode(endChild, node);
-		}
-		else
+		int indent = 0;
+		if (root)
 		{
-			LOG(SHAD, STR("{}({}) Aborting parse: Unexpected node indent {}", m_filename, m_currentLine, node->indent));
-			parent->childCount = 0;
-			return 0;
+			for (int i=0; i<root->GetChildCount(); i++)
+			{
+				root->GetChild(i)->Write(fh, indent);
+			}
 		}
+		fm.StreamWriteEnd(fh);
+		return true;
 	}
+	return false;
+}
 
-	//  scLog("Finished parsing parent %s(%d), children %d",parent->name?parent->name:"root",parent->indent,parent->childCount);
-
-	// alloc the parent children array pointer...
-	if (parent->childCount > 0)
-	{
-		parent->children = (SHADReader_Node**)FastAlloc(sizeof(SHADReader_Node*)*parent->childCount);
-		for (u32 i=0; i<parent->childCount; i++)
-		{
-			parent->children[i] = firstChild;
-			firstChild = firstChild->next;
-		}
-	}
+//===========================================================================
+// nodes
 
-	return node;
+void SHAD_Node::InsertChildHash(u32 index)
+{
+	u32 mask = m_childHashSize - 1;
+	u32 slot = SHAD_HashName(m_children[index].m_name) & mask;
+	while (m_childHash[slot] != 0)
+		slot = (slot + 1) & mask;
+	m_childHash[slot] = index + 1;
 }
 
-bool SHADReader::ParseName(const char * &name, int &indent)
+void SHAD_Node::BuildChildHash()
 {
-	const char *pIn = &m_fileMem[m_fileParsed];
-	const char *pEnd = &m_fileMem[m_fileSize];
-
-	// skip previous eol
-	while (pIn < pEnd && (*pIn == 13 || *pIn == 10))
-	{
-		if (*pIn == 13)
-			m_currentLine++;
-
-		pIn++;
-	}
-
-	// count the indents
-	indent = 0;
-	while (pIn < pEnd && (*pIn == ' ' || *pIn == '\t'))
-	{
-		indent++;
-		pIn++;
-	}
+	// sized for the capacity, so it stays at most half full as children are added
+	m_childHashSize = std::bit_ceil(m_childCapacity * 2);
+	m_childHash = (u32 *)m_doc->Alloc(sizeof(u32) * m_childHashSize, alignof(u32));
+	memset(m_childHash, 0, sizeof(u32) * m_childHashSize);
+	for (u32 i = 0; i < m_childCount; i++)
+		InsertChildHash(i);
+}
 
-	if (pIn >= pEnd)
-	{
-		m_fileParsed = (int)(pIn - &m_fileMem[0]);
-		return false;
-	}
-	
-	// comment? just skip the line. report that there was no name found...
-	if (*pIn == '#' || *pIn == ';')
+const SHAD_Node *SHAD_Node::GetChild(string_view name) const
+{
+	if (m_childHash)
 	{
-		while (pIn < pEnd && (*pIn != 13 && *pIn != 10))
-			pIn++;
-		while (pIn < pEnd && (*pIn == 13 || *pIn == 10))
+		u32 mask = m_childHashSize - 1;
+		for (u32 slot = SHAD_HashName(name) & mask; m_childHash[slot] != 0; slot = (slot + 1) & mask)
 		{
-			if (*pIn == 13)
-				m_currentLine++;
-
-			pIn++;
+			const SHAD_Node *child = &m_children[m_childHash[slot] - 1];
+			if (child->m_name == name)
+				return child;
 		}
-
-		m_fileParsed = (int)(pIn - &m_fileMem[0]);
-		return false;
+		return 0;
 	}
 
-	// end of bracket section?
-	if (*pIn == '}')
+	for (u32 i=0; i<m_childCount; i++)
+		if (m_children[i].m_name == name)
+			return &m_children[i];
+	return 0;
+}
+
+SHAD_Node *SHAD_Node::AddChild(string_view name)
+{
+	if (m_childCount == m_childCapacity)
 	{
-		m_bracketIndent--;
-		pIn++;
-		m_fileParsed = (int)(pIn - &m_fileMem[0]);
-		return false;
+		// move the children to a bigger array - their own children need to know where they went
+		u32 capacity = Max(m_childCapacity * 2, 4u);
+		SHAD_Node *children = m_doc->AllocNodes(capacity);
+		if (m_childCount > 0)
+			memcpy((void *)children, m_children, sizeof(SHAD_Node) * m_childCount);
+		m_children = children;
+		m_childCapacity = capacity;
+		for (u32 i = 0; i < m_childCount; i++)
+			for (u32 c = 0; c < m_children[i].m_childCount; c++)
+				m_children[i].m_children[c].m_parent = &m_children[i];
+		m_childHash = nullptr;
 	}
 
-	int length;
-	bool hitColon;
-	bool success = TokenizeString(pIn, m_tokenizeBuffer, pEnd, ':', length, hitColon);
-	m_fileParsed = (int)(pIn - &m_fileMem[0]);
-	if (success)
+	SHAD_Node *child = &m_children[m_childCount++];
+	m_doc->InitNode(child, this);
+	child->m_name = m_doc->AllocString(name);
+	if (m_childHash)
+		InsertChildHash(m_childCount - 1);
+	else if (m_childCount >= SHAD_CHILD_HASH_MIN)
+		BuildChildHash();
+	return child;
+}
+
+SHAD_Node *SHAD_Node::AddString(string_view val)
+{
+	if (m_valueCount == m_valueCapacity)
 	{
-		name = (const char *)DupMem((u8*)m_tokenizeBuffer, length+1);
-		return true;
+		u32 capacity = Max(m_valueCapacity * 2, 4u);
+		string_view *values = (string_view *)m_doc->Alloc(sizeof(string_view) * capacity, alignof(string_view));
+		if (m_valueCount > 0)
+			std::copy(m_values, m_values + m_valueCount, values);
+		m_values = values;
+		m_valueCapacity = capacity;
 	}
-	return false;
+	m_values[m_valueCount++] = m_doc->AllocString(val);
+	return this;
 }
 
-bool SHADReader::ParseValue(const char * &value)
+bool SHAD_ValueToBool(string_view value)
 {
-	const char *pIn = &m_fileMem[m_fileParsed];
-	const char *pEnd = &m_fileMem[m_fileSize];
-
-	int length;
-	bool hitComma;
-	bool success = TokenizeString(pIn, m_tokenizeBuffer, pEnd, ',', length, hitComma);
+	auto lower = [](char ch) { return (ch >= 'A' && ch <= 'Z') ? (char)(ch + 32) : ch; };
+	return value == "1" || (value.size() == 4 && std::equal(value.begin(), value.end(), "true", [&](char a, char b) { return lower(a) == b; }));
+}
 
-	// if line ends in ',' we assume next line continues the values...
-	// so just skip all white space and EOL now...
-	if (hitComma)
-	{
-		while (pIn < pEnd && (*pIn == 13 || *pIn == 10))
-			pIn++;
-	}
+f32 SHAD_ValueToF32(string_view value)
+{
+	if (!value.empty() && value[0] == '+')
+		value.remove_prefix(1);
+	f32 result = 0.0f;
+	std::from_chars(value.data(), value.data() + value.size(), result);
+	return result;
+}
 
-	m_fileParsed = (int)(pIn - &m_fileMem[0]);
+i32 SHAD_ValueToI32(string_view value)
+{
+	if (!value.empty() && value[0] == '+')
+		value.remove_prefix(1);
+	i32 result = 0;
+	std::from_chars(value.data(), value.data() + value.size(), result);
+	return result;
+}
 
-	if (success)
+u64 SHAD_ValueToHex64(string_view value)
+{
+	u64 result = 0;
+	for (char ch : value)
 	{
-		value = (const char *)DupMem((u8*)m_tokenizeBuffer, length+1);
-		return true;
+		result = result << 4;
+		if (ch >= 'a' && ch <= 'f')
+			result += (u64)(ch - 'a' + 10);
+		else if (ch >= 'A' && ch <= 'F')
+			result += (u64)(ch - 'A' + 10);
+		else if (ch >= '0' && ch <= '9')
+			result += (u64)(ch - '0');
 	}
-	return false;
+	return result;
 }
 
-bool SHADReader::TokenizeString(const char * &pIn, char *pOut, const char *pEnd, char endDelimiter, int &length, bool &hitToken)
+void SHAD_Node::Write(FileHandle fh, int indent) const
 {
-	bool validString = false;
-	const char *pResult = pOut;
-	const char *pLastAdded = pOut;
-	hitToken = false;
+	FileManager &fm = FileManager::Instance();
+	for (int i=0; i<indent; i++)
+		fm.StreamWrite(fh, "\t");
 
-	bool inQuotes=false;
-	while (pIn < pEnd && (*pIn != 13 && *pIn != 10) && (inQuotes || (*pIn != endDelimiter && *pIn != '#' && *pIn != '{')))
+	auto quoted = [](string_view str) { return str.find_first_of(":#,") != string_view::npos; };
+	if (quoted(m_name))
+		fm.StreamWrite(fh, STR("\"{}\"", m_name));
+	else
+		fm.StreamWrite(fh, string(m_name));
+
+	if (m_valueCount > 0)
 	{
-		if (*pIn == '"')
-		{
-			inQuotes = !inQuotes;
-			pIn++;
-			validString = true;
-		}
-		else if (!inQuotes && *pIn == '&')
+		fm.StreamWrite(fh, ": ");
+		for (u32 i=0; i<m_valueCount; i++)
 		{
-			if (strncmp(pIn, "&quot;", 6) == 0)
-			{
-				*pOut++ = '"';
-				pIn += 6;
-			}
-			else if (strncmp(pIn, "&cr;", 4) == 0)
-			{
-				*pOut++ = '\n';
-				pIn += 4;
-			}
-			else if (strncmp(pIn, "&amp;", 4) == 0)
-			{
-				*pOut++ = '&';
-				pIn += 4;
-			}
+			const char *separator = (i < m_valueCount - 1) ? "," : "";
+			if (quoted(m_values[i]))
+				fm.StreamWrite(fh, STR("\"{}\"{}", m_values[i], separator));
 			else
-			{
-				*pOut++ = *pIn++;
-			}
-		}
-		else
-		{
-			*pOut++ = *pIn++;
-			if (inQuotes)
-				pLastAdded = pOut;
+				fm.StreamWrite(fh, STR("{}{}", m_values[i], separator));
 		}
 	}
+	fm.StreamWrite(fh, "\r\n");
 
-	// strip off dead space...
-	char *pStringEnd = pOut;
-	while (pStringEnd > pLastAdded && (pStringEnd[-1] == ' ' || pStringEnd[-1] == '\t' || pStringEnd[-1] == 13 || pStringEnd[-1] == 10))
-		pStringEnd--;
-	length = (int)(pStringEnd - pResult);
-	*pStringEnd++ = 0;
-
-	// skip delimiter
-	if (pIn < pEnd && *pIn == endDelimiter)
+	for (u32 i=0; i<m_childCount; i++)
 	{
-		validString = true;
-		hitToken = true;
-		pIn++;
+		m_children[i].Write(fh, indent+1);
 	}
 
-	// skip dead space
-	while (pIn<pEnd && (*pIn == ' ' || *pIn == '\t'))
-		pIn++;
-
-	return (pResult[0] != 0) || validString;
+	if (m_isHeading)
+		fm.StreamWrite(fh, "\r\n");
 }
 
-void SHADReader_Node::Dump()
+void SHAD_Node::Dump() const
 {
-	char spaces[256];
-	memset(spaces,' ',255);
 	string line;
-	if (indent > 0)
-		line = string(spaces, &spaces[indent * 2]);
-	if (name)
-		line+=name;
-	line+=": ";
-	for (u32 i=0; i<valueCount; i++)
+	if (m_indent > 0)
+		line = string(m_indent * 2, ' ');
+	line += m_name;
+	line += ": ";
+	for (u32 i=0; i<m_valueCount; i++)
 	{
-		if (*(values[i]) == 0 || strchr(values[i],',') || strchr(values[i],'{') || strchr(values[i],';') || strchr(values[i],'#'))
-			line+=STR("\"%s\"",values[i]);
+		if (m_values[i].empty() || m_values[i].find_first_of(",{;#") != string_view::npos)
+			line += STR("\"{}\"", m_values[i]);
 		else
-			line+=values[i];
-		if (i<valueCount-1)
-			line+=", ";
+			line += m_values[i];
+		if (i<m_valueCount-1)
+			line += ", ";
 	}
-	if (childCount > 0)
+	if (m_childCount > 0)
 	{
-		line+=" {";
+		line += " {";
 		LOG(SHAD, line);
-		for (u32 i=0; i<childCount; i++)
-			children[i]->Dump();
+		for (u32 i=0; i<m_childCount; i++)
+			m_children[i].Dump();
 		string closeLine;
-		if (indent > 0)
-			closeLine = string(spaces, &spaces[indent * 2]);
+		if (m_indent > 0)
+			closeLine = string(m_indent * 2, ' ');
 		closeLine += "}";
 		LOG(SHAD, closeLine);
 	}
@@ -1,181 +1,180 @@
 #pragma once
 
+/**************************************************************************
+SHAD  -  indented text documents (materials, render passes, render scenes...)
+
+    name: value, value, value
+        child: value
+    other { child: value }
+
+the whole document lives in one arena owned by the SHAD and is freed in one go.
+names and values are string_views straight into the source text - only tokens
+with quotes or escapes get copied into the arena - so when parsing from memory,
+that memory must outlive the SHAD.
+the children of a node are stored contiguously, and wide nodes get a hash table
+so GetChild by name doesn't compare against every child.
+
+***************************************************************************/
+
 #include "Neo.h"
 #include "FileSystem.h"
 #include "StringUtils.h"
 #include "MathUtils.h"
+#include "MemBlock.h"
 
-class SHAD_Node
-{
-public:
-	SHAD_Node() : parent(0), indent(0), isHeading(false) {}
-	void DeleteChildren();
-
-	int GetIndent() const { return indent; }
-	void SetIndent(int _indent) { indent = _indent; }
+class SHAD;
+class SHAD_NodeChildren;
 
-	const string &GetName() const { return name; }
-	void SetName(const string &_name) { name = _name; }
-	bool IsName(const string &val) const { return name == val; }
-
-	const SHAD_Node *GetParent() const { return parent; }
-	SHAD_Node *GetParent() { return parent; }
-	void SetParent(SHAD_Node *_parent) { _parent->AddChild(this); }
-
-	const SHAD_Node *GetChild(const string &_name) const
-	{
-		for (u32 i=0; i<children.size(); i++)
-			if (children[i]->name == _name)
-				return children[i];
-		return 0;
-	}
-	SHAD_Node *GetChild(const string &_name)
-	{
-		for (u32 i=0; i<children.size(); i++)
-			if (children[i]->name == _name)
-				return children[i];
-		return 0;
-	}
+// nodes with at least this many children get a hash table for GetChild by name
+#define SHAD_CHILD_HASH_MIN 8
 
-	SHAD_Node * AddChild(SHAD_Node *pChild)
-	{
-		pChild->parent = this;
-		children.push_back(pChild);
-		return pChild;
-	}
-	SHAD_Node * AddChild(const string &_name)
-	{
-		SHAD_Node *pChild = new SHAD_Node;
-		pChild->name = _name;
-		pChild->parent = this;
-		children.push_back(pChild);
-		return pChild;
-	}
+inline u32 SHAD_HashName(string_view name)
+{
+	u32 hash = 2166136261u;
+	for (char ch : name)
+		hash = (hash ^ (u8)ch) * 16777619u;
+	return hash;
+}
+
+bool SHAD_ValueToBool(string_view value);
+f32 SHAD_ValueToF32(string_view value);
+i32 SHAD_ValueToI32(string_view value);
+u64 SHAD_ValueToHex64(string_view value);
+
+// value and child getters shared by text and binary documents
+// Node provides GetValueCount(), Value(index) and GetChild(name), which returns something that tests false if there's no child
+template <class Node>
+class SHAD_Accessors
+{
+	const Node &Self() const { return *static_cast<const Node*>(this); }
 
-	bool HasValue(const string &a_value) const
+public:
+	bool HasValue(string_view value) const
 	{
-		for (u32 i=0; i<values.size(); i++)
-			if (values[i] == a_value)
+		for (int i=0; i<Self().GetValueCount(); i++)
+			if (Self().Value(i) == value)
 				return true;
 		return false;
 	}
 
 	// some get functions that return a specific child, or a default value if the child does not exist
-	string GetChildString(const string &_name, const string &def = string()) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetString() : def; }
-	float GetChildFloat(const string &_name, float def = 0.0f) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetFloat() : def; }
-	int GetChildInt(const string &_name, int def = 0) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetInt() : def; }
-	bool GetChildBool(const string &_name, bool def = false) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetBool() : def; }
-	vec2 GetChildVector2(const string &_name, const vec2 &def = vec2(0,0)) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetVector2() : def; }
-	vec3 GetChildVector3(const string &_name, const vec3 &def = vec3(0, 0, 0)) const { const SHAD_Node *c = GetChild(_name); return c ? c->GetVector3() : def; }
-
-	SHAD_Node * AddString(const string &val) { values.push_back(val); return this; }
-	SHAD_Node * AddFloat(float val)  { values.push_back(STR("%f",val)); return this;  }
-	SHAD_Node * AddInt(int val) { values.push_back(STR("%d",val)); return this;}
-	SHAD_Node * AddHex64(u64 val) { values.push_back(STR("%llx", val)); return this; }
-	SHAD_Node * AddVector2i(const ivec2 &val) { AddInt(val.x); AddInt(val.y); return this; }
-	SHAD_Node * AddVector3i(const ivec3 &val) { AddInt(val.x); AddInt(val.y); AddInt(val.z); return this; }
-	SHAD_Node * AddBool(bool val) { values.push_back(val?"true":"false"); return this;}
-	SHAD_Node * AddVector2(const vec2 &val) { AddFloat(val.x); AddFloat(val.y); return this;}
-	SHAD_Node * AddVector3(const vec3 &val) { AddFloat(val.x); AddFloat(val.y); AddFloat(val.z);return this; }
-	SHAD_Node * AddVector4(const vec4 &val) { AddFloat(val.x); AddFloat(val.y); AddFloat(val.z); AddFloat(val.w); return this; }
-	SHAD_Node * AddColor(const color &val) { AddFloat(val.r); AddFloat(val.g); AddFloat(val.b); AddFloat(val.a);return this; }
-	SHAD_Node * AddFloats(const vector<float> &val)  { for (u32 i=0; i<val.size(); i++) values.push_back(STR("%f",val[i]));  return this;}
-	SHAD_Node * AddStrings(const vector<string> &val)  { for (u32 i=0; i<val.size(); i++) values.push_back(val[i]); return this; }
-
-	int GetValueCount() const { return (int)values.size(); }
-	string GetString(u32 index = 0) const
-	{
-		return values.size() > index ? values[index] : string();
-	}
-	bool GetBool(int index = 0) const { return StringToBool(GetString(index)); }
-	float GetFloat(int index = 0) const { return StringToF32(GetString(index)); }
-	int GetInt(int index = 0) const { return StringToI32(GetString(index)); }
-	vec2 GetVector2(int index = 0) const { return vec2(StringToF32(GetString(index)), StringToF32(GetString(index+1))); }
-	vec3 GetVector3(int index = 0) const { return vec3(StringToF32(GetString(index)), StringToF32(GetString(index+1)), StringToF32(GetString(index+2))); }
-	color GetColor(int index = 0) const { return color(StringToF32(GetString(index)), StringToF32(GetString(index+1)), StringToF32(GetString(index+2)), StringToF32(GetString(index+3))); }
-	color GetColor256(int index = 0) const { return color(StringToF32(GetString(index))/255.0f, StringToF32(GetString(index+1)) /255.0f, StringToF32(GetString(index+2)) /255.0f, StringToF32(GetString(index+3)) /255.0f); }
-
-	int GetChildCount() const { return (int)children.size(); }
-	const SHAD_Node *GetChild(u32 index) const { return (index < children.size()) ? children[index] : 0; }
-	SHAD_Node *GetChild(u32 index) { return (index < children.size()) ? children[index] : 0; }
-
-	void Write(FileHandle fh, int indent) const;
-
-	SHAD_Node *SetAsHeading() { isHeading = true; return this; }
-
-protected:
-	vector<SHAD_Node*> children;
-	vector<string> values;
-	SHAD_Node *parent;
-	string name;
-	int indent;
-	bool isHeading;
-};
-
-
-struct FastTokenizer_LineData
-{
-	int indent = 0;
-
-	// NOTE: was getting 20+ second load times when connected to the debugger when using STL vector for the tokens,  so implementing my own version
-	void AddToken(const char *pToken) 
+	string GetChildString(string_view name, const string &def = string()) const { auto c = Self().GetChild(name); return c ? c->GetString() : def; }
+	float GetChildFloat(string_view name, float def = 0.0f) const { auto c = Self().GetChild(name); return c ? c->GetF32() : def; }
+	int GetChildInt(string_view name, int def = 0) const { auto c = Self().GetChild(name); return c ? c->GetI32() : def; }
+	int GetChildHex(string_view name, int def = 0) const { auto c = Self().GetChild(name); return c ? c->GetHex() : def; }
+	bool GetChildBool(string_view name, bool def = false) const { auto c = Self().GetChild(name); return c ? c->GetBool() : def; }
+	vec2 GetChildVector2(string_view name, const vec2 &def = vec2(0,0)) const { auto c = Self().GetChild(name); return c ? c->GetVector2() : def; }
+	vec3 GetChildVector3(string_view name, const vec3 &def = vec3(0, 0, 0)) const { auto c = Self().GetChild(name); return c ? c->GetVector3() : def; }
+
+	string GetString(u32 index = 0) const { return string(Self().Value(index)); }
+	u64 GetUID64(const string baseName, u32 index=0) const
 	{
-		tokens.push_back(pToken);
+		string_view str = Self().Value(index);
+		if (!str.empty() && str[0] == '@')
+			return StringHash64(baseName) + StringHash64(string(str));
+		else if (!str.empty() && str[0] == '%')
+			return GenerateRandomU64();
+		else
+			return GetHex64(index);
 	}
-	const char *Token(int index) { return tokens[index]; }
-	int GetCount() { return (int)tokens.size(); }
-
-protected:
-	vector<const char*> tokens;
-	friend struct FastTokenizer;
-};
 
-struct FastTokenizer
-{
-	char *pStringData;
-	vector<FastTokenizer_LineData> lines;
-
-	FastTokenizer(const char *pData, u32 size);
-	~FastTokenizer();
-	const char *TokenizeString(const char * &pIn, char * &pOut, const char *pOutEnd, const char *pEnd, char endDelimiter);
+	bool GetBool(int index = 0) const { return SHAD_ValueToBool(Self().Value(index)); }
+	f32 GetF32(int index = 0) const { return SHAD_ValueToF32(Self().Value(index)); }
+	i32 GetI32(int index = 0) const { return SHAD_ValueToI32(Self().Value(index)); }
+	u64 GetHex64(int index = 0) const { return SHAD_ValueToHex64(Self().Value(index)); }
+	int GetHex(int index = 0) const { return (int)GetHex64(index); }
+	vec2 GetVector2(int index = 0) const { return vec2(GetF32(index), GetF32(index+1)); }
+	vec3 GetVector3(int index = 0) const { return vec3(GetF32(index), GetF32(index+1), GetF32(index+2)); }
+	vec4 GetVector4(int index = 0) const { return vec4(GetF32(index), GetF32(index+1), GetF32(index+2), GetF32(index+3)); }
+	vec3 GetDegVector3(int index = 0) const { return vec3(DegToRad(GetF32(index)), DegToRad(GetF32(index+1)), DegToRad(GetF32(index+2))); }
+	ivec2 GetVector2i(int index = 0) const { return ivec2(GetI32(index), GetI32(index+1)); }
+	ivec3 GetVector3i(int index = 0) const { return ivec3(GetI32(index), GetI32(index + 1), GetI32(index + 2)); }
+	ivec4 GetVector4i(int index = 0) const { return ivec4(GetI32(index), GetI32(index + 1), GetI32(index + 2), GetI32(index + 3)); }
+	color GetColour(int index = 0) const { return color(GetF32(index), GetF32(index+1), GetF32(index+2), GetF32(index+3)); }
+	color GetColour256(int index = 0) const { return color(GetF32(index)/255.0f, GetF32(index+1)/255.0f, GetF32(index+2)/255.0f, GetF32(index+3)/255.0f); }
+	int GetEnum(const stringlist &fields, int index = 0) const { return StringFindInList(GetString(index), fields); }
 };
 
-class SHAD
+class SHAD_Node : public SHAD_Accessors<SHAD_Node>
 {
 public:
-	SHAD(int tabsize=2);
-	SHAD(const string &path, int tabsize);
-	SHAD(const char *pMem, int memSize, int tabsize);
-	~SHAD();
-
-	SHAD_Node *root;
-	int tabsize;
+	string_view Name() const { return m_name; }
+	string GetName() const { return string(m_name); }
+	string GetPath() const { return (m_parent != 0) ? m_parent->GetPath() + "/" + GetName() : GetName(); }
+	int GetIndent() const { return m_indent; }
+
+	bool IsName(string_view val) const { return val == m_name; }
+	const SHAD_Node *GetParent() const { return m_parent; }
+	SHAD_Node *GetParent() { return m_parent; }
+
+	const SHAD_Node *GetChild(string_view name) const;
+	SHAD_Node *GetChild(string_view name) { return const_cast<SHAD_Node*>(((const SHAD_Node*)this)->GetChild(name)); }
+
+	int GetValueCount() const { return m_valueCount; }
+	string_view Value(u32 index = 0) const { return index < m_valueCount ? m_values[index] : string_view(); }
+
+	SHAD_NodeChildren GetChildren();
+	int GetChildCount() const { return m_childCount; }
+	const SHAD_Node *GetChild(u32 index) const { return (index < m_childCount) ? &m_children[index] : 0; }
+	SHAD_Node *GetChild(u32 index) { return (index < m_childCount) ? &m_children[index] : 0; }
+
+	// building a document to write out
+	// children are stored contiguously, so adding a child can move its siblings - don't hold on to a sibling across an AddChild
+	SHAD_Node *AddChild(string_view name);
+	SHAD_Node *AddString(string_view val);
+	SHAD_Node *AddFloat(float val) { return AddString(STR("{}", val)); }
+	SHAD_Node *AddInt(int val) { return AddString(STR("{}", val)); }
+	SHAD_Node *AddHex64(u64 val) { return AddString(STR("{:x}", val)); }
+	SHAD_Node *AddVector2i(const ivec2 &val) { AddInt(val.x); AddInt(val.y); return this; }
+	SHAD_Node *AddVector3i(const ivec3 &val) { AddInt(val.x); AddInt(val.y); AddInt(val.z); return this; }
+	SHAD_Node *AddBool(bool val) { return AddString(val ? "true" : "false"); }
+	SHAD_Node *AddVector2(const vec2 &val) { AddFloat(val.x); AddFloat(val.y); return this; }
+	SHAD_Node *AddVector3(const vec3 &val) { AddFloat(val.x); AddFloat(val.y); AddFloat(val.z); return this; }
+	SHAD_Node *AddVector4(const vec4 &val) { AddFloat(val.x); AddFloat(val.y); AddFloat(val.z); AddFloat(val.w); return this; }
+	SHAD_Node *AddColor(const color &val) { AddFloat(val.r); AddFloat(val.g); AddFloat(val.b); AddFloat(val.a); return this; }
+	SHAD_Node *AddFloats(const vector<float> &val) { for (auto v : val) AddFloat(v); return this; }
+	SHAD_Node *AddStrings(const vector<string> &val) { for (auto& v : val) AddString(v); return this; }
+	SHAD_Node *SetAsHeading() { m_isHeading = true; return this; }
 
-	bool Write(const string &path, const string &titleComment);
+	void Write(FileHandle fh, int indent) const;
+	void Dump() const;
 
 protected:
-	void LoadResource(const string &path, int _tabsize);
-	void Parse( const char *data, int size, int _tabsize );
-	void CreateNodeFromTokenizer( SHAD_Node &parentNode, FastTokenizer &ft, int &lineIdx);
+	friend class SHAD;
+
+	void BuildChildHash();
+	void InsertChildHash(u32 index);
+
+	SHAD *m_doc;
+	SHAD_Node *m_parent;
+	string_view m_name;
+	string_view *m_values;
+	SHAD_Node *m_children;
+	u32 *m_childHash;			// child index + 1 for each slot, 0 if empty - only for wide nodes
+	u32 m_valueCount;
+	u32 m_valueCapacity;
+	u32 m_childCount;
+	u32 m_childCapacity;
+	u32 m_childHashSize;
+	int m_indent;
+	bool m_isHeading;
 };
 
-//====================================================================================================
-
-class SHADReader_NodeChildren 
+class SHAD_NodeChildren
 {
 public:
-	SHADReader_NodeChildren(class SHADReader_Node** nodes, int size) : m_nodes(nodes), m_size(size) {}
+	SHAD_NodeChildren(SHAD_Node* nodes, int size) : m_nodes(nodes), m_size(size) {}
 
 	int size() { return m_size; }
-	SHADReader_Node* operator[](int index) { Assert(index >= 0 && index < m_size, "Bad Index!"); return m_nodes[index]; }
+	SHAD_Node* operator[](int index) { Assert(index >= 0 && index < m_size, "Bad Index!"); return m_nodes + index; }
 
 	// Iterator class for ranged for-loop
 	class Iterator {
 	public:
-		Iterator(SHADReader_Node** ptr) : current(ptr) {}
+		Iterator(SHAD_Node* ptr) : current(ptr) {}
 
-		SHADReader_Node* operator*() const {
-			return *current;
+		SHAD_Node* operator*() const {
+			return current;
 		}
 
 		Iterator& operator++() {
@@ -188,7 +187,7 @@ public:
 		}
 
 	private:
-		SHADReader_Node** current;
+		SHAD_Node* current;
 	};
 
 	Iterator begin() const {
@@ -200,146 +199,73 @@ public:
 	}
 
 private:
-	SHADReader_Node** m_nodes;
+	SHAD_Node* m_nodes;
 	int m_size;
 };
 
+inline SHAD_NodeChildren SHAD_Node::GetChildren() { return SHAD_NodeChildren(m_children, m_childCount); }
 
-class SHADReader_Node
-{
-protected:
-	SHADReader_Node *parent;
-	SHADReader_Node *next;      // initially build as a linked list, then pack into the children array for indexed lookup...
-
-	const char *name;
-	const char **values;
-	u32 valueCount;
-	SHADReader_Node **children;
-	u32 childCount;
-	friend class SHADReader;
-	int indent;
 
+class SHAD
+{
 public:
-	const char *Name() const { return name; }
-	string GetName() const { return string(name); }
-	string GetPath() const { return (parent != 0) ? parent->GetPath() + "/" + name : name; }
-
-	bool IsName(const string &val) const { return val == name; }
-	const SHADReader_Node *GetParent() const { return parent; }
-	SHADReader_Node *GetParent() { return parent; }
-
-	const SHADReader_Node *GetChild(const string &_name) const
-	{
-		for (u32 i=0; i<childCount; i++)
-			if (_name == children[i]->name)
-				return children[i];
-		return 0;
-	}
-
-	bool HasValue(const string &a_value) const
-	{
-		for (u32 i=0; i<valueCount; i++)
-			if (a_value == values[i])
-				return true;
-		return false;
-	}
+	SHAD();
+	SHAD(const string &path);
+	SHAD(const string &name, const char *pMem, int memSize);
+	~SHAD();
 
-	// some get functions that return a specific child, or a default value if the child does not exist
-	string GetChildString(const string &_name, const string &def = string()) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetString() : def; }
-	float GetChildFloat(const string &_name, float def = 0.0f) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetF32() : def; }
-	int GetChildInt(const string &_name, int def = 0) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetI32() : def; }
-	int GetChildHex(const string &_name, int def = 0) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetHex() : def; }
-	bool GetChildBool(const string &_name, bool def = false) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetBool() : def; }
-	vec2 GetChildVector2(const string &_name, const vec2 &def = vec2(0,0)) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetVector2() : def; }
-	vec3 GetChildVector3(const string &_name, const vec3 &def = vec3(0, 0, 0)) const { const SHADReader_Node *c = GetChild(_name); return c ? c->GetVector3() : def; }
-
-	int GetValueCount() const { return valueCount; }
-	string GetString(u32 index = 0) const
-	{
-		return index < valueCount ? string(values[index]) : string();
-	}
-	const char *Value(u32 index=0) const
-	{
-		return index < valueCount ? values[index] : "";
-	}
-	u64 GetUID64(const string baseName, u32 index=0) const
-	{
-		string str = GetString(index);
-		if (str[0] == '@')
-			return StringHash64(baseName) + StringHash64(str);
-		else if (str[0] == '%')
-			return GenerateRandomU64();
-		else
-			return GetHex64(index);
-	}
+	SHAD_Node *root;
 
-	bool GetBool(int index = 0) const { return StringToBool(GetString(index)); }
-	f32 GetF32(int index = 0) const { return StringToF32(Value(index)); }
-	i32 GetI32(int index = 0) const { return StringToI32(Value(index)); }
-	u64 GetHex64(int index = 0) const { return StringToHex64(Value(index)); }
-	int GetHex(int index = 0) const { return StringToHex(Value(index)); }
-	vec2 GetVector2(int index = 0) const { return vec2(GetF32(index), GetF32(index+1)); }
-	vec3 GetVector3(int index = 0) const { return vec3(GetF32(index), GetF32(index+1), GetF32(index+2)); }
-	vec4 GetVector4(int index = 0) const { return vec4(GetF32(index), GetF32(index+1), GetF32(index+2), GetF32(index+3)); }
-	vec3 GetDegVector3(int index = 0) const { return vec3(DegToRad(GetF32(index)), DegToRad(GetF32(index+1)), DegToRad(GetF32(index+2))); }
-	ivec2 GetVector2i(int index = 0) const { return ivec2(GetI32(index), GetI32(index+1)); }
-	ivec3 GetVector3i(int index = 0) const { return ivec3(GetI32(index), GetI32(index + 1), GetI32(index + 2)); }
-	ivec4 GetVector4i(int index = 0) const { return ivec4(GetI32(index), GetI32(index + 1), GetI32(index + 2), GetI32(index + 3)); }
-	color GetColour(int index = 0) const { return color(GetF32(index), GetF32(index+1), GetF32(index+2), GetF32(index+3)); }
-	color GetColour256(int index = 0) const { return color(GetF32(index)/255.0f, GetF32(index+1)/255.0f, GetF32(index+2)/255.0f, GetF32(index+3)/255.0f); }
-	int GetEnum(const stringlist fields, int index = 0) { return StringFindInList(GetString(index), fields); }
+	bool Write(const string &path, const string &titleComment);
 
-	SHADReader_NodeChildren GetChildren() { return SHADReader_NodeChildren(children, childCount); }
-	int GetChildCount() const { return childCount; }
-	const SHADReader_Node *GetChild(u32 index) const { return (index < childCount) ? children[index] : 0; }
-	SHADReader_Node *GetChild(u32 index) { return (index < childCount) ? children[index] : 0; }
+	// compiled form for SHADBinary - strings and nodes in tables, loaded without any parsing
+	MemBlock ToBinary() const;
+	bool WriteBinary(const string &path) const;
 
-	void Dump();
-};
+	// memory from the document's arena - freed with the document
+	u8 *Alloc(size_t size, size_t align = alignof(void*));
+	string_view AllocString(string_view str);
+	SHAD_Node *AllocNodes(u32 count);
 
-class SHADReader
-{
-public:
-	SHADReader(const string &path);
-	SHADReader(const string &name, const char *pMem, int memSize);
-	~SHADReader();
+protected:
+	friend class SHAD_Node;
 
-	SHADReader_Node *root;
-	u8 *FastAlloc(int size);
+	void Parse(const char *data, int size);
 
-protected:
-	void Parse( const char *data, int size);
+	struct ParsedLine
+	{
+		int indent;
+		int line;
+		string_view name;
+		u32 firstValue;
+		u32 valueCount;
+	};
+	bool ReadLine(ParsedLine &line);
+	bool ParseName(string_view &name, int &indent);
+	bool ParseValue(string_view &value);
+	bool TokenizeString(const char * &pIn, char endDelimiter, string_view &token, bool &hitToken);
+	void BuildChildren(SHAD_Node *parent, size_t &lineIdx);
+	void InitNode(SHAD_Node *node, SHAD_Node *parent);
 
 	string m_filename;
-	const char *m_fileMem;
-	int m_fileSize;
-	int m_fileParsed;
-
-	bool m_ownMemory = true;
-	u8 *m_heapMem;
-	int m_heapSize;
-	int m_heapUsage;
-	int m_tabSize;
-
-	SHADReader_Node *AllocNode();
-	u8 *DupMem(u8 *source, int size);
-
-	// parse a node and its children
-	// returns the next sibling, or NULL at end of file
-	SHADReader_Node *ParseNode(SHADReader_Node *parent, SHADReader_Node *firstChild);
-
-	SHADReader_Node *ReadNode();
-	bool ParseName(const char * &name, int &indent);
-	bool ParseValue(const char * &value);
-	bool TokenizeString(const char * &pIn, char *pOut, const char *pEnd, char endDelimiter, int &length, bool &hitToken);
-
-	int m_nodeCount;
-	int m_valueCount;
-	int m_errorsLogged;
-	int m_currentLine;
-	int m_bracketIndent;
-
-    // temporary tokenize buffer
-    char* m_tokenizeBuffer;
+	MemBlock m_fileMem;
+
+	// arena blocks - all freed together when the document goes
+	vector<u8*> m_arenaBlocks;
+	u8 *m_arenaPos = nullptr;
+	size_t m_arenaRemaining = 0;
+
+	// parse state
+	const char *m_parseMem = nullptr;
+	int m_parseSize = 0;
+	int m_parsed = 0;
+	int m_tabSize = -1;
+	int m_errorsLogged = 0;
+	int m_currentLine = 1;
+	int m_bracketIndent = 0;
+	bool m_parseAborted = false;
+	vector<ParsedLine> m_lines;
+	vector<string_view> m_values;
+	string_view *m_valueTable = nullptr;
+	string m_scratch;
 };
-
@@ -0,0 +1,234 @@
+#include "Neo.h"
+#include "SHADBinary.h"
+#include "FileManager.h"
+#include "AssetManager.h"
+
+#include <bit>
+
+//===========================================================================
+// writing - lives here so the text side doesn't need to know the format
+
+MemBlock SHAD::ToBinary() const
+{
+	if (!root)
+		return MemBlock();
+
+	vector<SHADBinaryNode> nodes;
+	vector<SHADBinaryString> values;
+	vector<u32> childHash;
+	string strings;
+
+	// names repeat a lot across a document, so each distinct string is stored once
+	hashtable<string_view, u32> stringOffsets;
+	auto addString = [&](string_view str)
+	{
+		auto it = stringOffsets.find(str);
+		if (it == stringOffsets.end())
+		{
+			it = stringOffsets.emplace(str, (u32)strings.size()).first;
+			strings.append(str);
+		}
+		return SHADBinaryString{ it->second, (u32)str.size() };
+	};
+
+	// breadth first, so each node's children are given consecutive indices
+	vector<const SHAD_Node *> order = { root };
+	vector<u32> parents = { ~0u };
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		const SHAD_Node *node = order[i];
+
+		SHADBinaryNode record = {};
+		record.name = addString(node->m_name);
+		record.parent = parents[i];
+		record.indent = node->m_indent;
+
+		record.firstValue = (u32)values.size();
+		record.valueCount = node->m_valueCount;
+		for (u32 v = 0; v < node->m_valueCount; v++)
+			values.push_back(addString(node->m_values[v]));
+
+		record.firstChild = (u32)order.size();
+		record.childCount = node->m_childCount;
+		for (u32 c = 0; c < node->m_childCount; c++)
+		{
+			order.push_back(&node->m_children[c]);
+			parents.push_back((u32)i);
+		}
+
+		if (node->m_childCount >= SHAD_CHILD_HASH_MIN)
+		{
+			record.hashSize = std::bit_ceil(node->m_childCount * 2);
+			record.firstHashSlot = (u32)childHash.size();
+			childHash.resize(childHash.size() + record.hashSize, 0);
+			u32 *slots = &childHash[record.firstHashSlot];
+			u32 mask = record.hashSize - 1;
+			for (u32 c = 0; c < node->m_childCount; c++)
+			{
+				u32 slot = SHAD_HashName(node->m_children[c].m_name) & mask;
+				while (slots[slot] != 0)
+					slot = (slot + 1) & mask;
+				slots[slot] = c + 1;
+			}
+		}
+
+		nodes.push_back(record);
+	}
+
+	AssetBlobWriter<SHADBinaryBlob> blob(SHADBINARY_VERSION, nodes.size() * sizeof(SHADBinaryNode) + values.size() * sizeof(SHADBinaryString) + childHash.size() * sizeof(u32) + strings.size() + 64);
+	auto blobNodes = blob.Add(nodes);
+	auto blobValues = blob.Add(values);
+	auto blobChildHash = blob.Add(childHash);
+	auto blobStrings = blob.Add(strings);
+
+	auto& blobRoot = blob.GetRoot();
+	blobRoot.nodes = blobNodes;
+	blobRoot.values = blobValues;
+	blobRoot.childHash = blobChildHash;
+	blobRoot.strings = blobStrings;
+	return blob.Finish();
+}
+
+bool SHAD::WriteBinary(const string &path) const
+{
+	MemBlock block = ToBinary();
+	return block.Size() > 0 && FileManager::Instance().Write(path, block);
+}
+
+//===========================================================================
+// document
+
+SHADBinary::SHADBinary(const string &path) : m_filename(path)
+{
+	if (m_file.Open(path))
+		Load(m_file.Mem(), m_file.Size());
+	else
+		LOG(SHAD, STR("{}: couldn't open binary document", path));
+}
+
+SHADBinary::SHADBinary(const string &name, const u8 *pMem, size_t memSize) : m_filename(name)
+{
+	Load(pMem, memSize);
+}
+
+SHADBinary *SHADBinary::FromSource(const string &name, const MemBlock &src)
+{
+	auto &cache = AssetManager::Instance().GetDerivedDataCache();
+	u64 key = src.Hash64(StringHash64("SHADBinary") * 0x100000001b3ull ^ SHADBINARY_VERSION);
+
+	auto doc = new SHADBinary();
+	doc->m_filename = name;
+	string path;
+	if (cache.Find(key, ".shadb", path) && doc->m_file.OpenAbsolute(path))
+	{
+		doc->Load(doc->m_file.Mem(), doc->m_file.Size());
+		if (doc->IsGood())
+			return doc;
+		doc->m_file.Close();
+	}
+
+	// first time for this text - parse it, and keep the compiled form for next time
+	SHAD text(name, (const char *)src.Mem(), (int)src.Size());
+	doc->m_compiled = text.ToBinary();
+	cache.Write(key, ".shadb", doc->m_compiled);
+	doc->Load(doc->m_compiled.Mem(), doc->m_compiled.Size());
+	return doc;
+}
+
+void SHADBinary::Load(const u8 *pMem, size_t memSize)
+{
+	// only the header and table extents are checked here - everything inside the tables is range checked as it's read
+	MemBlock block((u8 *)pMem, memSize, true);
+	AssetBlobReader reader(block);
+	auto blobRoot = reader.GetRoot<SHADBinaryBlob>(SHADBINARY_VERSION);
+	if (!blobRoot)
+	{
+		LOG(SHAD, STR("{}: not a binary document, or old version - expected {}", m_filename, SHADBINARY_VERSION));
+		return;
+	}
+
+	m_nodes = reader.Resolve(blobRoot->nodes);
+	m_values = reader.Resolve(blobRoot->values);
+	m_childHash = reader.Resolve(blobRoot->childHash);
+	m_strings = reader.Resolve(blobRoot->strings);
+	if (!reader.IsGood() || m_nodes.empty())
+	{
+		LOG(SHAD, STR("{}: damaged binary document", m_filename));
+		m_nodes = {};
+		return;
+	}
+
+	m_good = true;
+	root = SHADBinary_Node(this, 0);
+}
+
+//===========================================================================
+// nodes
+
+SHADBinary_Node::SHADBinary_Node(const SHADBinary *doc, u32 index) : m_doc(doc), m_node(doc->NodeAt(index))
+{
+}
+
+string_view SHADBinary_Node::Name() const
+{
+	return m_node ? m_doc->String(m_node->name) : string_view();
+}
+
+string SHADBinary_Node::GetPath() const
+{
+	// a damaged parent index could form a loop, so no path is longer than the node count
+	string path = GetName();
+	SHADBinary_Node parent = GetParent();
+	for (size_t depth = 0; parent && depth < m_doc->m_nodes.size(); depth++, parent = parent.GetParent())
+		path = parent.GetName() + "/" + path;
+	return path;
+}
+
+SHADBinary_Node SHADBinary_Node::GetParent() const
+{
+	return m_node ? SHADBinary_Node(m_doc, m_node->parent) : SHADBinary_Node();
+}
+
+SHADBinary_Node SHADBinary_Node::GetChild(u32 index) const
+{
+	return (m_node && index < m_node->childCount) ? SHADBinary_Node(m_doc, m_node->firstChild + index) : SHADBinary_Node();
+}
+
+SHADBinary_Node SHADBinary_Node::GetChild(string_view name) const
+{
+	if (!m_node)
+		return SHADBinary_Node();
+
+	u32 hashSize = m_node->hashSize;
+	if (hashSize != 0 && std::has_single_bit(hashSize) && (u64)m_node->firstHashSlot + hashSize <= m_doc->m_childHash.size())
+	{
+		// bounded by the table size so a damaged table can't spin forever
+		const u32 *slots = m_doc->m_childHash.data() + m_node->firstHashSlot;
+		u32 mask = hashSize - 1;
+		u32 slot = SHAD_HashName(name) & mask;
+		for (u32 probe = 0; probe < hashSize && slots[slot] != 0; probe++, slot = (slot + 1) & mask)
+		{
+			SHADBinary_Node child = GetChild(slots[slot] - 1);
+			if (child && child.Name() == name)
+				return child;
+		}
+		return SHADBinary_Node();
+	}
+
+	for (u32 i = 0; i < m_node->childCount; i++)
+	{
+		SHADBinary_Node child = GetChild(i);
+		if (child && child.Name() == name)
+			return child;
+	}
+	return SHADBinary_Node();
+}
+
+string_view SHADBinary_Node::Value(u32 index) const
+{
+	if (!m_node)
+		return string_view();
+
+	u64 valueIndex = (u64)m_node->firstValue + index;
+	return (index < m_node->valueCount && valueIndex < m_doc->m_values.size()) ? m_doc->String(m_doc->m_values[valueIndex]) : string_view();
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+/**************************************************************************
+SHADBinary  -  compiled SHAD documents, loaded without parsing
+
+SHAD::WriteBinary flattens a document into a node table and a string table.
+nodes are stored breadth first, so the children of a node are contiguous,
+and wide nodes carry the same child hash table the text document builds.
+loading maps the file and checks the header and table extents - nothing is
+tokenized or allocated, and every node is read straight out of the mapping.
+
+nodes are small handles rather than pointers, but they support -> and
+testing against null, so code reads the same as with SHAD_Node:
+    auto node = shad.root->GetChild("material");
+    if (node) value = node->GetF32();
+unlike SHAD_Node, a null node is still safe to use - it has no name, values
+or children, so a missing or damaged document just gives the defaults.
+
+the text form is still the source of truth - this is just a faster way in.
+converters load their text sources through FromSource, which keeps the
+compiled form in the derived data cache, so the same text is only ever
+tokenized once and later conversions just map the compiled document.
+
+***************************************************************************/
+
+#include "SHAD.h"
+#include "AssetBlob.h"
+#include "MappedFile.h"
+
+#define SHADBINARY_VERSION 1
+
+// offset and length in the string table - strings aren't null terminated
+struct SHADBinaryString
+{
+	u32 offset;
+	u32 length;
+};
+
+struct SHADBinaryNode
+{
+	SHADBinaryString name;
+	u32 parent;				// ~0 for the root
+	u32 firstValue;
+	u32 valueCount;
+	u32 firstChild;
+	u32 childCount;
+	u32 firstHashSlot;		// child hash slots hold child index + 1, 0 if empty
+	u32 hashSize;			// 0 if the node isn't wide enough for a hash
+	i32 indent;
+};
+
+struct SHADBinaryBlob
+{
+	AssetBlobHeader header;
+	BlobArray<SHADBinaryNode> nodes;	// node 0 is the root
+	BlobArray<SHADBinaryString> values;
+	BlobArray<u32> childHash;
+	BlobArray<char> strings;
+};
+
+class SHADBinary;
+class SHADBinary_NodeChildren;
+
+class SHADBinary_Node : public SHAD_Accessors<SHADBinary_Node>
+{
+public:
+	SHADBinary_Node() {}
+	SHADBinary_Node(const SHADBinary *doc, u32 index);
+
+	explicit operator bool() const { return m_node != nullptr; }
+	const SHADBinary_Node *operator->() const { return this; }
+
+	string_view Name() const;
+	string GetName() const { return string(Name()); }
+	string GetPath() const;
+	int GetIndent() const { return m_node ? m_node->indent : 0; }
+
+	bool IsName(string_view val) const { return val == Name(); }
+	SHADBinary_Node GetParent() const;
+
+	SHADBinary_Node GetChild(string_view name) const;
+	SHADBinary_Node GetChild(u32 index) const;
+	int GetChildCount() const { return m_node ? (int)m_node->childCount : 0; }
+	SHADBinary_NodeChildren GetChildren() const;
+
+	int GetValueCount() const { return m_node ? (int)m_node->valueCount : 0; }
+	string_view Value(u32 index = 0) const;
+
+protected:
+	const SHADBinary *m_doc = nullptr;
+	const SHADBinaryNode *m_node = nullptr;
+};
+
+class SHADBinary_NodeChildren
+{
+public:
+	SHADBinary_NodeChildren(const SHADBinary *doc, u32 first, u32 size) : m_doc(doc), m_first(first), m_size(size) {}
+
+	int size() const { return (int)m_size; }
+	SHADBinary_Node operator[](int index) const { Assert(index >= 0 && (u32)index < m_size, "Bad Index!"); return SHADBinary_Node(m_doc, m_first + index); }
+
+	// Iterator class for ranged for-loop
+	class Iterator {
+	public:
+		Iterator(const SHADBinary *doc, u32 index) : m_doc(doc), m_index(index) {}
+
+		SHADBinary_Node operator*() const { return SHADBinary_Node(m_doc, m_index); }
+		Iterator& operator++() { ++m_index; return *this; }
+		bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+	private:
+		const SHADBinary *m_doc;
+		u32 m_index;
+	};
+
+	Iterator begin() const { return Iterator(m_doc, m_first); }
+	Iterator end() const { return Iterator(m_doc, m_first + m_size); }
+
+private:
+	const SHADBinary *m_doc;
+	u32 m_first;
+	u32 m_size;
+};
+
+inline SHADBinary_NodeChildren SHADBinary_Node::GetChildren() const { return m_node ? SHADBinary_NodeChildren(m_doc, m_node->firstChild, m_node->childCount) : SHADBinary_NodeChildren(m_doc, 0, 0); }
+
+
+class SHADBinary
+{
+public:
+	// maps the file - falls back to reading it if it's in an archive
+	SHADBinary(const string &path);
+
+	// uses the block in place - it must outlive the document
+	SHADBinary(const string &name, const u8 *pMem, size_t memSize);
+
+	// a text source, compiled through the derived data cache - only parsed the first time these exact bytes are seen
+	// the source block doesn't need to outlive the document
+	static SHADBinary *FromSource(const string &name, const MemBlock &src);
+
+	// false if the file was missing, out of date or damaged - root is then a null node
+	bool IsGood() const { return m_good; }
+
+	SHADBinary_Node root;
+
+protected:
+	friend class SHADBinary_Node;
+
+	SHADBinary() {}
+	void Load(const u8 *pMem, size_t memSize);
+
+	const SHADBinaryNode *NodeAt(u32 index) const { return index < m_nodes.size() ? &m_nodes[index] : nullptr; }
+
+	// out of range strings come back empty rather than reading past the table
+	string_view String(const SHADBinaryString &str) const
+	{
+		return ((u64)str.offset + str.length <= m_strings.size()) ? string_view(m_strings.data() + str.offset, str.length) : string_view();
+	}
+
+	string m_filename;
+	MappedFile m_file;
+	MemBlock m_compiled;		// compiled here rather than mapped from the cache
+	bool m_good = false;
+
+	std::span<const SHADBinaryNode> m_nodes;
+	std::span<const SHADBinaryString> m_values;
+	std::span<const u32> m_childHash;
+	std::span<const char> m_strings;
+};
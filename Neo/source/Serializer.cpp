@@ -285,7 +285,7 @@ void Serializer_BinaryWriteGrow::WriteMemory(const u8 *pMem, u32 size)
 	{
 		u32 oldSize = (u32)m_mem.size();
 		u32 newSize = oldSize + size;
-		if (newSize < m_mem.capacity())
+		if (m_mem.capacity() < newSize)
 		{
 			m_mem.reserve(Max(oldSize * 2, newSize));
 		}
@@ -431,6 +431,103 @@ void Serializer_BinaryRead::EndBlock()
 	m_memUsage = m_chunkStack[--m_chunkStackSize];
 }
 
+//=====================================================================================================================
+// Binary stream chunks
+//=====================================================================================================================
+
+// stream file header - little endian, as are the chunk headers that follow it
+struct SerializerStreamHeader
+{
+	u32 magic;
+	u32 version;
+};
+
+struct SerializerStreamChunkHeader
+{
+	u32 compressedSize;
+	u32 rawSize;
+	u32 crc;		// crc32c of the compressed bytes as stored
+};
+
+// top bit of rawSize - set on every piece of a block that was split over several chunks, except the last
+static const u32 StreamChunkContinued = 0x80000000;
+
+static const int StreamCompressThreads = 3;
+
+// one farm shared by every stream, so opening a stream doesn't start threads of its own
+// never freed - streams can still be in use while statics are torn down
+static WorkerFarm& StreamCompressFarm()
+{
+	static WorkerFarm* farm = []()
+		{
+			auto newFarm = new WorkerFarm(ThreadGUID_StreamCompress, "StreamCompress", StreamCompressThreads, false);
+			newFarm->StartWork();
+			return newFarm;
+		}();
+	return *farm;
+}
+
+// light obfuscation, same key for every chunk so chunks don't depend on each other
+#define STREAM_SCRAMBLE_KEY 0x9595959595959595ull
+
+static void ScrambleChunk(u8* mem, u32 size)
+{
+	u32 i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		u64 value;
+		memcpy(&value, mem + i, 8);
+		value ^= STREAM_SCRAMBLE_KEY;
+		memcpy(mem + i, &value, 8);
+	}
+	for (; i < size; i++)
+		mem[i] ^= (u8)STREAM_SCRAMBLE_KEY;
+}
+
+static void AllocChunk(SerializerStreamChunk& chunk, u32 rawSize)
+{
+	chunk.raw = new u8[rawSize];
+	chunk.compressed = new u8[compressBound(rawSize)];
+}
+
+static void FreeChunk(SerializerStreamChunk& chunk)
+{
+	delete[] chunk.raw;
+	delete[] chunk.compressed;
+	chunk.raw = nullptr;
+	chunk.compressed = nullptr;
+}
+
+// runs on a worker
+static void CompressChunk(SerializerStreamChunk& chunk)
+{
+	uLongf compressedSize = compressBound(chunk.rawSize);
+	if (compress2(chunk.compressed, &compressedSize, chunk.raw, chunk.rawSize, Z_DEFAULT_COMPRESSION) != Z_OK)
+	{
+		chunk.error = SerializerError_BadData;
+		return;
+	}
+	chunk.error = SerializerError_OK;
+	chunk.compressedSize = (u32)compressedSize;
+	ScrambleChunk(chunk.compressed, chunk.compressedSize);
+	chunk.crc = MemBlock::Crc32c(chunk.compressed, chunk.compressedSize);
+}
+
+// runs on a worker
+static void DecompressChunk(SerializerStreamChunk& chunk)
+{
+	if (MemBlock::Crc32c(chunk.compressed, chunk.compressedSize) != chunk.crc)
+	{
+		chunk.error = SerializerError_BadData;
+		return;
+	}
+	ScrambleChunk(chunk.compressed, chunk.compressedSize);
+
+	uLongf rawSize = chunk.rawSize;
+	if (uncompress(chunk.raw, &rawSize, chunk.compressed, chunk.compressedSize) != Z_OK || rawSize != chunk.rawSize)
+		chunk.error = SerializerError_BadData;
+}
+
 //=====================================================================================================================
 // Binary stream compressor
 //=====================================================================================================================
@@ -439,92 +536,105 @@ Serializer_BinaryStreamWrite::Serializer_BinaryStreamWrite(const string &filenam
 {
 	m_memUsed = 0;
 	m_chunkStackSize = 0;
-	m_encryptMask = 0x95;
 
 	if (FileManager::Instance().StreamWriteBegin(m_fileHandle, filename))
 	{
-		m_rawMem = new u8[CHUNKSIZE];
-		m_compressedMem = new u8[CHUNKSIZE];
+		SerializerStreamHeader header = { SERIALIZER_STREAM_MAGIC, SERIALIZER_STREAM_VERSION };
+		FileManager::Instance().StreamWrite(m_fileHandle, (u8*)&header, sizeof(header));
+
+		for (auto& chunk : m_chunks)
+			AllocChunk(chunk, CHUNKSIZE);
+		m_rawMem = m_chunks[m_fillChunk].raw;
 	}
 	else
 	{
 		LOG(File, string("Failed to create file: ") + filename);
 		m_rawMem = 0;
-		m_compressedMem = 0;
 	}
 }
 
-#if 0
-static void DumpMem(const char *title, u8 *mem, int size)
+void Serializer_BinaryStreamWrite::WriteChunk(SerializerStreamChunk& chunk)
 {
-	DMLOG(title);
-	int i=0;
-	DMString line;
-	while (i<size)
+	if (!chunk.pending)
+		return;
+
+	chunk.done.Wait();
+	chunk.pending = false;
+
+	// once a chunk is lost the rest of the file can't be read, so stop writing it
+	if (!IsGood())
+		return;
+	if (chunk.error != SerializerError_OK)
 	{
-		line += STR("%d,",*mem++);
-		if ((i & 7) == 7)
-		{
-			DMLOG(line.CStr());
-			line="";
-		}
-		i++;
+		LOG(File, "Stream chunk failed to compress");
+		SetError(chunk.error);
+		return;
 	}
-	if (!line.IsEmpty())
-		DMLOG(line.CStr());
+
+	u32 rawSize = chunk.rawSize | (chunk.continued ? StreamChunkContinued : 0);
+	SerializerStreamChunkHeader header = { chunk.compressedSize, rawSize, chunk.crc };
+	FileManager::Instance().StreamWrite(m_fileHandle, (u8*)&header, sizeof(header));
+	FileManager::Instance().StreamWrite(m_fileHandle, chunk.compressed, chunk.compressedSize);
 }
-#endif
 
 void Serializer_BinaryStreamWrite::Flush()
 {
 	Assert(m_chunkStackSize == 0, "Attempt to flush while a block is open!");
-	if (m_memUsed > 0)
-	{
-		// compress
-		z_stream strm;
-		strm.zalloc = Z_NULL;
-		strm.zfree = Z_NULL;
-		strm.opaque = Z_NULL;
-		deflateInit(&strm, Z_DEFAULT_COMPRESSION);
-		strm.avail_in = m_memUsed;
-		strm.next_in = m_rawMem;
-		strm.avail_out = CHUNKSIZE;
-		strm.next_out = m_compressedMem;
-		deflate(&strm, Z_FINISH);
-		u32 compressedSize = CHUNKSIZE - strm.avail_out;
-		deflateEnd(&strm);
-		//DMLOG("Compress chunk %d -> %d (%d%%)",m_memUsed,compressedSize,compressedSize*100/m_memUsed);
-
-		// encrypt
-		u32 chksum = 0;
-		u8 *encrypt = m_compressedMem;
-		u8 mask = m_encryptMask;
-		for (u32 i=0; i<compressedSize; i++)
+	if (m_memUsed == 0)
+		return;
+
+	if (m_bigChunk.empty())
+	{
+		QueueFillChunk(m_memUsed, false);
+	}
+	else
+	{
+		// split the oversized block over as many chunks as it needs - the reader joins them back up
+		for (u32 offset = 0; offset < m_memUsed; offset += CHUNKSIZE)
 		{
-			u8 decryptedData = *encrypt;
-			u8 encryptedData = decryptedData ^ mask;
-			*encrypt++ = encryptedData;
-			mask = encryptedData;
-			chksum += mask;
+			u32 size = Min((u32)CHUNKSIZE, m_memUsed - offset);
+			memcpy(m_chunks[m_fillChunk].raw, m_bigChunk.data() + offset, size);
+			QueueFillChunk(size, offset + size < m_memUsed);
 		}
-		m_encryptMask = mask;
+		m_bigChunk = vector<u8>();
+	}
+	m_rawMem = m_chunks[m_fillChunk].raw;
+	m_memUsed = 0;
+}
 
-		// write header size, crc
-		u8 header[8];
-		header[0] = (u8)(compressedSize >> 24);
-		header[1] = (u8)(compressedSize >> 16);
-		header[2] = (u8)(compressedSize >> 8);
-		header[3] = (u8)(compressedSize);
-		header[4] = (u8)(chksum >> 24);
-		header[5] = (u8)(chksum >> 16);
-		header[6] = (u8)(chksum >> 8);
-		header[7] = (u8)(chksum);
-		FileManager::Instance().StreamWrite(m_fileHandle, header, 8);
+void Serializer_BinaryStreamWrite::QueueFillChunk(u32 rawSize, bool continued)
+{
+	// compress this chunk on a worker while the caller fills the next one
+	auto& chunk = m_chunks[m_fillChunk];
+	chunk.rawSize = rawSize;
+	chunk.continued = continued;
+	chunk.pending = true;
+	StreamCompressFarm().AddTask([&chunk]() { CompressChunk(chunk); chunk.done.Signal(); });
 
-		// write
-		FileManager::Instance().StreamWrite(m_fileHandle, m_compressedMem, compressedSize);
-		m_memUsed = 0;
+	// the next chunk to fill is the oldest one in flight - write it out before reusing it
+	// chunks are written in the order they were filled, however the workers finish them
+	m_fillChunk = (m_fillChunk + 1) % PipelineDepth;
+	WriteChunk(m_chunks[m_fillChunk]);
+}
+
+void Serializer_BinaryStreamWrite::Reserve(u32 size)
+{
+	u64 capacity = m_bigChunk.empty() ? CHUNKSIZE : m_bigChunk.size();
+	if (m_memUsed + (u64)size <= capacity)
+		return;
+
+	// open blocks are patched in place when they end, so carry on in a bigger buffer rather than flushing
+	size_t newSize = Max((size_t)capacity * 2, (size_t)m_memUsed + size);
+	if (m_bigChunk.empty())
+	{
+		m_bigChunk.resize(newSize);
+		memcpy(m_bigChunk.data(), m_rawMem, m_memUsed);
+	}
+	else
+	{
+		m_bigChunk.resize(newSize);
 	}
+	m_rawMem = m_bigChunk.data();
 }
 
 Serializer_BinaryStreamWrite::~Serializer_BinaryStreamWrite()
@@ -537,27 +647,33 @@ void Serializer_BinaryStreamWrite::Finalise()
 	if (m_fileHandle)
 	{
 		Flush();
+		for (int i = 1; i < PipelineDepth; i++)
+			WriteChunk(m_chunks[(m_fillChunk + i) % PipelineDepth]);
 		FileManager::Instance().StreamWriteEnd(m_fileHandle);
 		m_fileHandle = 0;
 	}
-	delete m_rawMem;
-	delete m_compressedMem;
+	m_bigChunk = vector<u8>();
+	for (auto& chunk : m_chunks)
+		FreeChunk(chunk);
+	m_rawMem = 0;
 }
 
 void Serializer_BinaryStreamWrite::WriteU8(u8 value)
 {
-	Assert(m_memUsed < CHUNKSIZE, "Out of mem buffer");
+	Reserve(1);
 	m_rawMem[m_memUsed++] = value;
 }
 
 void Serializer_BinaryStreamWrite::WriteMemory(const u8* outMem, u32 size)
 {
+	Reserve(size);
 	memcpy(m_rawMem + m_memUsed, outMem, size);
 	m_memUsed += size;
 }
 
 void Serializer_BinaryStreamWrite::StartBlock()
 {
+	Reserve(4);
 	m_chunkStack[m_chunkStackSize++] = m_memUsed;
 	m_memUsed += 4;
 }
@@ -613,21 +729,42 @@ Serializer_BinaryStreamRead::Serializer_BinaryStreamRead(const string &filename)
 {
 	m_decryptMask = 0x95;
 	m_chunkStackSize = 0;
+	m_rawMem = 0;
+	m_compressedMem = 0;
+	m_memUsed = 0;
+	m_memSize = 0;
 
 	if (OpenFile(filename))
 	{
-		m_rawMem = new u8[CHUNKSIZE];
-		m_compressedMem = new u8[CHUNKSIZE];
-		ReadAndDecompress();
+		SerializerStreamHeader header = {};
+		u32 headerSize = ReadFileBlock((u8*)&header, sizeof(header));
+		if (headerSize == sizeof(header) && header.magic == SERIALIZER_STREAM_MAGIC)
+		{
+			if (header.version != SERIALIZER_STREAM_VERSION)
+			{
+				AbortRead(SerializerError_BadVersion);
+				return;
+			}
+
+			// get the first few chunks decompressing, then wait for the first of them
+			for (auto& chunk : m_chunks)
+				AllocChunk(chunk, CHUNKSIZE);
+			m_chunked = true;
+			for (auto& chunk : m_chunks)
+				QueueChunk(chunk);
+			ReadAndDecompress();
+		}
+		else
+		{
+			// no header - the first 8 bytes were the first chunk header of an old stream
+			m_rawMem = new u8[CHUNKSIZE];
+			m_compressedMem = new u8[CHUNKSIZE];
+			ReadAndDecompressLegacy((u8*)&header, headerSize);
+		}
 	}
 	else
 	{
-		m_rawMem = 0;
-		m_compressedMem = 0;
 		m_decryptMask = 0;
-		m_memUsed = 0;
-		m_memSize = 0;
-		m_chunkStackSize = 0;
 		SetError(SerializerError_FileNotFound);
 		LOG(File, string("Unable to open stream: ") + filename);
 	}
@@ -640,9 +777,26 @@ Serializer_BinaryStreamRead::~Serializer_BinaryStreamRead()
 
 void Serializer_BinaryStreamRead::Finalise()
 {
+	// workers may still be decompressing chunks that will never be read
+	for (auto& chunk : m_chunks)
+	{
+		if (chunk.pending)
+		{
+			chunk.done.Wait();
+			chunk.pending = false;
+		}
+	}
+	// old streams read into their own buffers rather than the chunks
+	if (!m_chunked)
+		delete[] m_rawMem;
+	m_rawMem = 0;
+	delete[] m_compressedMem;
+	m_compressedMem = 0;
+
+	m_joinMem = vector<u8>();
+	for (auto& chunk : m_chunks)
+		FreeChunk(chunk);
 	CloseFile();
-	delete m_rawMem;
-	delete m_compressedMem;
 }
 
 void Serializer_BinaryStreamRead::AbortRead(SerializerError errCode)
@@ -656,19 +810,107 @@ void Serializer_BinaryStreamRead::AbortRead(SerializerError errCode)
 	m_chunkStackSize = 0;
 }
 
-void Serializer_BinaryStreamRead::ReadAndDecompress()
+void Serializer_BinaryStreamRead::QueueChunk(SerializerStreamChunk& chunk)
 {
-	u8 header[8];
-	int readAmount = ReadFileBlock(header,8);
-	
+	// file reads stay on this thread, the workers only decompress
+	SerializerStreamChunkHeader header;
+	u32 readAmount = ReadFileBlock((u8*)&header, sizeof(header));
 	if (readAmount == 0)
+	{
+		// file complete
+		chunk.error = SerializerError_OK;
+		return;
+	}
+
+	chunk.continued = (header.rawSize & StreamChunkContinued) != 0;
+	header.rawSize &= ~StreamChunkContinued;
+	if (readAmount < sizeof(header) || header.rawSize > CHUNKSIZE || header.compressedSize > compressBound(CHUNKSIZE) ||
+		ReadFileBlock(chunk.compressed, header.compressedSize) != header.compressedSize)
+	{
+		chunk.error = SerializerError_TruncatedBlock;
+		return;
+	}
+
+	chunk.compressedSize = header.compressedSize;
+	chunk.rawSize = header.rawSize;
+	chunk.crc = header.crc;
+	chunk.error = SerializerError_OK;
+	chunk.pending = true;
+	StreamCompressFarm().AddTask([&chunk]() { DecompressChunk(chunk); chunk.done.Signal(); });
+}
+
+void Serializer_BinaryStreamRead::ReadAndDecompress()
+{
+	if (!m_chunked)
+	{
+		if (!m_compressedMem)
+		{
+			AbortRead(SerializerError_OK);
+			return;
+		}
+		u8 header[8];
+		u32 headerSize = ReadFileBlock(header, 8);
+		ReadAndDecompressLegacy(header, headerSize);
+		return;
+	}
+
+	// a block split over several chunks is joined back up, so blocks are always read from one buffer
+	m_joinMem.clear();
+	bool continued = true;
+	while (continued)
+	{
+		// the chunk we've finished with takes the next read, then move on to the oldest chunk in flight
+		if (m_currentChunk >= 0 && m_chunks[m_currentChunk].error == SerializerError_OK)
+			QueueChunk(m_chunks[m_currentChunk]);
+		m_currentChunk = (m_currentChunk + 1) % PipelineDepth;
+
+		auto& chunk = m_chunks[m_currentChunk];
+		if (chunk.pending)
+		{
+			chunk.done.Wait();
+			chunk.pending = false;
+		}
+		else if (chunk.error == SerializerError_OK)
+		{
+			// file complete - but not in the middle of a split block
+			AbortRead(m_joinMem.empty() ? SerializerError_OK : SerializerError_TruncatedBlock);
+			return;
+		}
+
+		if (chunk.error != SerializerError_OK)
+		{
+			AbortRead(chunk.error);
+			return;
+		}
+
+		continued = chunk.continued;
+		if (continued || !m_joinMem.empty())
+			m_joinMem.insert(m_joinMem.end(), chunk.raw, chunk.raw + chunk.rawSize);
+		else
+		{
+			m_rawMem = chunk.raw;
+			m_memSize = chunk.rawSize;
+		}
+	}
+
+	if (!m_joinMem.empty())
+	{
+		m_rawMem = m_joinMem.data();
+		m_memSize = (u32)m_joinMem.size();
+	}
+	m_memUsed = 0;
+}
+
+void Serializer_BinaryStreamRead::ReadAndDecompressLegacy(const u8* header, u32 headerSize)
+{
+	if (headerSize == 0)
 	{
 		// file complete
 		AbortRead(SerializerError_OK);
 		return;
 	}
 
-	if (readAmount < 8)
+	if (headerSize < 8)
 	{
 		AbortRead(SerializerError_TruncatedBlock);
 		return;
@@ -677,8 +919,7 @@ void Serializer_BinaryStreamRead::ReadAndDecompress()
 	u32 compressedSize = ((u32)header[0]<<24) | ((u32)header[1]<<16) | ((u32)header[2]<<8) | (u32)header[3];
 	u32 filechksum = ((u32)header[4]<<24) | ((u32)header[5]<<16) | ((u32)header[6]<<8) | (u32)header[7];
 
-	readAmount = ReadFileBlock(m_compressedMem, compressedSize);
-	if (readAmount != compressedSize)
+	if (compressedSize > CHUNKSIZE || ReadFileBlock(m_compressedMem, compressedSize) != compressedSize)
 	{
 		AbortRead(SerializerError_TruncatedBlock);
 		return;
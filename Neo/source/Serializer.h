@@ -3,6 +3,8 @@
 #include "FileManager.h"
 #include "zlib.h"
 #include "MemBlock.h"
+#include <bit>
+#include <span>
 
 //<REFLECT>
 enum SerializerError
@@ -236,7 +238,7 @@ public:
 
     virtual void Restart() { Error("cannot restart a writer"); }
 
-	MemBlock ToMemBlock() { MemBlock::CloneMem(DataStart(), DataSize()); }
+	MemBlock ToMemBlock() { return MemBlock::CloneMem(DataStart(), DataSize()); }
 
 protected:
 	vector<u8> m_mem;
@@ -322,6 +324,25 @@ protected:
 
 
 
+// compressed streams are split into chunks that compress and decompress on worker threads,
+// a few chunks ahead of (or behind) the caller filling or consuming the current one
+// streams start with a header, so files written before chunks were pipelined still read through the old path
+#define SERIALIZER_STREAM_MAGIC 0x4d54534e		// 'NSTM'
+#define SERIALIZER_STREAM_VERSION 2
+
+struct SerializerStreamChunk
+{
+	u8* raw = nullptr;
+	u8* compressed = nullptr;
+	u32 rawSize = 0;
+	u32 compressedSize = 0;
+	u32 crc = 0;
+	bool continued = false;		// a block too big for one chunk - the next chunk carries on from this one
+	SerializerError error = SerializerError_OK;
+	bool pending = false;		// handed to a worker - wait on done before touching it
+	Semaphore done;
+};
+
 class Serializer_BinaryStreamWrite : public Serializer
 {
 public:
@@ -354,13 +375,18 @@ public:
 
 protected:
 	void Flush();
+	void Reserve(u32 size);
+	void QueueFillChunk(u32 rawSize, bool continued);
+	void WriteChunk(SerializerStreamChunk& chunk);
 
 	static const int CHUNKSIZE = 512*1024;
+	static const int PipelineDepth = 4;
 	FileHandle m_fileHandle;
+	SerializerStreamChunk m_chunks[PipelineDepth];
+	int m_fillChunk = 0;
+	vector<u8> m_bigChunk;		// fills instead of the chunk when a block outgrows it
 	u8 *m_rawMem;
-	u8 *m_compressedMem;
 	u32 m_memUsed;
-	u8 m_encryptMask;
 
 	static const int MaxChunks = 16;
 	int m_chunkStackSize;
@@ -398,9 +424,16 @@ public:
 
 protected:
 	void ReadAndDecompress();
+	void QueueChunk(SerializerStreamChunk& chunk);
+	void ReadAndDecompressLegacy(const u8* header, u32 headerSize);
 	void AbortRead(SerializerError errCode);
 
 	static const int CHUNKSIZE = 1024*1024;
+	static const int PipelineDepth = 4;
+	bool m_chunked = false;		// false for old streams, which read into their own buffers
+	SerializerStreamChunk m_chunks[PipelineDepth];
+	int m_currentChunk = -1;
+	vector<u8> m_joinMem;		// continued chunks joined back into one block
 	u8 *m_rawMem;
 	u8 *m_compressedMem;
 	u32 m_memSize;
@@ -420,3 +453,339 @@ protected:
 	u32 ReadFileBlock(u8 *buffer, u32 size);
 	void CloseFile();
 };
+
+//=============================================================================================
+// TEMPLATED BINARY SERIALIZERS
+//
+// non virtual readers and writers for asset data - the archive type is known at compile time
+// so every primitive inlines to a memcpy.  data is little endian by default, which is native
+// on every platform we ship, so arrays of vertices, indices and pixels go across in one copy.
+// the big endian variants read (and write) the layout used by the Serializer classes above,
+// so asset data written before the switch still loads.
+//=============================================================================================
+
+enum class SerializerEndian
+{
+	Little,
+	Big
+};
+
+template <class T>
+inline T SerializerByteSwap(T value)
+{
+	u8 bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	std::reverse(bytes, bytes + sizeof(T));
+	memcpy(&value, bytes, sizeof(T));
+	return value;
+}
+
+// asset data starts with a u16 version.  the old serializers wrote it big endian, and versions
+// stay well below 256, so a version that only makes sense byte swapped is old big endian data
+inline SerializerEndian DetectAssetEndian(const MemBlock& block)
+{
+	if (block.Size() >= 2 && block.Mem()[0] == 0 && block.Mem()[1] != 0)
+		return SerializerEndian::Big;
+	return SerializerEndian::Little;
+}
+
+template <SerializerEndian Endian = SerializerEndian::Little>
+class BinaryWriter
+{
+public:
+	static constexpr bool NativeOrder = (Endian == SerializerEndian::Little) == (std::endian::native == std::endian::little);
+
+	// reserve up front if the final size is known, to skip regrowing the buffer
+	BinaryWriter(size_t reserve = 0) { if (reserve) Grow(reserve); }
+	~BinaryWriter() { delete[] m_mem; }
+	BinaryWriter(const BinaryWriter&) = delete;
+	BinaryWriter& operator=(const BinaryWriter&) = delete;
+
+	static constexpr bool IsReadMode() { return false; }
+
+	template <class T>
+	void Write(T value)
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Write only takes primitive types");
+		if constexpr (!NativeOrder && sizeof(T) > 1)
+			value = SerializerByteSwap(value);
+		memcpy(Reserve(sizeof(T)), &value, sizeof(T));
+	}
+
+	void WriteU8(u8 value) { Write(value); }
+	void WriteU16(u16 value) { Write(value); }
+	void WriteU32(u32 value) { Write(value); }
+	void WriteU64(u64 value) { Write(value); }
+	void WriteI8(i8 value) { Write(value); }
+	void WriteI16(i16 value) { Write(value); }
+	void WriteI32(i32 value) { Write(value); }
+	void WriteI64(i64 value) { Write(value); }
+	void WriteF32(f32 value) { Write(value); }
+	void WriteF64(f64 value) { Write(value); }
+	void WriteBool(bool value) { WriteU8(value ? 1 : 0); }
+	void WriteString(const string& value) { WriteU32((u32)value.size()); WriteMemory(value.data(), value.size()); }
+	void WriteVec3(const vec3& value) { WriteF32(value.x); WriteF32(value.y); WriteF32(value.z); }
+	void WriteVec4(const vec4& value) { WriteF32(value.x); WriteF32(value.y); WriteF32(value.z); WriteF32(value.w); }
+	void WriteQuat(const quat& value) { WriteF32(value.x); WriteF32(value.y); WriteF32(value.z); WriteF32(value.w); }
+
+	// raw bytes, no size
+	void WriteMemory(const void* mem, size_t size)
+	{
+		if (size > 0)
+			memcpy(Reserve(size), mem, size);
+	}
+
+	void WriteZeros(size_t size)
+	{
+		if (size > 0)
+			memset(Reserve(size), 0, size);
+	}
+
+	// u32 size then the bytes - same layout as Serializer_BinaryWriteGrow::WriteMemory(MemBlock)
+	void WriteMemory(const MemBlock& block) { WriteU32((u32)block.Size()); WriteMemory(block.Mem(), block.Size()); }
+
+	// u32 byte size then the elements in one copy
+	// elements are stored as they are in memory, like the old serializers did with raw vertex and index blocks
+	template <class T>
+	void WriteSpan(std::span<const T> items)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WriteSpan needs trivially copyable elements");
+		WriteU32((u32)items.size_bytes());
+		WriteMemory(items.data(), items.size_bytes());
+	}
+	template <class T>
+	void WriteVector(const vector<T>& items) { WriteSpan(std::span<const T>(items)); }
+
+	// chunks include size and allow validation and skipping of the chunk
+	void StartBlock()
+	{
+		Assert(m_chunkStackSize < MaxChunks, "Too many nested blocks!");
+		m_chunkStack[m_chunkStackSize++] = m_size;
+		Reserve(4);
+	}
+	void EndBlock()
+	{
+		Assert(m_chunkStackSize > 0, "No open chunks!");
+		size_t offset = m_chunkStack[--m_chunkStackSize];
+		u32 value = (u32)(m_size - offset - 4);
+		if constexpr (!NativeOrder)
+			value = SerializerByteSwap(value);
+		memcpy(m_mem + offset, &value, 4);
+	}
+
+	u8* DataStart() { return m_mem; }
+	size_t DataSize() const { return m_size; }
+
+	// hand the written data to a MemBlock without copying it - leaves the writer empty
+	MemBlock TakeBlock()
+	{
+		if (m_size == 0)
+			return MemBlock();
+		MemBlock block(m_mem, m_size, false);
+		m_mem = nullptr;
+		m_size = 0;
+		m_capacity = 0;
+		return block;
+	}
+
+protected:
+	u8* Reserve(size_t size)
+	{
+		if (m_size + size > m_capacity)
+			Grow(m_size + size);
+		u8* mem = m_mem + m_size;
+		m_size += size;
+		return mem;
+	}
+
+	void Grow(size_t needed)
+	{
+		size_t capacity = Max(Max(needed, m_capacity * 2), (size_t)256);
+		u8* mem = new u8[capacity];
+		if (m_size > 0)
+			memcpy(mem, m_mem, m_size);
+		delete[] m_mem;
+		m_mem = mem;
+		m_capacity = capacity;
+	}
+
+	u8* m_mem = nullptr;
+	size_t m_size = 0;
+	size_t m_capacity = 0;
+
+	static const int MaxChunks = 16;
+	int m_chunkStackSize = 0;
+	size_t m_chunkStack[MaxChunks];
+};
+
+template <SerializerEndian Endian = SerializerEndian::Little>
+class BinaryReader
+{
+public:
+	static constexpr bool NativeOrder = (Endian == SerializerEndian::Little) == (std::endian::native == std::endian::little);
+
+	BinaryReader(const u8* mem, size_t size) : m_mem(mem), m_memSize(size) {}
+	BinaryReader(const MemBlock& block) : m_mem(block.Mem()), m_memSize(block.Size()) {}
+
+	static constexpr bool IsReadMode() { return true; }
+
+	bool IsGood() const { return m_error == SerializerError_OK; }
+	SerializerError GetError() const { return m_error; }
+	void SetError(SerializerError code) { m_error = code; }
+
+	// if inside a block, then it refers just to the block
+	bool HasBufferRemaining(size_t size = 1) const
+	{
+		size_t memSize = (m_chunkStackSize > 0) ? m_chunkStack[m_chunkStackSize - 1] : m_memSize;
+		return m_memUsage <= memSize && memSize - m_memUsage >= size;
+	}
+
+	template <class T>
+	T Read()
+	{
+		static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Read only takes primitive types");
+		T value{};
+		if (const u8* mem = Consume(sizeof(T)))
+		{
+			memcpy(&value, mem, sizeof(T));
+			if constexpr (!NativeOrder && sizeof(T) > 1)
+				value = SerializerByteSwap(value);
+		}
+		return value;
+	}
+
+	u8 ReadU8() { return Read<u8>(); }
+	u16 ReadU16() { return Read<u16>(); }
+	u32 ReadU32() { return Read<u32>(); }
+	u64 ReadU64() { return Read<u64>(); }
+	i8 ReadI8() { return Read<i8>(); }
+	i16 ReadI16() { return Read<i16>(); }
+	i32 ReadI32() { return Read<i32>(); }
+	i64 ReadI64() { return Read<i64>(); }
+	f32 ReadF32() { return Read<f32>(); }
+	f64 ReadF64() { return Read<f64>(); }
+	bool ReadBool() { return ReadU8() != 0; }
+	vec3 ReadVec3() { vec3 value; value.x = ReadF32(); value.y = ReadF32(); value.z = ReadF32(); return value; }
+	vec4 ReadVec4() { vec4 value; value.x = ReadF32(); value.y = ReadF32(); value.z = ReadF32(); value.w = ReadF32(); return value; }
+	quat ReadQuat() { quat value; value.x = ReadF32(); value.y = ReadF32(); value.z = ReadF32(); value.w = ReadF32(); return value; }
+
+	string ReadString()
+	{
+		u32 length = ReadU32();
+		const u8* mem = Consume(length);
+		return mem ? string((const char*)mem, length) : string();
+	}
+
+	// raw bytes, no size
+	void ReadMemory(void* mem, size_t size)
+	{
+		if (const u8* src = Consume(size))
+			memcpy(mem, src, size);
+	}
+
+	// u32 size then the bytes, copied into a new block
+	MemBlock ReadMemory()
+	{
+		u32 size = ReadU32();
+		const u8* src = Consume(size);
+		if (!src || size == 0)
+			return MemBlock();
+		MemBlock block(size);
+		memcpy(block.Mem(), src, size);
+		return block;
+	}
+
+	// pointer straight into the source data - valid as long as the source is
+	const u8* ReadView(size_t size) { return Consume(size); }
+
+	// u32 byte size then the elements - fails if the size doesn't match the span
+	template <class T>
+	bool ReadSpan(std::span<T> items)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ReadSpan needs trivially copyable elements");
+		u32 size = ReadU32();
+		if (size != items.size_bytes())
+		{
+			BadData("Serializer span size mismatch!", SerializerError_BadData);
+			return false;
+		}
+		const u8* src = Consume(size);
+		if (src && size > 0)
+			memcpy(items.data(), src, size);
+		return src != nullptr;
+	}
+
+	// u32 byte size then the elements - sizes the vector to fit
+	template <class T>
+	bool ReadVector(vector<T>& items)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "ReadVector needs trivially copyable elements");
+		u32 size = ReadU32();
+		const u8* src = (size % sizeof(T) == 0) ? Consume(size) : nullptr;
+		if (!src)
+		{
+			BadData("Serializer vector size mismatch!", SerializerError_BadData);
+			items.clear();
+			return false;
+		}
+		items.resize(size / sizeof(T));
+		if (size > 0)
+			memcpy(items.data(), src, size);
+		return true;
+	}
+
+	// chunks include size and allow validation and skipping of the chunk
+	void StartBlock()
+	{
+		u32 size = ReadU32();
+		if (!HasBufferRemaining(size) || m_chunkStackSize >= MaxChunks)
+		{
+			BadData("Serializer block out of mem!", SerializerError_TruncatedBlock);
+			return;
+		}
+		m_chunkStack[m_chunkStackSize++] = m_memUsage + size;
+	}
+	void EndBlock()
+	{
+		Assert(m_chunkStackSize > 0, "no open chunks!");
+		m_memUsage = m_chunkStack[--m_chunkStackSize];
+	}
+
+	// the unread part of the buffer
+	const u8* DataStart() const { return m_mem + m_memUsage; }
+	size_t DataSize() const { return m_memSize - m_memUsage; }
+
+protected:
+	const u8* Consume(size_t size)
+	{
+		if (m_error != SerializerError_OK)
+			return nullptr;
+		if (!HasBufferRemaining(size))
+		{
+			BadData("Serializer block out of mem!", SerializerError_TruncatedBlock);
+			return nullptr;
+		}
+		const u8* mem = m_mem + m_memUsage;
+		m_memUsage += size;
+		return mem;
+	}
+
+	// report the first problem only - everything after it reads as zero
+	void BadData(const char* msg, SerializerError code)
+	{
+		if (m_error == SerializerError_OK)
+		{
+			Error(msg);
+			m_error = code;
+		}
+	}
+
+	const u8* m_mem;
+	size_t m_memSize;
+	size_t m_memUsage = 0;
+	SerializerError m_error = SerializerError_OK;
+
+	static const int MaxChunks = 16;
+	int m_chunkStackSize = 0;
+	size_t m_chunkStack[MaxChunks];
+};
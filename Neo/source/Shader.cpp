@@ -198,7 +198,7 @@ bool ShaderAssetData::SrcFilesToAsset(vector<MemBlock>& srcFiles, AssetCreatePar
 	// output interpolants
 	for (auto& attrib : interpolants)
 	{
-		string attribType = VertAttribType_EnumToString(attrib.type);
+		string_view attribType = VertAttribType_EnumToString(attrib.type);
 		vertOutputFile << std::format("layout(location = {}) out {} {};\n", attrib.binding, attribType, attrib.name);
 		fragOutputFile << std::format("layout(location = {}) in {} {};\n", attrib.binding, attribType, attrib.name);
 	}
@@ -206,7 +206,7 @@ bool ShaderAssetData::SrcFilesToAsset(vector<MemBlock>& srcFiles, AssetCreatePar
 	// output fragment shader outs
 	for (auto& attrib : fragmentOutputs)
 	{
-		string attribType = VertAttribType_EnumToString(attrib.type);
+		string_view attribType = VertAttribType_EnumToString(attrib.type);
 		fragOutputFile << std::format("layout(location = {}) out {} {};\n", attrib.binding, attribType, attrib.name);
 	}
 
@@ -366,7 +366,7 @@ void Shader::OnAssetDeliver(struct AssetData* data)
 	if (data)
 	{
 		m_assetData = dynamic_cast<ShaderAssetData*>(data);
-		RenderThread::Instance().AddPreDrawTask([this]() { m_platformData = ShaderPlatformData_Create(m_assetData); OnLoadComplete(); });
+		AddCreateTask([this]() { m_platformData = ShaderPlatformData_Create(m_assetData); PublishPlatformData(m_platformData); OnLoadComplete(); });
 	}
 	else
 	{
@@ -385,6 +385,7 @@ template <> ResourceFactory<Shader>::ResourceFactory()
 	ati->name = Shader::AssetType;
 	ati->assetCreator = []() -> AssetData* { return new ShaderAssetData; };
 	ati->assetExt = ".neoshader";
+	ati->version = SHADER_VERSION;
 	ati->sourceExt.push_back({ { ".shader" }, true });		// compile from source
 	AssetManager::Instance().RegisterAssetType(ati);
 }
@@ -64,7 +64,7 @@ struct UBO_Model
 
 struct UBOMemberInfo
 {
-	string name;
+	NeoName name;
 	VarType type = VarType_vec4;
 	u32 offset = 0;
 	u32 members = 1;
@@ -122,8 +122,8 @@ struct RenderPassInfo
 
 class ShaderManager : public Module<ShaderManager>
 {
-	hashtable<string, UBOInfo*> m_ubos;
-	hashtable<string, InputAttributesDescription*> m_iads;
+	hashtable<NeoName, UBOInfo*> m_ubos;
+	hashtable<NeoName, InputAttributesDescription*> m_iads;
 
 public:
 	ShaderManager();
@@ -132,7 +132,7 @@ public:
 	void RegisterUBO(UBOInfo *uboInfo);
 	string UBOContentsToString(const UBOInfo &uboInfo);
 	UBOInfoInstance* CreateUBOInstance(UBOInfo *uboInfo, bool dynamic);
-	UBOInfo* FindUBO(const string& name)
+	UBOInfo* FindUBO(NeoName name)
 	{
 		auto it = m_ubos.find(name);
 		return (it != m_ubos.end()) ? it->second : nullptr;
@@ -140,7 +140,7 @@ public:
 
 	void RegisterIAD(InputAttributesDescription* iad);
 	void CreatePlatformData();
-	InputAttributesDescription* FindIAD(const string& name)
+	InputAttributesDescription* FindIAD(NeoName name)
 	{
 		auto it = m_iads.find(name);
 		return (it != m_iads.end()) ? it->second : nullptr;
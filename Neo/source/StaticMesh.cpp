@@ -4,13 +4,14 @@
 #include "StringUtils.h"
 #include "SHAD.h"
 #include "ResourceLoadedManager.h"
+#include "AssetBlob.h"
 #include <tiny_obj_loader.h>
 
 #include <iostream>
 #include <sstream>
 #include <streambuf>
 
-#define STATICMESH_VERSION 1
+#define STATICMESH_VERSION 3
 
 DECLARE_MODULE(StaticMeshFactory, NeoModuleInitPri_StaticMeshFactory, NeoModulePri_None);
 
@@ -27,11 +28,37 @@ void StaticMesh::OnAssetDeliver(AssetData* data)
 
 	// we need to wait for our dependant resources, like Shaders and Textures,  to load first before creating our platform data (which are pipeline states)
 	// note that if they are already loaded, this will just trigger off the callback immediately
-	ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]() { m_platformData = StaticMeshPlatformData_Create(m_assetData); OnLoadComplete(); });
+	ResourceLoadedManager::Instance().AddDependancyList(this, dependantResources, [this]()
+	{
+		m_platformData = StaticMeshPlatformData_Create(m_assetData);
+		PublishPlatformData(m_platformData);
+		AssetManager::Instance().ApplyResidency(m_assetData);
+		OnLoadComplete();
+	});
 }
 
 void StaticMesh::Reload()
 {
+	if (!IsLoaded() || !m_assetData)
+		return;
+
+	// the verts & indices may have been freed after upload - bring them back on an asset worker before rebuilding the gpu copy
+	// the reference keeps the mesh alive until the restore is done
+	IncRef();
+	AssetManager::Instance().RestoreBulkDataAsync(m_assetData, [this](bool restored)
+	{
+		if (restored)
+		{
+			AddCreateTask([this]()
+			{
+				StaticMeshPlatformData_Destroy(m_platformData);
+				m_platformData = StaticMeshPlatformData_Create(m_assetData);
+				PublishPlatformData(m_platformData);
+				AssetManager::Instance().ApplyResidency(m_assetData);
+			});
+		}
+		StaticMeshFactory::Instance().Destroy(this);
+	});
 }
 
 template <> ResourceFactory<StaticMesh>::ResourceFactory()
@@ -39,11 +66,63 @@ template <> ResourceFactory<StaticMesh>::ResourceFactory()
 	auto ati = new AssetTypeInfo();
 	ati->name = StaticMesh::AssetType;
 	ati->assetExt = ".neomdl";
+	ati->version = STATICMESH_VERSION;
 	ati->assetCreator = []() -> AssetData* { return new StaticMeshAssetData; };
 	ati->sourceExt.push_back({ { ".obj" }, true });		// on of these src image files
+	ati->codec = MemBlockCodec_LZ;						// big vertex blobs, so favour load speed
+	ati->residency = AssetResidency_ReleaseAfterUpload;	// verts & indices live in the geometry buffer once uploaded
+	ati->memoryGroup = MemoryGroup_Models;
 	AssetManager::Instance().RegisterAssetType(ati);
 }
 
+// in place layout - the root is followed by the names, the verts and the indices
+struct StaticMeshBlob
+{
+	AssetBlobHeader header;
+	BlobArray<char> name;
+	BlobArray<char> materialName;
+	BlobArray<Vertex_p3f_t2f_c4b> verts;
+	BlobArray<u32> indices;
+};
+
+static MemBlock BuildStaticMeshBlob(const string& name, const vector<Vertex_p3f_t2f_c4b>& verts, const vector<u32>& indices, const string& materialName)
+{
+	size_t bulkSize = verts.size() * sizeof(Vertex_p3f_t2f_c4b) + indices.size() * sizeof(u32);
+	AssetBlobWriter<StaticMeshBlob> blob(STATICMESH_VERSION, bulkSize + name.size() + materialName.size() + 64);
+	auto blobName = blob.Add(name);
+	auto blobMaterialName = blob.Add(materialName);
+	auto blobVerts = blob.Add(verts);
+	auto blobIndices = blob.Add(indices);
+
+	auto& root = blob.GetRoot();
+	root.name = blobName;
+	root.materialName = blobMaterialName;
+	root.verts = blobVerts;
+	root.indices = blobIndices;
+	return blob.Finish();
+}
+
+u64 StaticMeshAssetData::ReleaseBulkData()
+{
+	u64 size = blob.Size();
+	verts = {};
+	indices = {};
+	blob = MemBlock();
+	return size;
+}
+
+u64 StaticMeshAssetData::RestoreBulkData(AssetData* loaded)
+{
+	// moving the blob keeps its memory where it is, so the views still point into it
+	auto loadedMesh = dynamic_cast<StaticMeshAssetData*>(loaded);
+	verts = loadedMesh->verts;
+	indices = loadedMesh->indices;
+	blob = std::move(loadedMesh->blob);
+	loadedMesh->verts = {};
+	loadedMesh->indices = {};
+	return blob.Size();
+}
+
 class MemoryStream : public std::streambuf {
 public:
 	MemoryStream(u8* data, std::size_t size) {
@@ -96,6 +175,8 @@ bool StaticMeshAssetData::SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreat
 		return false;
 	}
 
+	vector<Vertex_p3f_t2f_c4b> meshVerts;
+	vector<u32> meshIndices;
 	hashtable<Vertex_p3f_t2f_c4b, u32> uniqueVertices{};
 
 	for (const auto& shape : shapes) {
@@ -116,58 +197,96 @@ bool StaticMeshAssetData::SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreat
 			vertex.color = vec4ToR8G8B8A8({ 1.0f, 1.0f, 1.0f, 1.0f });
 
 			if (uniqueVertices.count(vertex) == 0) {
-				uniqueVertices[vertex] = static_cast<uint32_t>(verts.size());
-				verts.push_back(vertex);
+				uniqueVertices[vertex] = static_cast<uint32_t>(meshVerts.size());
+				meshVerts.push_back(vertex);
 			}
 
-			indices.push_back(uniqueVertices[vertex]);
+			meshIndices.push_back(uniqueVertices[vertex]);
 		}
 	}
 
 	Assert(materials.size() == 1, "Only support single material objs atm");
 	materialName = materials[0].name;
-	return true;
+
+	// keep the converted mesh in the same in place form it will be loaded in
+	return MemoryToAssetInPlace(BuildStaticMeshBlob(name, meshVerts, meshIndices, materialName));
 }
 
 MemBlock StaticMeshAssetData::AssetToMemory()
 {
-	Serializer_BinaryWriteGrow stream;
-	stream.WriteU16(STATICMESH_VERSION);
-	stream.WriteString(name);
-
-	u32 vertSize = (u32)(verts.size() * sizeof(Vertex_p3f_t2f_c4b));
-	stream.WriteU32(vertSize);
-	stream.WriteMemory((u8*)verts.data(), vertSize);
-	u32 indiceSize = (u32)(indices.size() * sizeof(u32));
-	stream.WriteU32(indiceSize);
-	stream.WriteMemory((u8*)indices.data(), indiceSize);
-	stream.WriteString(materialName);
-
-	return MemBlock::CloneMem(stream.DataStart(), stream.DataSize());
+	return MemBlock::CloneMem(blob.Mem(), blob.Size());
 }
 
-bool StaticMeshAssetData::MemoryToAsset(const MemBlock& block)
+bool StaticMeshAssetData::MemoryToAssetInPlace(MemBlock&& block)
+{
+	if (!IsAssetBlob(block))
+		return MemoryToAsset(block);
+
+	AssetBlobReader reader(block);
+	auto root = reader.GetRoot<StaticMeshBlob>(STATICMESH_VERSION);
+	if (!root)
+	{
+		LOG(Mesh, STR("Rebuilding {} - old blob version - expected {}", name, STATICMESH_VERSION));
+		return false;
+	}
+
+	version = root->header.version;
+	name = reader.ResolveString(root->name);
+	materialName = reader.ResolveString(root->materialName);
+	verts = reader.Resolve(root->verts);
+	indices = reader.Resolve(root->indices);
+	if (!reader.IsGood())
+	{
+		Error(STR("Corrupt mesh data: {}", name));
+		verts = {};
+		indices = {};
+		return false;
+	}
+
+	blob = std::move(block);
+	return true;
+}
+
+// version 1 is the stream layout written big endian by the old serializer, version 2 the same layout little endian
+#define STATICMESH_VERSION_BIGENDIAN 1
+#define STATICMESH_VERSION_STREAM 2
+
+template <class Reader>
+static bool ReadStaticMeshAssetData(StaticMeshAssetData& asset, Reader& stream)
 {
-	Serializer_BinaryRead stream(block);
-	version = stream.ReadU16();
-	name = stream.ReadString();
+	u16 version = stream.ReadU16();
+	string name = stream.ReadString();
 
-	if (version != STATICMESH_VERSION)
+	u16 expectedVersion = std::is_same_v<Reader, BinaryReader<SerializerEndian::Big>> ? STATICMESH_VERSION_BIGENDIAN : STATICMESH_VERSION_STREAM;
+	if (version != expectedVersion)
 	{
 		LOG(Mesh, STR("Rebuilding {} - old version {} - expected {}", name, version, STATICMESH_VERSION));
 		return false;
 	}
 
-	auto vertBlock = stream.ReadMemory();
-	auto indiceBlock = stream.ReadMemory();
-	materialName = stream.ReadString();
+	vector<Vertex_p3f_t2f_c4b> verts;
+	vector<u32> indices;
+	stream.ReadVector(verts);
+	stream.ReadVector(indices);
+	string materialName = stream.ReadString();
+	if (!stream.IsGood())
+		return false;
 
-	verts.assign((Vertex_p3f_t2f_c4b*)vertBlock.Mem(), (Vertex_p3f_t2f_c4b*)(vertBlock.Mem() + vertBlock.Size()));
-	vertBlock.ClearMemPtrs();
+	return asset.MemoryToAssetInPlace(BuildStaticMeshBlob(name, verts, indices, materialName));
+}
 
-	indices.assign((u32*)indiceBlock.Mem(), (u32*)(indiceBlock.Mem() + indiceBlock.Size()));
-	indiceBlock.ClearMemPtrs();
+bool StaticMeshAssetData::MemoryToAsset(const MemBlock& block)
+{
+	// the caller keeps its block, so in place data needs a copy to point into
+	if (IsAssetBlob(block))
+		return MemoryToAssetInPlace(MemBlock::CloneMem((u8*)block.Mem(), block.Size()));
 
-	return true;
+	if (DetectAssetEndian(block) == SerializerEndian::Big)
+	{
+		BinaryReader<SerializerEndian::Big> stream(block);
+		return ReadStaticMeshAssetData(*this, stream);
+	}
+	BinaryReader<> stream(block);
+	return ReadStaticMeshAssetData(*this, stream);
 }
 
@@ -36,11 +36,16 @@ struct StaticMeshAssetData : public AssetData
 
 	virtual MemBlock AssetToMemory() override;
 	virtual bool MemoryToAsset(const MemBlock& block) override;
+	virtual bool MemoryToAssetInPlace(MemBlock&& block) override;
 	virtual bool SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreateParams* params) override;
+	virtual u64 ReleaseBulkData() override;
+	virtual u64 RestoreBulkData(AssetData* loaded) override;
 
-	vector<Vertex_p3f_t2f_c4b> verts;
-	vector<u32> indices;
+	// verts and indices point into the blob - the in place data from the data file, or built by the converter
+	std::span<Vertex_p3f_t2f_c4b> verts;
+	std::span<u32> indices;
 	string materialName;
+	MemBlock blob;
 
 	MaterialRef material;
 };
@@ -78,20 +78,7 @@ string StringReplace(const string& str, char oldChar, char newChar)
 
 u64 StringHash64(const string& str)
 {
-    u64 offsetBasis = 2166136261;
-    u64 prime = 16777619;
-    u64 hash = offsetBasis;
-    const char* pCH = str.c_str();
-    while (*pCH)
-    {
-        int ch = tolower(*pCH);
-        hash ^= (ch & 15);
-        hash *= prime;
-        hash ^= (ch >> 4);
-        hash *= prime;
-        pCH++;
-    }
-    return hash;
+    return NeoNameHash(str);
 }
 
 void StringSplitIntoFileParts(const string &str, string *pFilesys, string *pDirectory, string* pFilename, string* pExt)
@@ -157,11 +144,17 @@ string StringAddPath(const string& base, const string& path)
 {
     string result = base;
 
-    // Check if the first string is empty or doesn't end with a backslash
-    if (base.back() != '\\' || base.back() == '.') 
+#if defined(PLATFORM_Windows)
+    const char separator = '\\';
+#else
+    const char separator = '/';
+#endif
+
+    // Check if the first string is empty or doesn't end with a separator
+    if (base.back() != separator || base.back() == '.') 
     {
-        // Insert a backslash between the strings
-        result += '\\';
+        // Insert a separator between the strings
+        result += separator;
     }
 
     // Concatenate the second string to the first
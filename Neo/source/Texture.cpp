@@ -2,9 +2,10 @@
 #include "Texture.h"
 #include "StringUtils.h"
 #include "RenderThread.h"
+#include "AssetBlob.h"
 #include <stb_image.h>
 
-#define TEXTURE_VERSION 1
+#define TEXTURE_VERSION 3
 
 DECLARE_MODULE(TextureFactory, NeoModuleInitPri_TextureFactory, NeoModulePri_None);
 
@@ -19,7 +20,9 @@ void Texture::InitRenderTarget(const string& name, int width, int height, Textur
 	m_assetData->height = height;
 	m_assetData->format = format;
 	m_assetData->isRenderTarget = true;
-	RenderThread::Instance().AddPreDrawTask([this]() { m_platformData = TexturePlatformData_Create(m_assetData); OnLoadComplete(); });
+
+	// render targets are wanted next frame, so these skip the budgeted create list
+	RenderThread::Instance().AddPreDrawTask([this]() { m_platformData = TexturePlatformData_Create(m_assetData); PublishPlatformData(m_platformData); OnLoadComplete(); });
 }
 
 Texture::~Texture()
@@ -31,7 +34,13 @@ void Texture::OnAssetDeliver(AssetData* data)
 	if (data)
 	{
 		m_assetData = dynamic_cast<TextureAssetData*>(data);
-		RenderThread::Instance().AddPreDrawTask([this]() { m_platformData = TexturePlatformData_Create(m_assetData); OnLoadComplete(); });
+		AddCreateTask([this]()
+		{
+			m_platformData = TexturePlatformData_Create(m_assetData);
+			PublishPlatformData(m_platformData);
+			AssetManager::Instance().ApplyResidency(m_assetData);
+			OnLoadComplete();
+		});
 	}
 	else
 	{
@@ -42,6 +51,26 @@ void Texture::OnAssetDeliver(AssetData* data)
 
 void Texture::Reload()
 {
+	if (!IsLoaded() || !m_assetData)
+		return;
+
+	// the pixels may have been freed after upload - bring them back on an asset worker before rebuilding the gpu copy
+	// the reference keeps the texture alive until the restore is done
+	IncRef();
+	AssetManager::Instance().RestoreBulkDataAsync(m_assetData, [this](bool restored)
+	{
+		if (restored)
+		{
+			AddCreateTask([this]()
+			{
+				TexturePlatformData_Destroy(m_platformData);
+				m_platformData = TexturePlatformData_Create(m_assetData);
+				PublishPlatformData(m_platformData);
+				AssetManager::Instance().ApplyResidency(m_assetData);
+			});
+		}
+		TextureFactory::Instance().Destroy(this);
+	});
 }
 
 Texture* TextureFactory::CreateRenderTarget(const string& name, int width, int height, TexturePixelFormat format)
@@ -60,9 +89,13 @@ template <> ResourceFactory<Texture>::ResourceFactory()
 	auto ati = new AssetTypeInfo();
 	ati->name = Texture::AssetType;
 	ati->assetExt = ".neotex";
+	ati->version = TEXTURE_VERSION;
 	ati->assetCreator = []() -> AssetData* { return new TextureAssetData; };
 	ati->sourceExt.push_back({ { ".png", ".tga", ".jpg" }, true });		// on of these src image files
 	ati->sourceExt.push_back({ { ".tex" }, false });						// an optional text file to config how to convert the file
+	ati->codec = MemBlockCodec_LZ;											// big pixel blobs, so favour load speed
+	ati->residency = AssetResidency_ReleaseAfterUpload;						// pixels live on the gpu once uploaded
+	ati->memoryGroup = MemoryGroup_Texture;
 	AssetManager::Instance().RegisterAssetType(ati);
 }
 
@@ -111,48 +144,155 @@ bool TextureAssetData::SrcFilesToAsset(vector<MemBlock> &srcFiles, AssetCreatePa
 	return true;
 }
 
+// in place layout - the root is followed by the name, the mips and the table of mips
+struct TextureBlob
+{
+	AssetBlobHeader header;
+	BlobArray<char> name;
+	u16 width;
+	u16 height;
+	u16 format;
+	u16 pad;
+	BlobArray<BlobArray<u8>> mips;
+};
+
 MemBlock TextureAssetData::AssetToMemory()
 {
-	Serializer_BinaryWriteGrow stream;
-	stream.WriteU16(TEXTURE_VERSION);
-	stream.WriteString(name);
+	size_t imageSize = 0;
+	for (auto& block : images)
+		imageSize += block.Size() + 16;
 
 	LOG(Texture, STR("name {} images {}", name, images.size()));
 
-	stream.WriteU16(width);
-	stream.WriteU16(height);
-	stream.WriteU16((u16)format);
-	stream.WriteU16((u16)images.size());
+	AssetBlobWriter<TextureBlob> blob(TEXTURE_VERSION, imageSize + name.size() + images.size() * sizeof(BlobArray<u8>) + 32);
+	auto blobName = blob.Add(name);
+	vector<BlobArray<u8>> mips;
 	for (auto& block : images)
-		stream.WriteMemory(block);
+		mips.push_back(blob.Add(std::span<const u8>(block.Mem(), block.Size())));
+	auto blobMips = blob.Add(mips);
 
-	return MemBlock::CloneMem(stream.DataStart(), stream.DataSize());
+	auto& root = blob.GetRoot();
+	root.name = blobName;
+	root.width = width;
+	root.height = height;
+	root.format = (u16)format;
+	root.mips = blobMips;
+	return blob.Finish();
 }
 
-bool TextureAssetData::MemoryToAsset(const MemBlock& block)
+bool TextureAssetData::MemoryToAssetInPlace(MemBlock&& block)
+{
+	if (!IsAssetBlob(block))
+		return MemoryToAsset(block);
+
+	AssetBlobReader reader(block);
+	auto root = reader.GetRoot<TextureBlob>(TEXTURE_VERSION);
+	if (!root)
+	{
+		LOG(Texture, STR("Rebuilding {} - old blob version - expected {}", name, TEXTURE_VERSION));
+		return false;
+	}
+
+	version = root->header.version;
+	name = reader.ResolveString(root->name);
+	width = root->width;
+	height = root->height;
+	format = (TexturePixelFormat)root->format;
+
+	// the mips stay where they are - the images just point into the blob
+	images.clear();
+	for (auto& mip : reader.Resolve(root->mips))
+	{
+		auto pixels = reader.Resolve(mip);
+		images.push_back(MemBlock(pixels.data(), pixels.size(), true));
+	}
+	if (!reader.IsGood())
+	{
+		Error(STR("Corrupt texture data: {}", name));
+		images.clear();
+		return false;
+	}
+
+	LOG(Texture, STR("Load {} mips {}", name, images.size()));
+	blob = std::move(block);
+	return true;
+}
+
+// version 1 is the stream layout written big endian by the old serializer, version 2 the same layout little endian
+#define TEXTURE_VERSION_BIGENDIAN 1
+#define TEXTURE_VERSION_STREAM 2
+
+template <class Reader>
+static bool ReadTextureAssetData(TextureAssetData& asset, Reader& stream)
 {
-	Serializer_BinaryRead stream(block);
-	version = stream.ReadU16();
-	name = stream.ReadString();
+	asset.version = stream.ReadU16();
+	asset.name = stream.ReadString();
 
-	if (version != TEXTURE_VERSION)
+	u16 expectedVersion = std::is_same_v<Reader, BinaryReader<SerializerEndian::Big>> ? TEXTURE_VERSION_BIGENDIAN : TEXTURE_VERSION_STREAM;
+	if (asset.version != expectedVersion)
 	{
-		LOG(Texture, STR("Rebuilding {} - old version {} - expected {}", name, version, TEXTURE_VERSION));
+		LOG(Texture, STR("Rebuilding {} - old version {} - expected {}", asset.name, asset.version, TEXTURE_VERSION));
 		return false;
 	}
 
-	width = stream.ReadU16();
-	height = stream.ReadU16();
-	format = (TexturePixelFormat)stream.ReadU16();
+	asset.width = stream.ReadU16();
+	asset.height = stream.ReadU16();
+	asset.format = (TexturePixelFormat)stream.ReadU16();
 	int miplevels = stream.ReadU16();
 
-	LOG(Texture, STR("Load {} mips {}", name, miplevels));
+	LOG(Texture, STR("Load {} mips {}", asset.name, miplevels));
 
+	asset.images.reserve(miplevels);
 	for (int i = 0; i < miplevels; i++)
 	{
-		images.push_back(stream.ReadMemory());
+		asset.images.push_back(stream.ReadMemory());
 	}
-	return true;
+	return stream.IsGood();
+}
+
+bool TextureAssetData::MemoryToAsset(const MemBlock& block)
+{
+	// the caller keeps its block, so in place data needs a copy to point into
+	if (IsAssetBlob(block))
+		return MemoryToAssetInPlace(MemBlock::CloneMem((u8*)block.Mem(), block.Size()));
+
+	if (DetectAssetEndian(block) == SerializerEndian::Big)
+	{
+		BinaryReader<SerializerEndian::Big> stream(block);
+		return ReadTextureAssetData(*this, stream);
+	}
+	BinaryReader<> stream(block);
+	return ReadTextureAssetData(*this, stream);
+}
+
+u64 TextureAssetData::ReleaseBulkData()
+{
+	u64 size = blob.Size();
+	if (size == 0)
+	{
+		for (auto& image : images)
+			size += image.Size();
+	}
+	images.clear();
+	images.shrink_to_fit();
+	blob = MemBlock();
+	return size;
+}
+
+u64 TextureAssetData::RestoreBulkData(AssetData* loaded)
+{
+	// moving the blob keeps its memory where it is, so the images still point into it
+	auto loadedTexture = dynamic_cast<TextureAssetData*>(loaded);
+	images = std::move(loadedTexture->images);
+	blob = std::move(loadedTexture->blob);
+
+	u64 size = blob.Size();
+	if (size == 0)
+	{
+		for (auto& image : images)
+			size += image.Size();
+	}
+	return size;
 }
 
 void Texture::SetLayout(TextureLayout newLayout)
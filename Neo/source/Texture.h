@@ -102,13 +102,17 @@ public:
 
 	virtual MemBlock AssetToMemory() override;
 	virtual bool MemoryToAsset(const MemBlock& block) override;
+	virtual bool MemoryToAssetInPlace(MemBlock&& block) override;
 	virtual bool SrcFilesToAsset(vector<MemBlock>& srcBlocks, struct AssetCreateParams* params) override;
+	virtual u64 ReleaseBulkData() override;
+	virtual u64 RestoreBulkData(AssetData* loaded) override;
 
 	bool isRenderTarget = false;
 	u16 width = 0;
 	u16 height = 0;
 	TexturePixelFormat format = PixFmt_Undefined;
 	vector<MemBlock> images;		// one for each mip level
+	MemBlock blob;					// in place data the images point into, when loaded from a data file
 };
 
 // texture is the game facing class that represents any type of texture  (zbuffer, rendertarget, image)
@@ -1,5 +1,6 @@
 #include "neo.h"
 #include "thread.h"
+#include "TimeManager.h"
 
 #if defined(PLATFORM_Switch)
 #include "nn/nn_Assert.h"
@@ -81,6 +82,7 @@ void Thread::Begin()
     SetName();
     RegisterThread(m_guid, m_name);
     Go();
+    UnregisterThread();
     m_finished = true;
 }
 
@@ -151,6 +153,12 @@ void Thread::RegisterThread(int guid, const string& name)
     s_threadRegistry[threadID] = { guid,name };
 }
 
+void Thread::UnregisterThread()
+{
+    ScopedMutexLock lock(s_threadRegistryLock);
+    s_threadRegistry.erase(CurrentThreadID());
+}
+
 int Thread::GetCurrentThreadGUID()
 {
     ScopedMutexLock lock(s_threadRegistryLock);
@@ -177,6 +185,60 @@ string Thread::GetCurrentThreadName()
     return (it != s_threadRegistry.end()) ? it->second.name : "";
 }
 
+int BudgetedTaskList::Add(GenericCallback task, int priority)
+{
+    ScopedMutexLock lock(m_taskLock);
+    int handle = m_uniqueHandle++;
+    m_tasks.push_back({ handle, priority, task });
+    std::push_heap(m_tasks.begin(), m_tasks.end(), RunsAfter);
+    return handle;
+}
+
+void BudgetedTaskList::Remove(int handle)
+{
+    ScopedMutexLock lock(m_taskLock);
+    auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [handle](const Entry& entry) { return entry.handle == handle; });
+    if (it != m_tasks.end())
+    {
+        m_tasks.erase(it);
+        std::make_heap(m_tasks.begin(), m_tasks.end(), RunsAfter);
+    }
+}
+
+bool BudgetedTaskList::PopNext(GenericCallback& task)
+{
+    ScopedMutexLock lock(m_taskLock);
+    if (m_tasks.empty())
+        return false;
+    std::pop_heap(m_tasks.begin(), m_tasks.end(), RunsAfter);
+    task = std::move(m_tasks.back().task);
+    m_tasks.pop_back();
+    return true;
+}
+
+int BudgetedTaskList::Execute(double budgetSeconds)
+{
+    // tasks are run outside the lock, since they often add more tasks
+    double endTime = NeoTimeNow + budgetSeconds;
+    GenericCallback task;
+    while (PopNext(task))
+    {
+        task();
+        if (NeoTimeNow >= endTime)
+            break;
+    }
+
+    ScopedMutexLock lock(m_taskLock);
+    return (int)m_tasks.size();
+}
+
+void BudgetedTaskList::ExecuteAll()
+{
+    GenericCallback task;
+    while (PopNext(task))
+        task();
+}
+
 int WorkerThread::Go()
 {
     m_taskSignals.Wait();
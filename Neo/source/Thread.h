@@ -31,6 +31,11 @@ enum ThreadGUID
     ThreadGUID_GILTasks,
     ThreadGUID_AssetManager,
     ThreadGUID_Render,
+    ThreadGUID_ArchiveBuilder,
+    ThreadGUID_FileScan,
+    ThreadGUID_AssetWriter,
+    ThreadGUID_AssetDecode,
+    ThreadGUID_StreamCompress,
 
     ThreadGUID_MAX
 };
@@ -43,6 +48,9 @@ public:
     // each thread can register a static unique ID for identifying later what thread any code is running on
     static void RegisterThread(int guid, const string& name);
 
+    // remove the current thread from the registry - called when a thread exits so its ID can be reused
+    static void UnregisterThread();
+
     // check what the current thread guid is.  -1 for unknown thread (thread wasn't registered)
     static int GetCurrentThreadGUID();
 
@@ -222,6 +230,35 @@ public:
 
 
 
+// thread safe task list that runs the highest priority tasks first, for as long as a time budget allows
+// tasks that don't fit in the budget stay queued for the next call
+class BudgetedTaskList
+{
+    struct Entry
+    {
+        int handle;
+        int priority;
+        GenericCallback task;
+    };
+    int m_uniqueHandle = 0;
+    Mutex m_taskLock;
+    vector<Entry> m_tasks;      // heap - highest priority, then oldest, at the front
+
+    static bool RunsAfter(const Entry& a, const Entry& b) { return (a.priority != b.priority) ? a.priority < b.priority : a.handle > b.handle; }
+    bool PopNext(GenericCallback& task);
+
+public:
+    int Add(GenericCallback task, int priority);
+    void Remove(int handle);
+
+    // run tasks until the budget is spent - at least one task always runs, so the list drains even if every task is over budget
+    // returns the number of tasks left for next time
+    int Execute(double budgetSeconds);
+
+    // run everything, including tasks added while running
+    void ExecuteAll();
+};
+
 // a worker thread that executes one off tasks
 class WorkerThread : public Thread
 {
@@ -195,7 +195,7 @@ void GIL::BeginFrame()
     m_swapChainColorLayout = TextureLayout_Undefined;
     m_swapChainDepthLayout = TextureLayout_Undefined;
 
-    m_boundMaterial = nullptr;
+    m_boundMaterial = 0;
     m_boundRenderPass = nullptr;
     m_boundView = nullptr;
 
@@ -246,27 +246,12 @@ void GIL::UpdateUBOInstance(UBOInfoInstance *uboInstance, void* uboMem, u32 uboS
         m_dynamicUniformBufferMemoryUsed += size;
 
         // update bound material if its applicable to the current render pass
-        if (m_boundMaterial && updateBoundMaterial)
+        auto materialPD = updateBoundMaterial ? MaterialFactory::Instance().GetPlatformData(m_boundMaterial) : nullptr;
+        if (materialPD)
         {
-            auto materialAD = m_boundMaterial->GetAssetData();
-            auto materialPD = m_boundMaterial->GetPlatformData();
-
-            MaterialRenderPassInfo* mrpi = nullptr;
-            MaterialPlatformRenderPassData* mprp = nullptr;
-            for (int i=0; i<materialAD->renderPasses.size(); i++)
-            {
-                if (materialAD->renderPasses[i]->renderPass == m_boundRenderPass)
-                {
-                    mrpi = materialAD->renderPasses[i];
-                    mprp = materialPD->renderPasses[i];
-                    break;
-                }
-            }
-
-            if (mrpi && mprp)
+            auto mprp = materialPD->FindRenderPass(m_boundRenderPass);
+            if (mprp)
             {
-                auto shaderAD = mrpi->shader->GetAssetData();
-                auto shaderPD = mrpi->shader->GetPlatformData();
                 auto commandBuffer = m_commandBuffers[m_currentFrame];
 
                 // check if bound material references this UBO
@@ -1611,25 +1596,19 @@ void GIL::generateMipmaps(VkImage image, VkFormat imageFormat, int32_t texWidth,
 
 // use material
 void GIL::BindMaterial(Material* material, bool lines)
+{
+    BindMaterial(material ? material->GetHandle() : 0, lines);
+}
+
+void GIL::BindMaterial(ResourceHandle material, bool lines)
 {
     Assert(Thread::IsOnThread(ThreadGUID_Render), STR("{} must be run on render thread,  currently on thread {}", __FUNCTION__, Thread::GetCurrentThreadGUID()));
 
-    auto materialPD = material->GetPlatformData();
-    auto materialAD = material->GetAssetData();
-    if (materialPD)
+    // a stale handle or a material that isn't created yet has no platform data
+    auto materialPD = MaterialFactory::Instance().GetPlatformData(material);
+    auto mprpd = materialPD ? materialPD->FindRenderPass(m_boundRenderPass) : nullptr;
+    if (mprpd)
     {
-        MaterialPlatformRenderPassData *mprpd = nullptr;
-        MaterialRenderPassInfo* mrpi = nullptr;
-        for (int i = 0; i < materialAD->renderPasses.size(); i++)
-        {
-            if (materialAD->renderPasses[i]->renderPass == m_boundRenderPass)
-            {
-                mrpi = materialAD->renderPasses[i];
-                mprpd = materialPD->renderPasses[i];
-                break;
-            }
-        }
-
         auto commandBuffer = m_commandBuffers[m_currentFrame];
         if (lines)
             vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mprpd->linePipeline);
@@ -1638,9 +1617,6 @@ void GIL::BindMaterial(Material* material, bool lines)
 
         u32 dynamicOffsets[16]; // maximum of 16 should be enough for any shader
         int dynamicOffsetCount = 0;
-        auto shader = mrpi->shader;
-        auto shaderPD = shader->GetPlatformData();
-        auto shaderAD = shader->GetAssetData();
         for (auto &it : mprpd->uboInstances)
         {
             auto uboInstance = it.second;
@@ -1702,37 +1678,33 @@ void GIL::RenderPrimitive(u32 vertStart, u32 vertCount, u32 indexStart, u32 inde
 }
 
 
-void GIL::RenderStaticMesh(StaticMesh *mesh)
+void GIL::RenderStaticMesh(ResourceHandle mesh)
 {
     Assert(Thread::IsOnThread(ThreadGUID_Render), STR("{} must be run on render thread,  currently on thread {}", __FUNCTION__, Thread::GetCurrentThreadGUID()));
 
     // check platform data has been created successfully
-    auto meshPD = mesh->GetPlatformData();
-    auto meshAD = mesh->GetAssetData();
-    auto material = *(meshAD->material);
-    if (!meshPD || !meshAD || !material || !meshPD->geomBuffer)
+    auto meshPD = StaticMeshFactory::Instance().GetPlatformData(mesh);
+    if (!meshPD || !meshPD->geomBuffer || !MaterialFactory::Instance().GetPlatformData(meshPD->material))
         return;
 
-    BindMaterial(material, false);
+    BindMaterial(meshPD->material, false);
     BindGeometryBuffer(meshPD->geomBuffer);
     SetRenderPrimitiveType(PrimType_TriangleList);
     RenderPrimitive(0, 0, 0, meshPD->indiceCount);
 }
 
-void GIL::RenderStaticMeshInstances(class StaticMesh* mesh, mat4x4* ltw, u32 ltwCount)
+void GIL::RenderStaticMeshInstances(ResourceHandle mesh, mat4x4* ltw, u32 ltwCount)
 {
     Assert(Thread::IsOnThread(ThreadGUID_Render), STR("{} must be run on render thread,  currently on thread {}", __FUNCTION__, Thread::GetCurrentThreadGUID()));
 
     // check platform data has been created successfully
-    auto meshPD = mesh->GetPlatformData();
-    auto meshAD = mesh->GetAssetData();
-    auto material = *(meshAD->material);
-    auto uboInstance = ShaderManager::Instance().FindUBO("UBO_Model")->dynamicInstance;
+    auto meshPD = StaticMeshFactory::Instance().GetPlatformData(mesh);
+    auto uboInstance = ShaderManager::Instance().FindUBO(NEONAME("UBO_Model"))->dynamicInstance;
     auto& gil = GIL::Instance();
-    if (!meshPD || !meshAD || !material || !meshPD->geomBuffer || !uboInstance)
+    if (!meshPD || !meshPD->geomBuffer || !MaterialFactory::Instance().GetPlatformData(meshPD->material) || !uboInstance)
         return;
 
-    BindMaterial(material, false);
+    BindMaterial(meshPD->material, false);
     BindGeometryBuffer(meshPD->geomBuffer);
     SetRenderPrimitiveType(PrimType_TriangleList);
     for (u32 i = 0; i < ltwCount; i++)
@@ -1878,7 +1850,7 @@ void GIL::SetRenderPass(RenderPass* renderPass)
         auto aspectRatio = renderPass->GetAspectRatio();
         if (view && view != m_boundView && aspectRatio != m_boundViewAspectRatio)
         {
-            auto viewUBOInstance = ShaderManager::Instance().FindUBO("UBO_View")->dynamicInstance;
+            auto viewUBOInstance = ShaderManager::Instance().FindUBO(NEONAME("UBO_View"))->dynamicInstance;
             UBO_View viewData;
             view->InitUBOView(viewData, aspectRatio);
             UpdateUBOInstance(viewUBOInstance, &viewData, sizeof(viewData), true);
@@ -1889,7 +1861,7 @@ void GIL::SetRenderPass(RenderPass* renderPass)
     }
 
     // no bound materials at the start of a render pass
-    m_boundMaterial = nullptr;
+    m_boundMaterial = 0;
 }
 
 #if PROFILING_ENABLED
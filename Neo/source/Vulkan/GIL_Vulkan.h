@@ -69,6 +69,9 @@ public:
 	// use material
 	void BindMaterial(class Material* material, bool lines);
 
+	// bind by handle - only reads the material's platform data, so a draw loop never touches the resource itself
+	void BindMaterial(ResourceHandle material, bool lines);
+
 	// bind geometry buffers
 	void BindGeometryBuffer(NeoGeometryBuffer* buffer);
 
@@ -80,10 +83,10 @@ public:
 
 	// add model to render queue
 	// must be called on render thread
-	void RenderStaticMesh(class StaticMesh* mesh);
+	void RenderStaticMesh(ResourceHandle mesh);
 
 	// render an array of static mesh instances
-	void RenderStaticMeshInstances(class StaticMesh* mesh, mat4x4 *ltw, u32 ltwCount);
+	void RenderStaticMeshInstances(ResourceHandle mesh, mat4x4 *ltw, u32 ltwCount);
 
 	// update the entire memory for a single ubo instance
 	void UpdateUBOInstance(UBOInfoInstance* uboInstance, void* uboMem, u32 uboSize, bool updateBoundMaterial);
@@ -176,7 +179,7 @@ protected:
 	VkImageView m_depthImageView;
 
 	RenderPass* m_boundRenderPass = nullptr;
-	Material* m_boundMaterial = nullptr;
+	ResourceHandle m_boundMaterial = 0;
 	View* m_boundView = nullptr;
 	float m_boundViewAspectRatio = 1.0f;
 
@@ -144,6 +144,7 @@ MaterialPlatformData* MaterialPlatformData_Create(MaterialAssetData* assetData)
     for (auto mrpi : assetData->renderPasses)
     {
         auto rp = new MaterialPlatformRenderPassData;
+        rp->renderPass = *mrpi->renderPass;
         platformData->renderPasses.push_back(rp);
 
         auto shaderPD = mrpi->shader->GetPlatformData();
@@ -554,6 +555,7 @@ StaticMeshPlatformData* StaticMeshPlatformData_Create(struct StaticMeshAssetData
 
     platformData->geomBuffer = gil.CreateGeometryBuffer(assetData->verts.data(), (u32)(sizeof(assetData->verts[0]) * assetData->verts.size()), assetData->indices.data(), (u32)(sizeof(assetData->indices[0]) * assetData->indices.size()));
     platformData->indiceCount = (int)assetData->indices.size();
+    platformData->material = assetData->material.Handle();
 
     return platformData;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ResourceHandle.h"
+
 struct UBOInfoInstance;
 const int MAX_FRAMES_IN_FLIGHT = 2;
 
@@ -38,6 +40,7 @@ void ShaderPlatformData_Destroy(ShaderPlatformData* platformData);
 
 struct MaterialPlatformRenderPassData
 {
+	class RenderPass* renderPass = nullptr;		// so binding can find the pass without going back to the asset data
 	VkPipelineLayout pipelineLayout = nullptr;
 	VkPipeline polygonPipeline = nullptr;
 	VkPipeline linePipeline = nullptr;
@@ -56,6 +59,16 @@ struct MaterialPlatformRenderPassData
 struct MaterialPlatformData
 {
 	vector<MaterialPlatformRenderPassData*> renderPasses;
+
+	MaterialPlatformRenderPassData* FindRenderPass(class RenderPass* renderPass) const
+	{
+		for (auto rp : renderPasses)
+		{
+			if (rp->renderPass == renderPass)
+				return rp;
+		}
+		return nullptr;
+	}
 };
 MaterialPlatformData* MaterialPlatformData_Create(struct MaterialAssetData* assetData);
 void MaterialPlatformData_Destroy(MaterialPlatformData* platformData);
@@ -64,6 +77,7 @@ struct StaticMeshPlatformData
 {
 	struct NeoGeometryBuffer* geomBuffer = nullptr;
 	u32 indiceCount = 0;
+	ResourceHandle material = 0;		// the asset data holds the reference, the draw loop only needs the handle
 };
 StaticMeshPlatformData* StaticMeshPlatformData_Create(struct StaticMeshAssetData* assetData);
 void StaticMeshPlatformData_Destroy(StaticMeshPlatformData* platformData);
@@ -4,7 +4,16 @@ import sys
 
 supported_types = [ "u8", "u16", "u32", "u64", "i8", "i16", "i32", "i64", "f32", "f64", 'vec2', 'vec3', 'vec4', 'ivec2', 'ivec3', 'ivec4', "mat4x4" ]
 
-def parse_enum(i, lines, out_header, out_body, out_code):
+# initialiser for a std::array
+def write_array(out_body, items):
+	if len(items) == 0:
+		out_body.write(" {};\n")
+	else:
+		out_body.write("\n{{")
+		out_body.write(",".join(f"\n  {item}" for item in items))
+		out_body.write("\n}};\n")
+
+def parse_enum(i, lines, out_header, out_body, out_tables):
 	# TODO - process any directives on the reflect line
 	#tokens = lines[i].split()
 	#attr_prefix = ""
@@ -16,63 +25,140 @@ def parse_enum(i, lines, out_header, out_body, out_code):
 	tokens = lines[i+1].split()
 	enum_name = tokens[1].strip()
 
-	out_header.write(f"enum {enum_name};\n")
-	out_header.write(f"bool {enum_name}_StringToEnum(string name, {enum_name} &value);\n")
-	out_header.write(f"string {enum_name}_EnumToString({enum_name} value);\n\n")
-
-	out_body.write(f"ReflectEnumInfo enumReflect_{enum_name};\n")
-
-	out_body.write(f"bool {enum_name}_StringToEnum(string name, {enum_name} &value)\n")
-	out_body.write( "{\n")
-	out_body.write(f"  auto it = enumReflect_{enum_name}.map_stringToInt.find(name);\n")
-	out_body.write(f"  if (it != enumReflect_{enum_name}.map_stringToInt.end())\n")
-	out_body.write( "  {\n")
-	out_body.write(f"    value = ({enum_name})it->second;")
-	out_body.write( "    return true;\n")
-	out_body.write( "  }\n")
-	out_body.write( "  return false;\n")
-	out_body.write( "}\n")
-
-	out_body.write(f"string {enum_name}_EnumToString({enum_name} value)\n")
-	out_body.write( "{\n")
-	out_body.write(f"  auto it = enumReflect_{enum_name}.map_intToString.find((int)value);\n")
-	out_body.write(f"  if (it != enumReflect_{enum_name}.map_intToString.end())\n")
-	out_body.write( "    return it->second;\n")
-	out_body.write( "  return \"\";\n")
-	out_body.write( "}\n\n")
-
-	out_code.append(f"  enumReflect_{enum_name}.name=\"{enum_name}\";\n")
-
+	# gather the enumerators - the reflected name drops everything up to the first underscore
+	values = []
 	i+=2
-	ival=0
-	sval=""
 	while i < len(lines):
 		enumTokens = lines[i].split()
 		if len(enumTokens) > 0 and enumTokens[0].startswith('}'):
-			return i+1
-		elif len(enumTokens) > 0 and not enumTokens[0].startswith("\\") and not enumTokens[0].startswith("{"):
-			value = enumTokens[0]
+			i += 1
+			break
+		elif len(enumTokens) > 0 and not enumTokens[0].startswith("//") and not enumTokens[0].startswith("{"):
+			enumerator = enumTokens[0].split('=')[0].rstrip(',')
+			value = enumerator
 			underscoreIndex = value.find('_')
 			if underscoreIndex != -1:
 				value = value[underscoreIndex+1:]
-			value = value.rstrip(',')
-			if len(enumTokens) > 2 and enumTokens[1] == "=":
-				sval = enumTokens[2].rstrip(',')
-				ival=0
-			visual_val = ival
-			if sval != "":
-				visual_val = f"{sval} + {ival}"
-
-			out_code.append(f"  enumReflect_{enum_name}.map_intToString.insert({{ {visual_val},\"{value}\" }});\n")
-			out_code.append(f"  enumReflect_{enum_name}.map_stringToInt.insert({{ \"{value}\",{visual_val} }});\n")
+			values.append((value, enumerator))
 			i += 1
-			ival += 1
 		# just an empty line or an open bracket
 		else:
 			i += 1
+
+	out_header.write(f"enum {enum_name};\n")
+	out_header.write(f"extern const ReflectEnumInfo reflectEnumInfo_{enum_name};\n")
+	out_header.write(f"bool {enum_name}_StringToEnum(string_view name, {enum_name} &value);\n")
+	out_header.write(f"string_view {enum_name}_EnumToString({enum_name} value);\n\n")
+
+	# sorted by name here, and by value at compile time since values can be expressions
+	values.sort(key=lambda v: v[0].encode("utf-8"))
+	out_body.write(f"static constexpr array<ReflectEnumValue, {len(values)}> reflectEnumByName_{enum_name} =")
+	write_array(out_body, [f"{{ \"{value}\", (int){enumerator} }}" for (value, enumerator) in values])
+	out_body.write(f"static constexpr array<ReflectEnumValue, {len(values)}> reflectEnumByValue_{enum_name} = ReflectSortByValue(reflectEnumByName_{enum_name});\n")
+	out_body.write(f"constinit const ReflectEnumInfo reflectEnumInfo_{enum_name} = {{ \"{enum_name}\", reflectEnumByName_{enum_name}, reflectEnumByValue_{enum_name} }};\n")
+
+	out_body.write(f"bool {enum_name}_StringToEnum(string_view name, {enum_name} &value)\n")
+	out_body.write( "{\n")
+	out_body.write( "  int intValue;\n")
+	out_body.write(f"  if (!reflectEnumInfo_{enum_name}.StringToInt(name, intValue))\n")
+	out_body.write( "    return false;\n")
+	out_body.write(f"  value = ({enum_name})intValue;\n")
+	out_body.write( "  return true;\n")
+	out_body.write( "}\n")
+
+	out_body.write(f"string_view {enum_name}_EnumToString({enum_name} value)\n")
+	out_body.write( "{\n")
+	out_body.write(f"  return reflectEnumInfo_{enum_name}.IntToString((int)value);\n")
+	out_body.write( "}\n\n")
+
+	out_tables.append(("enum", enum_name))
 	return i
 
-def parse_struct(i, lines, out_header, out_body, out_code):
+# members the generated serializers can handle beyond the plain data types
+# plain data members (supported_types and reflected enums) are copied as they are in memory,
+# and runs of them with no padding between are copied in one go
+reflected_enums = set()
+reflected_structs = set()
+
+def member_kind(var_type):
+	if var_type in supported_types or var_type in reflected_enums:
+		return "pod"
+	if var_type == "bool" or var_type == "string":
+		return var_type
+	if var_type in reflected_structs:
+		return "struct"
+	if var_type.startswith("vector<") and var_type.endswith(">"):
+		inner = var_type[7:-1]
+		if inner in supported_types or inner in reflected_enums:
+			return "vector"
+	return None
+
+# 64 bit fnv-1a - the same member list always gives the same hash
+def schema_hash(struct_name, members):
+	text = struct_name + "|" + "|".join(f"{var_type} {var_name}" for (kind, var_type, var_name) in members)
+	h = 0xcbf29ce484222325
+	for c in text.encode("utf-8"):
+		h = ((h ^ c) * 0x100000001b3) & 0xffffffffffffffff
+	return h
+
+def pod_runs(members):
+	runs = []
+	for member in members:
+		if member[0] == "pod" and len(runs) > 0 and runs[-1][0][0] == "pod":
+			runs[-1].append(member)
+		else:
+			runs.append([member])
+	return runs
+
+def write_serializers(struct_name, members, out_header, out_body):
+	out_header.write(f"const u64 {struct_name}_SchemaHash = 0x{schema_hash(struct_name, members):016x}ull;\n")
+	out_header.write(f"template <SerializerEndian Endian> void {struct_name}_Write(BinaryWriter<Endian>& stream, const {struct_name}& value);\n")
+	out_header.write(f"template <SerializerEndian Endian> bool {struct_name}_Read(BinaryReader<Endian>& stream, {struct_name}& value);\n")
+
+	runs = pod_runs(members)
+	for mode in ["Write", "Read"]:
+		if mode == "Write":
+			out_body.write(f"template <SerializerEndian Endian> void {struct_name}_Write(BinaryWriter<Endian>& stream, const {struct_name}& value)\n{{\n")
+			out_body.write( "  static_assert(BinaryWriter<Endian>::NativeOrder, \"generated serializers copy members as they are in memory\");\n")
+			out_body.write(f"  stream.WriteU64({struct_name}_SchemaHash);\n")
+		else:
+			out_body.write(f"template <SerializerEndian Endian> bool {struct_name}_Read(BinaryReader<Endian>& stream, {struct_name}& value)\n{{\n")
+			out_body.write( "  static_assert(BinaryReader<Endian>::NativeOrder, \"generated serializers copy members as they are in memory\");\n")
+			out_body.write(f"  if (stream.ReadU64() != {struct_name}_SchemaHash)\n    return false;\n")
+		copy = "stream.WriteMemory" if mode == "Write" else "stream.ReadMemory"
+
+		for run in runs:
+			kind, var_type, var_name = run[0]
+			if kind == "pod" and len(run) > 1:
+				first = run[0][2]
+				last = run[-1][2]
+				contiguous = " && ".join(f"offsetof({struct_name}, {run[x+1][2]}) == offsetof({struct_name}, {run[x][2]}) + sizeof({struct_name}::{run[x][2]})" for x in range(len(run) - 1))
+				out_body.write(f"  if constexpr ({contiguous})\n")
+				out_body.write(f"    {copy}(&value.{first}, offsetof({struct_name}, {last}) + sizeof({struct_name}::{last}) - offsetof({struct_name}, {first}));\n")
+				out_body.write( "  else\n  {\n")
+				for member in run:
+					out_body.write(f"    {copy}(&value.{member[2]}, sizeof({struct_name}::{member[2]}));\n")
+				out_body.write( "  }\n")
+			elif kind == "pod":
+				out_body.write(f"  {copy}(&value.{var_name}, sizeof({struct_name}::{var_name}));\n")
+			elif kind == "bool":
+				out_body.write(f"  stream.WriteBool(value.{var_name});\n" if mode == "Write" else f"  value.{var_name} = stream.ReadBool();\n")
+			elif kind == "string":
+				out_body.write(f"  stream.WriteString(value.{var_name});\n" if mode == "Write" else f"  value.{var_name} = stream.ReadString();\n")
+			elif kind == "vector":
+				out_body.write(f"  stream.WriteVector(value.{var_name});\n" if mode == "Write" else f"  stream.ReadVector(value.{var_name});\n")
+			elif kind == "struct":
+				out_body.write(f"  {var_type}_Write(stream, value.{var_name});\n" if mode == "Write" else f"  if (!{var_type}_Read(stream, value.{var_name}))\n    return false;\n")
+
+		if mode == "Read":
+			out_body.write("  return stream.IsGood();\n")
+		out_body.write("}\n")
+
+	# asset data is little endian, so that's the only order the serializers are built for
+	out_body.write(f"template void {struct_name}_Write(BinaryWriter<SerializerEndian::Little>& stream, const {struct_name}& value);\n")
+	out_body.write(f"template bool {struct_name}_Read(BinaryReader<SerializerEndian::Little>& stream, {struct_name}& value);\n")
+
+def parse_struct(i, lines, out_header, out_body, out_tables):
 	# TODO - process any directives on the reflect line
 	i+=1
 	tokens = lines[i].split()
@@ -81,36 +167,35 @@ def parse_struct(i, lines, out_header, out_body, out_code):
 		return i
 	struct_name = tokens[1]
 	out_header.write(f"//#### STRUCT {struct_name} ####\n")
-	out_header.write(f"extern ReflectStructInfo reflectStructInfo_{struct_name};\n")
-	out_body.write(f"ReflectStructInfo reflectStructInfo_{struct_name}\n{{\n  \"{struct_name}\", sizeof({struct_name}),\n  {{")
+	out_header.write(f"{tokens[0]} {struct_name};\n")
+	out_header.write(f"extern const ReflectStructInfo reflectStructInfo_{struct_name};\n")
 
-	memberIdx = 0
+	member_infos = []
+	serialized_members = []
 	while i < len(lines):
 		tokens = lines[i].split()
 		if len(tokens)>0:
-			if tokens[0] in supported_types:
+			kind = member_kind(tokens[0]) if len(tokens) > 1 else None
+			if kind != None:
 				var_type = tokens[0]
-				var_name = tokens[1].rstrip(';')
-
-				# terminate the last member with a comma if this isn't the first member
-				if memberIdx != 0:
-					out_body.write(",")
+				# the name stops at any initialiser (ie. "ivec2 size{};" or "i32 count = 0;")
+				var_name = re.split(r"[;{=\[]", tokens[1])[0]
+				serialized_members.append((kind, var_type, var_name))
 
-				out_body.write(f"\n    {{ \"{var_name}\", VarType_{var_type}, sizeof({var_type}), offsetof({struct_name}, {var_name}) }}")
+				if var_type in supported_types or var_type in reflected_enums:
+					var_type_enum = var_type if var_type in supported_types else "enum"
+					member_infos.append(f"{{ \"{var_name}\", VarType_{var_type_enum}, sizeof({struct_name}::{var_name}), offsetof({struct_name}, {var_name}) }}")
 				i += 1
-				memberIdx += 1
 			elif tokens[0] == "void":
-
-				# terminate the last member with a comma if this isn't the first member
-				if memberIdx != 0:
-					out_body.write(",")
-
 				func_name = tokens[1].split('(')[0].strip()
-				out_body.write(f"\n    {{ \"{func_name}\", VarType_func, 0, 0, [](void* obj) {{ (({struct_name}*)obj)->{func_name}(); }} }}")
+				member_infos.append(f"{{ \"{func_name}\", VarType_func, 0, 0, [](void* obj) {{ (({struct_name}*)obj)->{func_name}(); }} }}")
 				i += 1
-				memberIdx += 1
 			elif tokens[0].startswith('}'):
-				out_body.write("\n  }\n};\n")
+				out_body.write(f"static constexpr array<ReflectStructMemberInfo, {len(member_infos)}> reflectStructMembers_{struct_name} =")
+				write_array(out_body, member_infos)
+				out_body.write(f"constinit const ReflectStructInfo reflectStructInfo_{struct_name} = {{ \"{struct_name}\", sizeof({struct_name}), reflectStructMembers_{struct_name} }};\n")
+				write_serializers(struct_name, serialized_members, out_header, out_body)
+				out_tables.append(("struct", struct_name))
 				return i+1
 			else:
 				i += 1
@@ -119,32 +204,57 @@ def parse_struct(i, lines, out_header, out_body, out_code):
 	print("Error - structure not closed!\n")
 	return i
 
-def parse_reflect(i, lines, out_header, out_body, out_code):
+def parse_reflect(i, lines, out_header, out_body, out_tables):
 	line = lines[i+1].strip()
 	if line.startswith("enum"):
-		return parse_enum(i, lines, out_header, out_body, out_code)
+		return parse_enum(i, lines, out_header, out_body, out_tables)
 	elif line.startswith("struct") or line.startswith("class"):
-		return parse_struct(i, lines, out_header, out_body, out_code)
+		return parse_struct(i, lines, out_header, out_body, out_tables)
 	else:
 		print("REFLECT is not followed by an enum, struct or class...")
 	return i+1
 
 def filename_from_path(path):
-		idx = path.rfind('\\')
-		if idx != -1:
-			return path[idx+1:]
-		else:
-			return path
+	return os.path.basename(path)
 
-def parse_enums_and_structs(pch, init_func, output_file, list_of_files):
+# names of everything reflected, so struct members can refer to enums and structs declared in any file
+def find_reflected_names(list_of_files):
+	for file_path in list_of_files:
+		with open(file_path, 'r') as f:
+			lines = f.readlines()
+		for i in range(len(lines) - 1):
+			if lines[i].strip().startswith("//<REFLECT>"):
+				tokens = lines[i+1].split()
+				if len(tokens) > 1 and tokens[0] == "enum":
+					reflected_enums.add(tokens[1])
+				elif len(tokens) > 1 and (tokens[0] == "struct" or tokens[0] == "class"):
+					reflected_structs.add(tokens[1])
+
+def write_tables(tables_name, out_tables, out_header, out_body):
+	# every enum and struct sorted by name, for lookups by name without building anything at startup
+	out_header.write(f"extern const ReflectTables {tables_name};\n")
+	for kind, info_name in [("enum", "ReflectEnumInfo"), ("struct", "ReflectStructInfo")]:
+		names = sorted((name for (table_kind, name) in out_tables if table_kind == kind), key=lambda name: name.encode("utf-8"))
+		prefix = "reflectEnumInfo_" if kind == "enum" else "reflectStructInfo_"
+		out_body.write(f"static constexpr array<const {info_name}*, {len(names)}> {tables_name}_{kind}s =")
+		write_array(out_body, [f"&{prefix}{name}" for name in names])
+	out_body.write(f"constinit const ReflectTables {tables_name} = {{ {tables_name}_enums, {tables_name}_structs }};\n")
+
+def parse_enums_and_structs(pch, tables_name, output_file, list_of_files):
 	output_header = output_file + ".h"
 	output_body = output_file + ".cpp"
-	out_code = []
+	out_tables = []
+
+	find_reflected_names(list_of_files)
 
 	with open(output_header, 'w') as out_header, open(output_body, "w") as out_body:
-		out_header.write("#pragma once\n")
-		out_header.write(f"void {init_func}();\n\n")
+		out_header.write("#pragma once\n\n")
+		out_header.write("// generated serializers read and write with these (Serializer.h)\n")
+		out_header.write("enum class SerializerEndian;\n")
+		out_header.write("template <SerializerEndian Endian> class BinaryWriter;\n")
+		out_header.write("template <SerializerEndian Endian> class BinaryReader;\n\n")
 		out_body.write("#include \"Neo.h\"\n")
+		out_body.write("#include \"Serializer.h\"\n")
 		out_body.write(f"#include \"{filename_from_path(output_file)}.h\"\n\n")
 
 		for file_path in list_of_files:
@@ -158,23 +268,20 @@ def parse_enums_and_structs(pch, init_func, output_file, list_of_files):
 						if not found_reflect:
 							out_body.write(f"#include \"{filename_from_path(file_path)}\"\n")
 							found_reflect = 1
-						i = parse_reflect(i, lines, out_header, out_body, out_code)
+						i = parse_reflect(i, lines, out_header, out_body, out_tables)
 					else:
 						i += 1
-		out_body.write(f"void {init_func}()\n")
-		out_body.write("{\n")
-		for item in out_code:
-			out_body.write(item)
-		out_body.write("}\n")
+
+		write_tables(tables_name, out_tables, out_header, out_body)
 
 # Example usage
 if len(sys.argv) < 5:
-	print("Usage: python reflect.py <pch> <initFunc> <outfile> <directories>...")
+	print("Usage: python reflect.py <pch> <tablesName> <outfile> <directories>...")
 	sys.exit(1)
 
 list_of_dirs = []
 pch = sys.argv[1]
-initfunc = sys.argv[2]
+tablesname = sys.argv[2]
 outputfile = sys.argv[3]
 for outputDir in sys.argv[4:]:
 	list_of_dirs.append(outputDir)
@@ -202,6 +309,6 @@ else:
 			dirty = True
 			break
 if dirty:
-	parse_enums_and_structs(pch, initfunc, outputfile, list_of_files)
+	parse_enums_and_structs(pch, tablesname, outputfile, list_of_files)
 else:
 	print("No file changes detected!")
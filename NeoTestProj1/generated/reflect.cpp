@@ -1,28 +1,30 @@
 #include "Neo.h"
+#include "Serializer.h"
 #include "reflect.h"
 
 #include "Application.h"
-ReflectEnumInfo enumReflect_ApplicationThreads;
-bool ApplicationThreads_StringToEnum(string name, ApplicationThreads &value)
+static constexpr array<ReflectEnumValue, 1> reflectEnumByName_ApplicationThreads =
+{{
+  { "UpdateWorkerThread", (int)GameThreadGUID_UpdateWorkerThread }
+}};
+static constexpr array<ReflectEnumValue, 1> reflectEnumByValue_ApplicationThreads = ReflectSortByValue(reflectEnumByName_ApplicationThreads);
+constinit const ReflectEnumInfo reflectEnumInfo_ApplicationThreads = { "ApplicationThreads", reflectEnumByName_ApplicationThreads, reflectEnumByValue_ApplicationThreads };
+bool ApplicationThreads_StringToEnum(string_view name, ApplicationThreads &value)
 {
-  auto it = enumReflect_ApplicationThreads.map_stringToInt.find(name);
-  if (it != enumReflect_ApplicationThreads.map_stringToInt.end())
-  {
-    value = (ApplicationThreads)it->second;    return true;
-  }
-  return false;
+  int intValue;
+  if (!reflectEnumInfo_ApplicationThreads.StringToInt(name, intValue))
+    return false;
+  value = (ApplicationThreads)intValue;
+  return true;
 }
-string ApplicationThreads_EnumToString(ApplicationThreads value)
+string_view ApplicationThreads_EnumToString(ApplicationThreads value)
 {
-  auto it = enumReflect_ApplicationThreads.map_intToString.find((int)value);
-  if (it != enumReflect_ApplicationThreads.map_intToString.end())
-    return it->second;
-  return "";
+  return reflectEnumInfo_ApplicationThreads.IntToString((int)value);
 }
 
-void GameInitReflection()
-{
-  enumReflect_ApplicationThreads.name="ApplicationThreads";
-  enumReflect_ApplicationThreads.map_intToString.insert({ ThreadGUID_MAX + 0,"UpdateWorkerThread" });
-  enumReflect_ApplicationThreads.map_stringToInt.insert({ "UpdateWorkerThread",ThreadGUID_MAX + 0 });
-}
+static constexpr array<const ReflectEnumInfo*, 1> GameReflectTables_enums =
+{{
+  &reflectEnumInfo_ApplicationThreads
+}};
+static constexpr array<const ReflectStructInfo*, 0> GameReflectTables_structs = {};
+constinit const ReflectTables GameReflectTables = { GameReflectTables_enums, GameReflectTables_structs };
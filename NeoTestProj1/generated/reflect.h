@@ -1,7 +1,13 @@
 #pragma once
-void GameInitReflection();
+
+// generated serializers read and write with these (Serializer.h)
+enum class SerializerEndian;
+template <SerializerEndian Endian> class BinaryWriter;
+template <SerializerEndian Endian> class BinaryReader;
 
 enum ApplicationThreads;
-bool ApplicationThreads_StringToEnum(string name, ApplicationThreads &value);
-string ApplicationThreads_EnumToString(ApplicationThreads value);
+extern const ReflectEnumInfo reflectEnumInfo_ApplicationThreads;
+bool ApplicationThreads_StringToEnum(string_view name, ApplicationThreads &value);
+string_view ApplicationThreads_EnumToString(ApplicationThreads value);
 
+extern const ReflectTables GameReflectTables;
@@ -193,7 +193,7 @@ void Application::RenderParticles()
 
 	auto& gil = GIL::Instance();
 	UBO_Model modelData;
-	auto modelUBOInstance = ShaderManager::Instance().FindUBO("UBO_Model")->dynamicInstance;
+	auto modelUBOInstance = ShaderManager::Instance().FindUBO(NEONAME("UBO_Model"))->dynamicInstance;
 	modelData.model = mat4x4(1);
 	gil.UpdateUBOInstance(modelUBOInstance, &modelData, sizeof(modelData), true);
 
@@ -211,18 +211,18 @@ void Application::RenderRooms()
 
 	auto& gil = GIL::Instance();
 	UBO_Model modelData;
-	auto modelUBOInstance = ShaderManager::Instance().FindUBO("UBO_Model")->dynamicInstance;
+	auto modelUBOInstance = ShaderManager::Instance().FindUBO(NEONAME("UBO_Model"))->dynamicInstance;
 	modelData.model = mat4x4(1);
 	gil.UpdateUBOInstance(modelUBOInstance, &modelData, sizeof(modelData), false);
 
 	{
 		PROFILE_GPU("ROOMS");
 		vec4 col1{ 1.0f, 0.0f, 0.0f, 1.0f };
-		m_vikingRoomMat->SetUniform_vec4("blendColor", col1, true);
+		m_vikingRoomMat->SetUniform_vec4(m_vikingRoomBlendColor, col1, true);
 		gil.RenderStaticMeshInstances(m_vikingRoom, m_roomInstances, roomGridSize * roomGridSize / 2);
 
 		vec4 col2{ 1.0f, 1.0f, 1.0f, 1.0f };
-		m_vikingRoomMat->SetUniform_vec4("blendColor", col2, true);
+		m_vikingRoomMat->SetUniform_vec4(m_vikingRoomBlendColor, col2, true);
 
 		gil.RenderStaticMeshInstances(m_vikingRoom, &m_roomInstances[roomGridSize * roomGridSize / 2], roomGridSize * roomGridSize / 2);
 	}
@@ -40,6 +40,7 @@ protected:
 
 	StaticMeshRef m_vikingRoom;
 	MaterialRef m_vikingRoomMat;
+	MaterialUniformHandle m_vikingRoomBlendColor = NeoName("blendColor");
 	View m_renderTargetView;
 	View m_view;
 	vec3 m_cameraPYR = { 0,0,0 };